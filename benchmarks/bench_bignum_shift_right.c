@@ -20,6 +20,16 @@
  *   - rev 1.1 (13.08.2025): Реализована предварительная генерация данных.
  *   - rev 1.2 (13.08.2025): Добавлены локальные определения констант
  *                           BIGNUM_CAPACITY и BIGNUM_BITS для компиляции.
+ *   - rev 1.3 (14.10.2026): Добавлено сравнение пропускной способности
+ *                           поэлементных вызовов и bignum_shift_right_batch.
+ *   - rev 1.4 (14.10.2026): Добавлено измерение bignum_shift_right_to
+ *                           (сдвиг без промежуточной копии).
+ *   - rev 1.5 (14.10.2026): Удалено локальное определение BIGNUM_CAPACITY,
+ *                           добавлена проверка емкости библиотеки.
+ *   - rev 1.6 (14.10.2026): Добавлено сравнение `>> 1` через вызов и через
+ *                           встраиваемый BIGNUM_SHIFT_RIGHT.
+ *   - rev 1.7 (14.10.2026): Добавлено сравнение bignum_shift_right_batch_uniform
+ *                           и пакетного формата SoA (bignum_shift_right_soa).
  *
  * # Сборка
  *  gcc -g -O2 -I include -no-pie -fno-omit-frame-pointer \
@@ -33,20 +43,26 @@
  * /usr/local/bin/perf report -i benchmarks/reports/report_bench_bignum_shift_right --stdio --symbol-filter=bignum_shift_right
  */
 
+#define _POSIX_C_SOURCE 199309L // clock_gettime в режиме -std=c11
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <bignum.h>
 #include "bignum_shift_right.h"
 
-// --- Локальные определения для компиляции ---
-// Эти константы должны быть синхронизированы с ассемблерным кодом.
-#define BIGNUM_CAPACITY 32
-#define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+// BIGNUM_CAPACITY берется из bignum.h (make BIGNUM_CAPACITY=N); совпадение
+// с емкостью библиотеки проверяется в main.
+#ifndef BIGNUM_BITS
+#  define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+#endif
 
 // Увеличиваем количество итераций для более надежных измерений
-#define ITERATIONS (100000000u * 20)
+#ifndef ITERATIONS
+#  define ITERATIONS (100000000u * 20)
+#endif
 
 // Количество предварительно сгенерированных наборов данных
 #define PREGEN_DATA_COUNT 8192
@@ -54,6 +70,13 @@
 // Максимальный сдвиг
 #define MAX_SHIFT (BIGNUM_BITS - 1)
 
+/** Возвращает монотонное время в наносекундах. */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
 /** Заполняет bignum случайными словами и устанавливает len. */
 static void init_random_bignum(bignum_t *num) {
     int used = (rand() % BIGNUM_CAPACITY) + 1;
@@ -67,6 +90,12 @@ static void init_random_bignum(bignum_t *num) {
 }
 
 int main(void) {
+    if (!bignum_shift_right_capacity_matches()) {
+        fprintf(stderr, "Library capacity %lu != BIGNUM_CAPACITY %d\n",
+                (unsigned long)bignum_shift_right_capacity, (int)BIGNUM_CAPACITY);
+        return 1;
+    }
+
     // --- Фаза 1: Предварительная генерация данных ---
     printf("Pregenerating %u data sets...\n", PREGEN_DATA_COUNT);
 
@@ -87,6 +116,7 @@ int main(void) {
     // --- Фаза 2: "Горячий" цикл для профилирования ---
     printf("Starting benchmark with %u iterations...\n", ITERATIONS);
 
+    double t0 = now_ns();
     for (uint32_t i = 0; i < ITERATIONS; ++i) {
         // Используем предварительно сгенерированные данные, циклически обращаясь к ним
         unsigned data_idx = i % PREGEN_DATA_COUNT;
@@ -105,9 +135,128 @@ int main(void) {
         }
     }
 
+    double per_call_ns = (now_ns() - t0) / ITERATIONS;
+
+    // --- Фаза 3: Тот же поток данных через пакетный API ---
+    // Пул копируется целиком перед каждым пакетом, что соответствует
+    // копированию структуры в поэлементном цикле.
+    bignum_t* work = malloc(sizeof(bignum_t) * PREGEN_DATA_COUNT);
+    if (!work) {
+        perror("Failed to allocate memory for batch buffer");
+        free(sources);
+        free(shifts);
+        return 1;
+    }
+    const uint32_t rounds = ITERATIONS / PREGEN_DATA_COUNT;
+    printf("Starting batch benchmark with %u rounds of %u elements...\n", rounds, PREGEN_DATA_COUNT);
+
+    t0 = now_ns();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        memcpy(work, sources, sizeof(bignum_t) * PREGEN_DATA_COUNT);
+        bignum_shift_right_batch(work, shifts, PREGEN_DATA_COUNT, NULL);
+        if (work[r % PREGEN_DATA_COUNT].len == 0xDEADBEEF) {
+            printf("Error marker hit.\n");
+            return 1;
+        }
+    }
+    double batch_ns = (now_ns() - t0) / ((double)rounds * PREGEN_DATA_COUNT);
+
+    // --- Фаза 3a: Сдвиг без копирования (bignum_shift_right_to) ---
+    // Тот же поток данных, что и в фазе 2, но копия + сдвиг заменены
+    // одним проходом из sources[] в dst.
+    printf("Starting out-of-place benchmark with %u iterations...\n", ITERATIONS);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        unsigned data_idx = i % PREGEN_DATA_COUNT;
+        bignum_t dst;
+        bignum_shift_right_to(&dst, &sources[data_idx], shifts[data_idx]);
+        if (dst.len == 0xDEADBEEF) {
+            printf("Error marker hit.\n");
+            return 1;
+        }
+    }
+    double to_ns = (now_ns() - t0) / ITERATIONS;
+
+    // --- Фаза 3b: Деление пополам 4-словного числа (>> 1) ---
+    // Цепочка зависимых сдвигов; старший бит восстанавливается, чтобы len не менялась.
+    bignum_t half;
+    memset(&half, 0, sizeof(half));
+    for (int i = 0; i < 4; ++i) half.words[i] = sources[0].words[0] | 1;
+    half.len = 4;
+    printf("Starting >> 1 benchmark with %u iterations...\n", ITERATIONS);
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        bignum_shift_right(&half, 1);
+        half.words[3] |= 1ULL << 63;
+    }
+    double half_call_ns = (now_ns() - t0) / ITERATIONS;
+
+    t0 = now_ns();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        BIGNUM_SHIFT_RIGHT(&half, 1);
+        half.words[3] |= 1ULL << 63;
+    }
+    double half_inline_ns = (now_ns() - t0) / ITERATIONS;
+    if (half.len != 4) {
+        printf("Error marker hit.\n");
+        return 1;
+    }
+
+    // --- Фаза 3c: Одинаковый сдвиг пакета: bignum_t[] против SoA ---
+    // Числа полной длины; пул копируется перед каждым пакетом в обоих вариантах.
+    uint64_t* soa_words = malloc(sizeof(uint64_t) * BIGNUM_CAPACITY * PREGEN_DATA_COUNT);
+    uint64_t* soa_src = malloc(sizeof(uint64_t) * BIGNUM_CAPACITY * PREGEN_DATA_COUNT);
+    if (!soa_words || !soa_src) {
+        perror("Failed to allocate memory for SoA buffers");
+        return 1;
+    }
+    for (unsigned i = 0; i < PREGEN_DATA_COUNT; ++i) {
+        sources[i].words[BIGNUM_CAPACITY - 1] |= 1ULL << 63;
+        sources[i].len = BIGNUM_CAPACITY;
+    }
+    bignum_soa_t soa_pool = {soa_src, 0, 0};
+    bignum_shift_right_soa_pack(&soa_pool, sources, PREGEN_DATA_COUNT);
+    printf("Starting uniform batch benchmark (AoS vs SoA) with %u rounds of %u elements...\n",
+           rounds, PREGEN_DATA_COUNT);
+
+    t0 = now_ns();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        memcpy(work, sources, sizeof(bignum_t) * PREGEN_DATA_COUNT);
+        bignum_shift_right_batch_uniform(work, 13, PREGEN_DATA_COUNT, NULL);
+        if (work[r % PREGEN_DATA_COUNT].len == 0xDEADBEEF) {
+            printf("Error marker hit.\n");
+            return 1;
+        }
+    }
+    double uniform_ns = (now_ns() - t0) / ((double)rounds * PREGEN_DATA_COUNT);
+
+    t0 = now_ns();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        memcpy(soa_words, soa_src, sizeof(uint64_t) * BIGNUM_CAPACITY * PREGEN_DATA_COUNT);
+        bignum_soa_t soa = {soa_words, PREGEN_DATA_COUNT, BIGNUM_CAPACITY};
+        bignum_shift_right_soa(&soa, 13);
+        if (soa.len == 0xDEADBEEF) {
+            printf("Error marker hit.\n");
+            return 1;
+        }
+    }
+    double soa_ns = (now_ns() - t0) / ((double)rounds * PREGEN_DATA_COUNT);
+
     printf("Benchmark finished.\n");
+    printf("per-call: %.2f ns/op (%.1f Mop/s)\n", per_call_ns, 1e3 / per_call_ns);
+    printf("batch:    %.2f ns/op (%.1f Mop/s)\n", batch_ns, 1e3 / batch_ns);
+    printf("shift_to: %.2f ns/op (%.1f Mop/s)\n", to_ns, 1e3 / to_ns);
+    printf(">>1 call:   %.2f ns/op\n", half_call_ns);
+    printf(">>1 inline: %.2f ns/op\n", half_inline_ns);
+    printf("uniform:  %.2f ns/op (%.1f Mop/s)\n", uniform_ns, 1e3 / uniform_ns);
+    printf("soa:      %.2f ns/op (%.1f Mop/s)\n", soa_ns, 1e3 / soa_ns);
 
-    // --- Фаза 3: Очистка ---
+    // --- Фаза 4: Очистка ---
+    free(soa_words);
+    free(soa_src);
+    free(work);
     free(sources);
     free(shifts);
 
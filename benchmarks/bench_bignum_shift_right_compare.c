@@ -0,0 +1,501 @@
+/**
+ * @file    bench_bignum_shift_right_compare.c
+ * @brief   Сравнение двух ревизий bignum_shift_right.asm: регрессии по классам сдвига и len.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   Обе версии линкуются в один процесс: текущий src/bignum_shift_right.asm
+ *   и `git show BASE:src/bignum_shift_right.asm` собираются с одними ASFLAGS,
+ *   получают префиксы символов (objcopy --prefix-symbols) и выравнивание
+ *   .text на страницу, чтобы функции всех копий лежали с одинаковым
+ *   смещением в странице. Каждая версия линкуется дважды, в порядке
+ *   base_, head_, head_swap_, base_swap_ (ABBA): одна раскладка ставит
+ *   base ниже head, другая — наоборот. Остаточная зависимость от адреса
+ *   кода (при A/A-сравнении одна копия одной и той же функции стабильно
+ *   медленнее другой на десятки процентов) делится между версиями поровну.
+ *   Версии измеряются на одном ядре и вперемешку:
+ *   - Ячейка — режим (throughput/latency, как в bench_bignum_shift_right_suite)
+ *     × класс сдвига (word, bit, combined, zeroing) × len = 1..BIGNUM_CAPACITY.
+ *   - TRIALS испытаний (округляется до четного), раскладки чередуются по
+ *     испытаниям. В испытании — прогрев обеих версий, затем медианы SAMPLES
+ *     выборок каждой версии по BATCH_OPS сдвигов (такты на операцию).
+ *     Выборки версий чередуются (AB, BA, ...), версия, с которой начинается
+ *     испытание, выбирается случайно, чтобы порядок, дрейф частоты и кэша
+ *     не попадали в разницу.
+ *   - Разница — по медианам испытаний; значимость — парный t-критерий по
+ *     разностям испытаний с TRIALS - 1 степенями свободы. Порог p —
+ *     поправка Бонферрони: --alpha (на весь прогон) / число ячеек.
+ *   - Ячейка-кандидат (медленнее на --threshold % и p ниже порога)
+ *     перемеряется новыми TRIALS испытаниями; регрессия — только если
+ *     повторный замер тоже значим и выше порога.
+ *   Код возврата 1, если есть хотя бы одна подтвержденная регрессия.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *   - rev 1.1 (14.10.2026): Раскладки ABBA, случайный порядок версий в испытании,
+ *                          критическое t по TRIALS - 1, поправка Бонферрони и
+ *                          повторный замер кандидатов в регрессии.
+ *   - rev 1.2 (14.10.2026): Счетчик cntvct_el0 / CLOCK_MONOTONIC_RAW вместо TSC не на x86-64.
+ *
+ * # Запуск
+ *   make bench-compare BASE=HEAD~3 CONFIG=release   # отчет: benchmarks/reports/$(REPORT_NAME)_compare.txt
+ */
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime в режиме -std=c11 (не x86-64)
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#  include <x86intrin.h>
+#endif
+#include <bignum.h>
+#include "bignum_shift_right.h"
+
+// Сдвигов в одной выборке; BATCH_OPS чисел помещаются в L1
+#define BATCH_OPS 32
+
+// Испытаний на версию и выборок в испытании по умолчанию (--trials, --samples)
+#define DEFAULT_TRIALS  16
+#define DEFAULT_SAMPLES 200
+
+// Порог регрессии по умолчанию, % (--threshold)
+#define DEFAULT_THRESHOLD_PCT 5.0
+
+// Вероятность ложной регрессии на весь прогон (--alpha), делится на число ячеек
+#define DEFAULT_ALPHA 0.01
+
+/* Версии с префиксами символов (см. Makefile, bench-compare). */
+bignum_shift_right_status_t base_bignum_shift_right(bignum_t* restrict num, size_t shift_amount);
+bignum_shift_right_status_t head_bignum_shift_right(bignum_t* restrict num, size_t shift_amount);
+bignum_shift_right_status_t base_swap_bignum_shift_right(bignum_t* restrict num, size_t shift_amount);
+bignum_shift_right_status_t head_swap_bignum_shift_right(bignum_t* restrict num, size_t shift_amount);
+bignum_shift_right_kernel_t head_bignum_shift_right_get_kernel(void);
+extern const uint64_t head_bignum_shift_right_capacity;
+
+typedef bignum_shift_right_status_t (*shift_fn_t)(bignum_t* restrict, size_t);
+
+/** Раскладка: пара копий версий; в LAYOUTS[0] base ниже head, в LAYOUTS[1] — выше. */
+typedef struct {
+    shift_fn_t base;
+    shift_fn_t head;
+} layout_t;
+
+#define LAYOUT_COUNT 2
+static const layout_t layouts[LAYOUT_COUNT] = {
+    {base_bignum_shift_right, head_bignum_shift_right},
+    {base_swap_bignum_shift_right, head_swap_bignum_shift_right},
+};
+
+typedef enum { CLASS_WORD, CLASS_BIT, CLASS_COMBINED, CLASS_ZEROING, CLASS_COUNT } shift_class_t;
+typedef enum { MODE_THROUGHPUT, MODE_LATENCY, MODE_COUNT } bench_mode_t;
+
+static const char* const class_names[CLASS_COUNT] = {"word", "bit", "combined", "zeroing"};
+static const char* const mode_names[MODE_COUNT] = {"throughput", "latency"};
+
+/*
+ * Счетчик времени выборки: TSC на x86-64 (lfence + rdtsc ... rdtscp + lfence),
+ * виртуальный счетчик cntvct_el0 с isb на AArch64, иначе наносекунды
+ * clock_gettime(CLOCK_MONOTONIC_RAW).
+ */
+#if defined(__x86_64__)
+#  define TIMER_NAME "TSC"
+#elif defined(__aarch64__)
+#  define TIMER_NAME "cntvct_el0"
+#else
+#  define TIMER_NAME "CLOCK_MONOTONIC_RAW"
+#endif
+
+static inline uint64_t tsc_begin(void) {
+#if defined(__x86_64__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t) : : "memory");
+    return t;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t tsc_end(void) {
+#if defined(__x86_64__)
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+    return t;
+#else
+    return tsc_begin();
+#endif
+}
+
+#if !defined(__x86_64__) && !defined(__aarch64__)
+static volatile uint64_t chain_zero;                // Всегда 0; компилятор не знает значения
+#endif
+
+/** Обнуляет зависимость по значению, сохраняя зависимость по данным для CPU. */
+static inline size_t chain_dep(uint64_t x) {
+#if defined(__x86_64__)
+    __asm__ volatile("andq $0, %0" : "+r"(x));
+#elif defined(__aarch64__)
+    __asm__ volatile("and %0, %0, xzr" : "+r"(x));
+#else
+    x &= chain_zero;
+#endif
+    return (size_t)x;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double* v, int n) {
+    qsort(v, (size_t)n, sizeof(v[0]), cmp_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+/** Величина сдвига класса cls для числа длины len; 0 — класс неприменим. */
+static size_t class_shift(shift_class_t cls, size_t len) {
+    switch (cls) {
+        case CLASS_WORD:     return 64 * (len / 2);
+        case CLASS_BIT:      return 13;
+        case CLASS_COMBINED: return len >= 2 ? 64 * (len / 2) + 13 : 0;
+        case CLASS_ZEROING:  return 64 * len + 7;
+        default:             return 0;
+    }
+}
+
+/** Ячейка сравнения и ее испытания. */
+typedef struct {
+    bench_mode_t  mode;
+    shift_class_t cls;
+    size_t        len;
+    size_t        shift;
+    double*       base;  /**< Медианы испытаний базовой версии. */
+    double*       head;  /**< Медианы испытаний текущей версии. */
+} cell_t;
+
+#define MAX_CELLS (BIGNUM_CAPACITY * CLASS_COUNT * MODE_COUNT)
+
+// Исходные числа для каждой длины (индекс len - 1) и рабочие копии выборки
+static bignum_t pristine[BIGNUM_CAPACITY][BATCH_OPS];
+static bignum_t work[BATCH_OPS];
+static cell_t cells[MAX_CELLS];
+static int cell_order[MAX_CELLS];                       // Индексы ячеек прогона (все или кандидаты)
+
+static void prepare_numbers(void) {
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t n = 0; n < BATCH_OPS; ++n) {
+            bignum_t* num = &pristine[len - 1][n];
+            memset(num, 0, sizeof(*num));
+            num->len = len;
+            for (size_t i = 0; i < len; ++i) num->words[i] = rng_next();
+            num->words[len - 1] |= 1ULL << 63;
+        }
+    }
+}
+
+/** Одна выборка: BATCH_OPS сдвигов, такты TSC на операцию. */
+static double run_sample(shift_fn_t fn, bench_mode_t mode, size_t len, size_t shift) {
+    uint64_t t0, t1;
+    size_t dep = 0;
+    memcpy(work, pristine[len - 1], sizeof(work));
+    if (mode == MODE_THROUGHPUT) {
+        t0 = tsc_begin();
+        for (size_t n = 0; n < BATCH_OPS; ++n) fn(&work[n], shift);
+        t1 = tsc_end();
+    } else {
+        t0 = tsc_begin();
+        for (size_t n = 0; n < BATCH_OPS; ++n) {
+            fn(&work[n], shift + dep);
+            dep = chain_dep(work[n].words[0]);
+        }
+        t1 = tsc_end();
+    }
+    return (double)(t1 - t0) / BATCH_OPS;
+}
+
+/**
+ * Испытание t ячейки: раскладка layouts[t % LAYOUT_COUNT], samples_count
+ * выборок каждой версии. Выборки версий чередуются (AB, BA, ...), поэтому
+ * обе видят одно и то же состояние частоты и кэша; первая версия (и порядок
+ * прогрева) выбирается случайно. В base и head — медианы выборок.
+ */
+static void run_trial(const cell_t* c, int t, double* samples, int samples_count, double* base, double* head) {
+    const layout_t* l = &layouts[t % LAYOUT_COUNT];
+    shift_fn_t fns[2] = {l->base, l->head};
+    double* out[2] = {samples, samples + samples_count};
+    int first = (int)(rng_next() >> 63);            // 0 — base первой, 1 — head
+    /* Прогрев после смены ячейки: предсказатель ветвлений, кэш кода и данных. */
+    for (int s = 0; s < samples_count / 10 + 1; ++s) {
+        run_sample(fns[first], c->mode, c->len, c->shift);
+        run_sample(fns[!first], c->mode, c->len, c->shift);
+    }
+    for (int s = 0; s < samples_count; ++s) {
+        int a = first ^ (s & 1);
+        out[a][s] = run_sample(fns[a], c->mode, c->len, c->shift);
+        out[!a][s] = run_sample(fns[!a], c->mode, c->len, c->shift);
+    }
+    *base = median(out[0], samples_count);
+    *head = median(out[1], samples_count);
+}
+
+/** Регуляризованная неполная бета-функция I_x(a, b) (цепная дробь, метод Лентца). */
+static double incomplete_beta(double a, double b, double x) {
+    if (x <= 0) return 0.0;
+    if (x >= 1) return 1.0;
+    if (x > (a + 1) / (a + b + 2)) return 1.0 - incomplete_beta(b, a, 1.0 - x);
+    const double tiny = 1e-300;
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x)) / a;
+    double f = 1.0, c = 1.0, d = 0.0;
+    for (int i = 0; i <= 400; ++i) {
+        int m = i / 2;
+        double num;
+        if (i == 0) {
+            num = 1.0;
+        } else if (i % 2 == 0) {
+            num = m * (b - m) * x / ((a + 2.0 * m - 1) * (a + 2.0 * m));
+        } else {
+            num = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1));
+        }
+        d = 1.0 + num * d;
+        d = fabs(d) < tiny ? 1.0 / tiny : 1.0 / d;
+        c = 1.0 + num / c;
+        if (fabs(c) < tiny) c = tiny;
+        f *= c * d;
+        if (fabs(1.0 - c * d) < 1e-12) break;
+    }
+    return front * (f - 1.0);
+}
+
+/** Двусторонний p-уровень t-статистики с df степенями свободы. */
+static double t_p_value(double t, int df) {
+    if (isinf(t)) return 0.0;
+    return incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+}
+
+/** Критическое |t| для двустороннего уровня p (бисекция по t_p_value). */
+static double t_critical(double p, int df) {
+    double lo = 0.0, hi = 1e6;
+    for (int i = 0; i < 200; ++i) {
+        double mid = (lo + hi) / 2;
+        if (t_p_value(mid, df) > p) lo = mid; else hi = mid;
+    }
+    return hi;
+}
+
+/** Парный t-критерий для разностей head - base по испытаниям. */
+static double paired_t(const double* base, const double* head, int n) {
+    double mean = 0, var = 0;
+    for (int i = 0; i < n; ++i) mean += head[i] - base[i];
+    mean /= n;
+    for (int i = 0; i < n; ++i) var += (head[i] - base[i] - mean) * (head[i] - base[i] - mean);
+    double den = sqrt(var / ((double)n * (n - 1)));
+    if (den > 0) return mean / den;
+    return mean == 0 ? 0.0 : (mean > 0 ? INFINITY : -INFINITY);
+}
+
+/** Проверяет, что обе версии в обеих раскладках дают одинаковый результат на числах ячейки. */
+static int versions_agree(size_t len, size_t shift) {
+    for (int l = 0; l < LAYOUT_COUNT; ++l) {
+        for (size_t n = 0; n < BATCH_OPS; ++n) {
+            bignum_t a = pristine[len - 1][n], b = pristine[len - 1][n];
+            if (layouts[l].head(&a, shift) != layouts[l].base(&b, shift) ||
+                a.len != b.len || memcmp(a.words, b.words, sizeof(a.words)) != 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/** Итог ячейки по ее испытаниям. */
+typedef struct {
+    double base_cyc;
+    double head_cyc;
+    double delta;  /**< (head - base) / base, %. */
+    double t;
+    double p;
+} cell_stats_t;
+
+static cell_stats_t cell_stats(const cell_t* c, int trials) {
+    cell_stats_t r;
+    r.t = paired_t(c->base, c->head, trials);
+    r.p = t_p_value(r.t, trials - 1);
+    r.base_cyc = median(c->base, trials);           // median сортирует: t считается раньше
+    r.head_cyc = median(c->head, trials);
+    r.delta = r.base_cyc > 0 ? (r.head_cyc - r.base_cyc) / r.base_cyc * 100.0 : 0.0;
+    return r;
+}
+
+/** Все испытания ячеек cells[idx[0 .. n)]; испытания разных ячеек перемежаются. */
+static void run_cells(const int* idx, int n, int trials, double* samples, int samples_count) {
+    for (int t = 0; t < trials; ++t) {
+        for (int i = 0; i < n; ++i) {
+            cell_t* c = &cells[idx[i]];
+            run_trial(c, t, samples, samples_count, &c->base[t], &c->head[t]);
+        }
+    }
+}
+
+static const char* kernel_name(bignum_shift_right_kernel_t k) {
+    switch (k) {
+        case BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR:       return "scalar";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX2:         return "avx2";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX512:       return "avx512";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX512_VBMI2: return "avx512_vbmi2";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_NEON:         return "neon";
+        default:                                     return "unknown";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* base = "base";
+    int trials = DEFAULT_TRIALS, samples_count = DEFAULT_SAMPLES;
+    double threshold = DEFAULT_THRESHOLD_PCT, alpha = DEFAULT_ALPHA;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--base") == 0 && i + 1 < argc) {
+            base = argv[++i];
+        } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            trials = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--base <name>] [--trials <n>] [--samples <n>] [--threshold <pct>] [--alpha <p>]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (trials < 2) trials = 2;
+    trials += trials % 2;                           // Поровну испытаний на раскладку
+    if (!(alpha > 0 && alpha < 1)) alpha = DEFAULT_ALPHA;
+    if (samples_count < 1) samples_count = 1;
+    if (head_bignum_shift_right_capacity != BIGNUM_CAPACITY) {
+        fprintf(stderr, "Library capacity %lu != BIGNUM_CAPACITY %d\n",
+                (unsigned long)head_bignum_shift_right_capacity, (int)BIGNUM_CAPACITY);
+        return 1;
+    }
+
+    double* samples = malloc(sizeof(double) * 2 * (size_t)samples_count);
+    double* trial_values = malloc(sizeof(double) * 2 * MAX_CELLS * (size_t)trials);
+    if (!samples || !trial_values) {
+        perror("Failed to allocate memory for samples");
+        free(samples);
+        free(trial_values);
+        return 1;
+    }
+
+    printf("bignum_shift_right revision compare: base %s vs working tree, capacity %d, kernel %s, timer %s\n",
+           base, (int)BIGNUM_CAPACITY, kernel_name(head_bignum_shift_right_get_kernel()), TIMER_NAME);
+
+    prepare_numbers();
+    int ncells = 0, regressions = 0, improvements = 0, mismatches = 0;
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            size_t shift = class_shift((shift_class_t)cls, len);
+            if (shift == 0) continue;
+            if (!versions_agree(len, shift)) {
+                printf("MISMATCH: class %s, len %zu, shift %zu: base and head results differ\n",
+                       class_names[cls], len, shift);
+                ++mismatches;
+                continue;
+            }
+            for (int mode = 0; mode < MODE_COUNT; ++mode) {
+                cell_t* c = &cells[ncells];
+                c->mode = (bench_mode_t)mode;
+                c->cls = (shift_class_t)cls;
+                c->len = len;
+                c->shift = shift;
+                c->base = trial_values + (size_t)ncells * 2 * (size_t)trials;
+                c->head = c->base + trials;
+                ++ncells;
+            }
+        }
+    }
+
+    // Бонферрони: alpha на весь прогон делится между ячейками
+    double p_cell = alpha / (ncells > 0 ? ncells : 1);
+    printf("%d trials (%d layouts) x %d samples x %d ops, regression: slower by > %.1f%% with p < %.2g "
+           "(alpha %.2g / %d cells, |t| >= %.2f at %d df), confirmed by a re-run\n",
+           trials, LAYOUT_COUNT, samples_count, BATCH_OPS, threshold, p_cell, alpha, ncells,
+           t_critical(p_cell, trials - 1), trials - 1);
+
+    /* Испытания ячеек перемежаются: испытания одной ячейки разнесены по всему
+     * прогону и не попадают целиком в один всплеск помех. */
+    for (int i = 0; i < ncells; ++i) cell_order[i] = i;
+    run_cells(cell_order, ncells, trials, samples, samples_count);
+
+    printf("%-10s %-8s %4s %6s %10s %10s %8s %8s %9s  %s\n",
+           "mode", "class", "len", "shift", "base cyc", "head cyc", "delta%", "t", "p", "verdict");
+    int nflagged = 0;
+    for (int i = 0; i < ncells; ++i) {
+        const cell_t* c = &cells[i];
+        cell_stats_t r = cell_stats(c, trials);
+        const char* verdict = "~";
+        if (r.p < p_cell && r.delta > threshold) {
+            verdict = "candidate";
+            cell_order[nflagged++] = i;
+        } else if (r.p < p_cell && r.delta < -threshold) {
+            verdict = "faster";
+            ++improvements;
+        }
+        printf("%-10s %-8s %4zu %6zu %10.1f %10.1f %+8.1f %8.1f %9.2g  %s\n",
+               mode_names[c->mode], class_names[c->cls], c->len, c->shift,
+               r.base_cyc, r.head_cyc, r.delta, r.t, r.p, verdict);
+    }
+
+    /* Повторный замер кандидатов новыми испытаниями: регрессия, только если
+     * разница воспроизводится. */
+    if (nflagged > 0) {
+        printf("\nRe-measuring %d candidate cell(s) with %d new trials:\n", nflagged, trials);
+        run_cells(cell_order, nflagged, trials, samples, samples_count);
+        for (int i = 0; i < nflagged; ++i) {
+            const cell_t* c = &cells[cell_order[i]];
+            cell_stats_t r = cell_stats(c, trials);
+            const char* verdict = "not reproduced";
+            if (r.p < p_cell && r.delta > threshold) {
+                verdict = "REGRESSION";
+                ++regressions;
+            }
+            printf("%-10s %-8s %4zu %6zu %10.1f %10.1f %+8.1f %8.1f %9.2g  %s\n",
+                   mode_names[c->mode], class_names[c->cls], c->len, c->shift,
+                   r.base_cyc, r.head_cyc, r.delta, r.t, r.p, verdict);
+        }
+    }
+
+    printf("\n----------------------------------------\n");
+    printf("compare summary: %d cells, %d regressions (%d candidates), %d faster, %d mismatches\n",
+           ncells, regressions, nflagged, improvements, mismatches);
+    printf("----------------------------------------\n");
+    free(samples);
+    free(trial_values);
+    return regressions == 0 && mismatches == 0 ? 0 : 1;
+}
@@ -15,28 +15,46 @@
  *   - rev 1.0 (12.08.2025): Первоначальная версия.
  *   - rev 1.1 (13.08.2025): Реализована предварительная генерация данных
  *                           в main для исключения rand() из потоков.
+ *   - rev 1.2 (14.10.2026): Удалено локальное определение BIGNUM_CAPACITY.
+ *   - rev 1.3 (14.10.2026): Фаза масштабирования bignum_shift_right_view_parallel
+ *                           (1, 2, 4 ... THREAD_COUNT потоков на одном большом числе).
+ *   - rev 1.4 (14.10.2026): Каждый замер view_parallel — с обычными и потоковыми
+ *                           записями (разница видна по cache-misses в отчете perf).
+ *   - rev 1.5 (14.10.2026): Фаза масштабирования независимых сдвигов: 1..nproc потоков
+ *                           с привязкой к CPU, приемники в своем блоке потока (локальный
+ *                           и удаленный узел NUMA) и в общем массиве (подряд и с
+ *                           выравниванием на строку кэша), ops/s на поток и эффективность.
  *
  * # Сборка
  * gcc -g -O2 -I include -no-pie -fno-omit-frame-pointer -pthread \
  *   benchmarks/bench_bignum_shift_right_mt.c build/bignum_shift_right.o \
+ *   build/bignum_shift_right_parallel.o \
  *   -o bin/bench_bignum_shift_right_mt
+ * С libnuma (удаленный узел в фазе масштабирования): -DBENCH_HAVE_LIBNUMA ... -lnuma
  *
  * # Запуск perf
  * /usr/local/bin/perf record -F 9999 -o benchmarks/reports/report_bench_bignum_shift_right_mt -g -- \
  *   bin/bench_bignum_shift_right_mt
  */
 
+#define _GNU_SOURCE   // pthread_setaffinity_np, sched_getaffinity
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <time.h>
+#include <string.h>
+#include <sched.h>
 #include <pthread.h>
+#ifdef BENCH_HAVE_LIBNUMA
+#  include <numa.h>
+#endif
 #include <bignum.h>
 #include "bignum_shift_right.h"
 
-// --- Локальные определения для компиляции ---
-#define BIGNUM_CAPACITY 32
-#define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+// BIGNUM_CAPACITY берется из bignum.h (make BIGNUM_CAPACITY=N)
+#ifndef BIGNUM_BITS
+#  define BIGNUM_BITS (BIGNUM_CAPACITY * 64)
+#endif
 
 #ifndef ITER_PER_THREAD
 #  define ITER_PER_THREAD (20000000u * 20)
@@ -46,6 +64,22 @@
 #  define THREAD_COUNT 4
 #endif
 
+#ifndef PAR_WORDS
+#  define PAR_WORDS (1u << 22)   // 32 МиБ: больше L3, упор в пропускную способность памяти
+#endif
+
+#ifndef PAR_ITERS
+#  define PAR_ITERS 200u
+#endif
+
+#ifndef SCALING_OPS_PER_THREAD
+#  define SCALING_OPS_PER_THREAD 20000000u
+#endif
+
+#define SCALING_DST_PER_THREAD 64    // приемников на поток: при CAP 32 около 17 КиБ, в L1/L2
+#define MAX_SCALING_THREADS    256
+#define CACHE_LINE             64
+
 #define PREGEN_DATA_COUNT 8192
 #define MAX_SHIFT (BIGNUM_BITS - 1)
 
@@ -70,6 +104,236 @@ static void init_random_bignum(bignum_t *num) {
     }
 }
 
+/** Монотонное время в секундах */
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Один большой view, PAR_ITERS сдвигов на 1 бит (ядро, копирование границ)
+ * и на 64 * 3 + 1 бит (сдвиг по словам на месте) для nthreads = 1, 2, 4 ...,
+ * с обычными записями и с потоковыми (порог 1 слово).
+ */
+static int bench_view_parallel(void) {
+    uint64_t* words = malloc((size_t)PAR_WORDS * sizeof(uint64_t));
+    if (!words) {
+        perror("Failed to allocate memory for view_parallel");
+        return 1;
+    }
+    printf("view_parallel: %u words, %u shifts per run\n", PAR_WORDS, PAR_ITERS);
+    for (unsigned run = 0; run < 2 * THREAD_COUNT; ++run) {
+        unsigned nthreads = 1u << (run / 2);
+        int streaming = run & 1;
+        if (nthreads > THREAD_COUNT) break;
+        bignum_shift_right_set_stream_threshold(streaming ? 1 : BIGNUM_SHIFT_RIGHT_STREAM_OFF);
+        for (size_t i = 0; i < PAR_WORDS; ++i) {
+            words[i] = ((uint64_t)rand() << 32) | (uint64_t)rand() | 1;
+        }
+        bignum_view_t view = {words, PAR_WORDS, PAR_WORDS};
+        double start = now_seconds();
+        for (unsigned i = 0; i < PAR_ITERS; ++i) {
+            bignum_shift_right_view_parallel(&view, (i & 1) ? 64 * 3 + 1 : 1, nthreads);
+        }
+        double elapsed = now_seconds() - start;
+        double bytes = (double)PAR_ITERS * PAR_WORDS * sizeof(uint64_t) * 2;  // чтение + запись
+        printf("  %2u threads, %-9s stores: %8.3f ms/shift, %6.2f GB/s\n",
+               nthreads, streaming ? "streaming" : "regular", elapsed * 1e3 / PAR_ITERS, bytes / elapsed * 1e-9);
+    }
+    bignum_shift_right_set_stream_threshold(BIGNUM_SHIFT_RIGHT_STREAM_OFF);
+    free(words);
+    return 0;
+}
+
+/** Раскладка приемников в фазе масштабирования. */
+typedef enum {
+    LAYOUT_PRIVATE_LOCAL,   /**< Свой блок потока, первое касание владельцем (узел NUMA потока). */
+    LAYOUT_PRIVATE_REMOTE,  /**< Свой блок потока на соседнем узле NUMA (numa_alloc_onnode). */
+    LAYOUT_SHARED_PACKED,   /**< Общий массив bignum_t подряд, элемент j — потока j % n (false sharing). */
+    LAYOUT_SHARED_PADDED,   /**< Тот же общий массив, элементы выровнены на строку кэша. */
+    LAYOUT_COUNT
+} dst_layout_t;
+
+static const char* const layout_names[LAYOUT_COUNT] = {
+    "private/local", "private/remote", "shared/packed", "shared/padded"
+};
+
+/** Аргументы потока фазы масштабирования. */
+typedef struct {
+    unsigned          id;
+    unsigned          nthreads;
+    int               cpu;         /**< CPU, к которому привязан поток. */
+    dst_layout_t      layout;
+    unsigned char*    dst;         /**< Общий массив или свой блок (NULL — выделяет сам поток). */
+    size_t            stride;      /**< Шаг элементов приемника, байт. */
+    const bignum_t*   sources;
+    const size_t*     shifts;
+    unsigned          data_count;
+    pthread_barrier_t* start;
+    double            ops_per_sec; /**< Результат: операций в секунду этого потока. */
+    int               error;
+} scaling_arg_t;
+
+static size_t round_up_line(size_t n) {
+    return (n + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+static void* scaling_alloc(size_t size) {
+#ifdef BENCH_HAVE_LIBNUMA
+    if (numa_available() != -1) return numa_alloc_local(size);
+#endif
+    return aligned_alloc(CACHE_LINE, round_up_line(size));
+}
+
+static void scaling_free(void* p, size_t size) {
+#ifdef BENCH_HAVE_LIBNUMA
+    if (numa_available() != -1) {
+        numa_free(p, size);
+        return;
+    }
+#endif
+    (void)size;
+    free(p);
+}
+
+/** Адрес k-го приемника потока. */
+static bignum_t* scaling_dst(const scaling_arg_t* a, unsigned char* base, size_t k) {
+    size_t index = a->layout >= LAYOUT_SHARED_PACKED ? k * a->nthreads + a->id : k;
+    return (bignum_t*)(base + index * a->stride);
+}
+
+static void* scaling_thread_func(void* arg) {
+    scaling_arg_t* a = arg;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(a->cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) a->error = 1;
+
+    // Блок private/local выделяет и первым касается сам поток после привязки
+    size_t own_size = (size_t)SCALING_DST_PER_THREAD * a->stride;
+    unsigned char* base = a->dst ? a->dst : scaling_alloc(own_size);
+    if (!base) a->error = 1;
+    for (size_t k = 0; base && k < SCALING_DST_PER_THREAD; ++k) {
+        memset(scaling_dst(a, base, k), 0, sizeof(bignum_t));
+    }
+
+    pthread_barrier_wait(a->start);
+    if (a->error) return NULL;
+    double start = now_seconds();
+    for (unsigned i = 0; i < SCALING_OPS_PER_THREAD; ++i) {
+        unsigned data_idx = (i + a->id) % a->data_count;
+        bignum_shift_right_to(scaling_dst(a, base, i % SCALING_DST_PER_THREAD),
+                              &a->sources[data_idx], a->shifts[data_idx]);
+    }
+    a->ops_per_sec = SCALING_OPS_PER_THREAD / (now_seconds() - start);
+    if (!a->dst) scaling_free(base, own_size);
+    return NULL;
+}
+
+/** Узел NUMA для private/remote: следующий за узлом CPU; -1 — недоступно. */
+static int remote_node_of_cpu(int cpu) {
+#ifdef BENCH_HAVE_LIBNUMA
+    if (numa_available() != -1 && numa_max_node() > 0) {
+        int node = numa_node_of_cpu(cpu);
+        if (node >= 0) return (node + 1) % (numa_max_node() + 1);
+    }
+#endif
+    (void)cpu;
+    return -1;
+}
+
+/** Один замер: nthreads потоков на cpus[0..nthreads), раскладка layout. 0 — ошибка. */
+static double run_scaling(dst_layout_t layout, unsigned nthreads, const int* cpus,
+                          const bignum_t* sources, const size_t* shifts,
+                          double* per_thread_min) {
+    scaling_arg_t args[MAX_SCALING_THREADS];
+    pthread_t threads[MAX_SCALING_THREADS];
+    pthread_barrier_t start;
+    size_t stride = layout == LAYOUT_SHARED_PACKED ? sizeof(bignum_t) : round_up_line(sizeof(bignum_t));
+    size_t shared_size = (size_t)SCALING_DST_PER_THREAD * nthreads * stride;
+    unsigned char* shared = NULL;
+    if (layout >= LAYOUT_SHARED_PACKED && !(shared = aligned_alloc(CACHE_LINE, round_up_line(shared_size)))) return 0;
+
+    pthread_barrier_init(&start, NULL, nthreads);
+    int failed = 0;
+    for (unsigned t = 0; t < nthreads; ++t) {
+        args[t] = (scaling_arg_t){t, nthreads, cpus[t], layout, shared, stride,
+                                  sources, shifts, PREGEN_DATA_COUNT, &start, 0.0, 0};
+#ifdef BENCH_HAVE_LIBNUMA
+        if (layout == LAYOUT_PRIVATE_REMOTE) {
+            args[t].dst = numa_alloc_onnode((size_t)SCALING_DST_PER_THREAD * stride, remote_node_of_cpu(cpus[t]));
+            if (!args[t].dst) failed = 1;
+        }
+#endif
+    }
+    for (unsigned t = 0; t < nthreads && !failed; ++t) {
+        if (pthread_create(&threads[t], NULL, scaling_thread_func, &args[t]) != 0) failed = 1;
+    }
+    if (failed) {
+        // Запущенные потоки ждут на барьере остальных: продолжать замер нельзя
+        fprintf(stderr, "scaling: failed to start %u threads\n", nthreads);
+        exit(1);
+    }
+
+    double total = 0.0, min = 0.0;
+    for (unsigned t = 0; t < nthreads; ++t) {
+        pthread_join(threads[t], NULL);
+        if (args[t].error) failed = 1;
+        total += args[t].ops_per_sec;
+        if (t == 0 || args[t].ops_per_sec < min) min = args[t].ops_per_sec;
+#ifdef BENCH_HAVE_LIBNUMA
+        if (layout == LAYOUT_PRIVATE_REMOTE) numa_free(args[t].dst, (size_t)SCALING_DST_PER_THREAD * stride);
+#endif
+    }
+    pthread_barrier_destroy(&start);
+    free(shared);
+    *per_thread_min = min;
+    return failed ? 0.0 : total;
+}
+
+/**
+ * Масштабирование независимых сдвигов: 1..nproc потоков, каждый привязан к
+ * своему CPU (pthread_setaffinity_np), сдвиги bignum_shift_right_to из общего
+ * пула источников в приемники раскладки layout. Эффективность — суммарные
+ * ops/s при n потоках относительно n * ops/s одного потока.
+ */
+static int bench_scaling(const bignum_t* sources, const size_t* shifts) {
+    cpu_set_t allowed;
+    int cpus[MAX_SCALING_THREADS];
+    unsigned ncpus = 0;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        perror("sched_getaffinity");
+        return 1;
+    }
+    for (int c = 0; c < CPU_SETSIZE && ncpus < MAX_SCALING_THREADS; ++c) {
+        if (CPU_ISSET(c, &allowed)) cpus[ncpus++] = c;
+    }
+    printf("scaling: 1..%u threads, %u shifts per thread, %u destinations per thread, "
+           "sizeof(bignum_t) = %zu\n", ncpus, SCALING_OPS_PER_THREAD, SCALING_DST_PER_THREAD, sizeof(bignum_t));
+
+    for (int layout = 0; layout < LAYOUT_COUNT; ++layout) {
+        if (layout == LAYOUT_PRIVATE_REMOTE && remote_node_of_cpu(cpus[0]) < 0) {
+            printf("  %-15s skipped: needs libnuma and more than one NUMA node\n", layout_names[layout]);
+            continue;
+        }
+        double single = 0.0;
+        for (unsigned n = 1; n <= ncpus; ++n) {
+            double min = 0.0;
+            double total = run_scaling((dst_layout_t)layout, n, cpus, sources, shifts, &min);
+            if (total == 0.0) {
+                fprintf(stderr, "scaling: %s with %u threads failed\n", layout_names[layout], n);
+                return 1;
+            }
+            if (n == 1) single = total;
+            printf("  %-15s %3u threads: %9.2f Mops/s total, %7.2f Mops/s per thread (min %7.2f), "
+                   "efficiency %5.1f%%\n", layout_names[layout], n, total * 1e-6, total / n * 1e-6,
+                   min * 1e-6, total / (n * single) * 100.0);
+        }
+    }
+    return 0;
+}
+
 /** Функция, исполняемая каждым потоком */
 static void* thread_func(void *arg) {
     const thread_arg_t *t = arg;
@@ -135,11 +399,17 @@ int main(void) {
         }
     }
     
+    // --- Фаза 3: Масштабирование многопоточного сдвига одного числа ---
+    int rc = bench_view_parallel();
+
+    // --- Фаза 3б: Масштабирование независимых сдвигов, NUMA и false sharing ---
+    if (rc == 0) rc = bench_scaling(sources, shifts);
+
     printf("Benchmark finished.\n");
 
-    // --- Фаза 3: Очистка ---
+    // --- Фаза 4: Очистка ---
     free(sources);
     free(shifts);
 
-    return 0;
+    return rc;
 }
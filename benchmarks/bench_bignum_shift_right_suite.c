@@ -0,0 +1,333 @@
+/**
+ * @file    bench_bignum_shift_right_suite.c
+ * @brief   Набор бенчмарков bignum_shift_right: задержка и пропускная способность с JSON-отчетом.
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @details
+ *   В отличие от bench_bignum_shift_right.c (цикл для сэмплирования perf),
+ *   здесь измеряется стоимость одного сдвига:
+ *   - Время — TSC (rdtscp, с lfence) в начале и конце выборки из
+ *     BATCH_OPS сдвигов; частота TSC калибруется по clock_gettime,
+ *     поэтому в отчете есть и такты TSC, и наносекунды на операцию.
+ *     Не на x86-64 вместо TSC — cntvct_el0 (AArch64) или
+ *     clock_gettime(CLOCK_MONOTONIC_RAW); поле tsc_ghz JSON — частота
+ *     этого счетчика. Его разрешение бывает грубее операции, поэтому
+ *     сравнимы наносекунды, а не «такты».
+ *   - Числа выборки (BATCH_OPS независимых копий, помещаются в L1)
+ *     готовятся вне измеряемого участка: копирование структуры не
+ *     входит в результат.
+ *   - throughput: сдвиги независимы. latency: величина каждого сдвига
+ *     зависит по данным от words[0] результата предыдущего
+ *     (`and 0` не разрывает зависимость), то есть измеряется цепочка.
+ *   - Развертка по len = 1..BIGNUM_CAPACITY и классам сдвига:
+ *     word (кратный 64), bit (< 64), combined (слова + биты),
+ *     zeroing (>= len * 64).
+ *   - Эталон — GMP mpz_tdiv_q_2exp на тех же значениях (вне места,
+ *     приемники заранее выделены на BIGNUM_CAPACITY слов).
+ *   Для каждой ячейки — медиана и минимум по выборкам.
+ *
+ * @history
+ *   - rev 1.0 (14.10.2026): Первоначальная версия.
+ *   - rev 1.1 (14.10.2026): Реализация библиотеки (asm или c, BENCH_LIB_SOURCE) в заголовке
+ *                           и JSON: отчеты USE_ASM=yes и USE_ASM=no сравниваются по ячейкам.
+ *   - rev 1.2 (14.10.2026): Счетчик cntvct_el0 / CLOCK_MONOTONIC_RAW вместо TSC не на x86-64.
+ *
+ * # Запуск
+ *   make bench_suite CONFIG=release          # таблица + benchmarks/reports/$(REPORT_NAME)_suite.json
+ *   bin/bench_bignum_shift_right_suite --json out.json --samples 500
+ */
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime в режиме -std=c11
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#  include <x86intrin.h>
+#endif
+#include <gmp.h>
+#include <bignum.h>
+#include "bignum_shift_right.h"
+
+// Реализация библиотеки (SRC_EXT из Makefile): asm или c
+#ifndef BENCH_LIB_SOURCE
+#  define BENCH_LIB_SOURCE "asm"
+#endif
+
+// Сдвигов в одной выборке; BATCH_OPS чисел помещаются в L1
+#define BATCH_OPS 32
+
+// Выборок на ячейку по умолчанию (--samples)
+#define DEFAULT_SAMPLES 1000
+
+typedef enum { CLASS_WORD, CLASS_BIT, CLASS_COMBINED, CLASS_ZEROING, CLASS_COUNT } shift_class_t;
+typedef enum { MODE_THROUGHPUT, MODE_LATENCY, MODE_COUNT } bench_mode_t;
+typedef enum { IMPL_LIB, IMPL_GMP, IMPL_COUNT } bench_impl_t;
+
+static const char* const class_names[CLASS_COUNT] = {"word", "bit", "combined", "zeroing"};
+static const char* const mode_names[MODE_COUNT] = {"throughput", "latency"};
+static const char* const impl_names[IMPL_COUNT] = {"bignum_shift_right", "mpz_tdiv_q_2exp"};
+
+typedef struct {
+    double median_cycles;
+    double min_cycles;
+} cell_result_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*
+ * Счетчик времени выборки: TSC на x86-64 (lfence + rdtsc ... rdtscp + lfence),
+ * виртуальный счетчик cntvct_el0 с isb на AArch64, иначе наносекунды
+ * clock_gettime(CLOCK_MONOTONIC_RAW).
+ */
+#if defined(__x86_64__)
+#  define TIMER_NAME "TSC"
+#elif defined(__aarch64__)
+#  define TIMER_NAME "cntvct_el0"
+#else
+#  define TIMER_NAME "CLOCK_MONOTONIC_RAW"
+#endif
+
+static inline uint64_t tsc_begin(void) {
+#if defined(__x86_64__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t) : : "memory");
+    return t;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t tsc_end(void) {
+#if defined(__x86_64__)
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+    return t;
+#else
+    return tsc_begin();
+#endif
+}
+
+/** Частота TSC в ГГц (тактов TSC на наносекунду), по ~50 мс clock_gettime. */
+static double calibrate_tsc_ghz(void) {
+    double t0 = now_ns();
+    uint64_t c0 = tsc_begin();
+    while (now_ns() - t0 < 50e6) {}
+    uint64_t c1 = tsc_end();
+    return (double)(c1 - c0) / (now_ns() - t0);
+}
+
+#if !defined(__x86_64__) && !defined(__aarch64__)
+static volatile uint64_t chain_zero;                // Всегда 0; компилятор не знает значения
+#endif
+
+/** Обнуляет зависимость по значению, сохраняя зависимость по данным для CPU. */
+static inline size_t chain_dep(uint64_t x) {
+#if defined(__x86_64__)
+    __asm__ volatile("andq $0, %0" : "+r"(x));
+#elif defined(__aarch64__)
+    __asm__ volatile("and %0, %0, xzr" : "+r"(x));
+#else
+    x &= chain_zero;
+#endif
+    return (size_t)x;
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+/** Величина сдвига класса cls для числа длины len; 0 — класс неприменим. */
+static size_t class_shift(shift_class_t cls, size_t len) {
+    switch (cls) {
+        case CLASS_WORD:     return 64 * (len / 2);
+        case CLASS_BIT:      return 13;
+        case CLASS_COMBINED: return len >= 2 ? 64 * (len / 2) + 13 : 0;
+        case CLASS_ZEROING:  return 64 * len + 7;
+        default:             return 0;
+    }
+}
+
+static bignum_t pristine[BATCH_OPS];
+static bignum_t work[BATCH_OPS];
+static mpz_t gmp_src[BATCH_OPS];
+static mpz_t gmp_dst[BATCH_OPS];
+
+static void prepare_numbers(size_t len) {
+    for (size_t n = 0; n < BATCH_OPS; ++n) {
+        memset(&pristine[n], 0, sizeof(pristine[n]));
+        pristine[n].len = len;
+        for (size_t i = 0; i < len; ++i) pristine[n].words[i] = rng_next();
+        pristine[n].words[len - 1] |= 1ULL << 63;
+        mpz_import(gmp_src[n], len, -1, sizeof(uint64_t), 0, 0, pristine[n].words);
+    }
+}
+
+/** Одна выборка: BATCH_OPS сдвигов, такты TSC на операцию. */
+static double run_sample(bench_impl_t impl, bench_mode_t mode, size_t shift) {
+    uint64_t t0, t1;
+    size_t dep = 0;
+    if (impl == IMPL_LIB) {
+        memcpy(work, pristine, sizeof(work));
+        if (mode == MODE_THROUGHPUT) {
+            t0 = tsc_begin();
+            for (size_t n = 0; n < BATCH_OPS; ++n) bignum_shift_right(&work[n], shift);
+            t1 = tsc_end();
+        } else {
+            t0 = tsc_begin();
+            for (size_t n = 0; n < BATCH_OPS; ++n) {
+                bignum_shift_right(&work[n], shift + dep);
+                dep = chain_dep(work[n].words[0]);
+            }
+            t1 = tsc_end();
+        }
+    } else {
+        if (mode == MODE_THROUGHPUT) {
+            t0 = tsc_begin();
+            for (size_t n = 0; n < BATCH_OPS; ++n) mpz_tdiv_q_2exp(gmp_dst[n], gmp_src[n], shift);
+            t1 = tsc_end();
+        } else {
+            t0 = tsc_begin();
+            for (size_t n = 0; n < BATCH_OPS; ++n) {
+                mpz_tdiv_q_2exp(gmp_dst[n], gmp_src[n], shift + dep);
+                dep = chain_dep(mpz_getlimbn(gmp_dst[n], 0));
+            }
+            t1 = tsc_end();
+        }
+    }
+    return (double)(t1 - t0) / BATCH_OPS;
+}
+
+static cell_result_t run_cell(bench_impl_t impl, bench_mode_t mode, size_t shift, double* samples, int count) {
+    for (int w = 0; w < count / 10 + 1; ++w) run_sample(impl, mode, shift);  /* Прогрев. */
+    for (int s = 0; s < count; ++s) samples[s] = run_sample(impl, mode, shift);
+    qsort(samples, (size_t)count, sizeof(samples[0]), cmp_double);
+    cell_result_t r = {samples[count / 2], samples[0]};
+    return r;
+}
+
+static const char* kernel_name(bignum_shift_right_kernel_t k) {
+    switch (k) {
+        case BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR:       return "scalar";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX2:         return "avx2";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX512:       return "avx512";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_AVX512_VBMI2: return "avx512_vbmi2";
+        case BIGNUM_SHIFT_RIGHT_KERNEL_NEON:         return "neon";
+        default:                                     return "unknown";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = NULL;
+    int samples_count = DEFAULT_SAMPLES;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples_count = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--json <file>] [--samples <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (samples_count < 1) samples_count = 1;
+    if (!bignum_shift_right_capacity_matches()) {
+        fprintf(stderr, "Library capacity %lu != BIGNUM_CAPACITY %d\n",
+                (unsigned long)bignum_shift_right_capacity, (int)BIGNUM_CAPACITY);
+        return 1;
+    }
+
+    double* samples = malloc(sizeof(double) * (size_t)samples_count);
+    FILE* json = json_path ? fopen(json_path, "w") : NULL;
+    if (!samples || (json_path && !json)) {
+        perror(json_path && !json ? json_path : "Failed to allocate memory for samples");
+        free(samples);
+        return 1;
+    }
+    for (size_t n = 0; n < BATCH_OPS; ++n) {
+        mpz_init2(gmp_src[n], BIGNUM_CAPACITY * 64);
+        mpz_init2(gmp_dst[n], BIGNUM_CAPACITY * 64);
+    }
+
+    double tsc_ghz = calibrate_tsc_ghz();
+    const char* kernel = kernel_name(bignum_shift_right_get_kernel());
+    printf("bignum_shift_right benchmark suite: %s, capacity %d, kernel %s, %s %.3f GHz, %d samples x %d ops\n",
+           BENCH_LIB_SOURCE, (int)BIGNUM_CAPACITY, kernel, TIMER_NAME, tsc_ghz, samples_count, BATCH_OPS);
+    printf("%-20s %-10s %-8s %4s %6s %10s %10s %10s\n",
+           "impl", "mode", "class", "len", "shift", "cyc/op", "min cyc", "ns/op");
+    if (json) {
+        fprintf(json, "{\n  \"suite\": \"bench_bignum_shift_right_suite\",\n");
+        fprintf(json, "  \"source\": \"%s\",\n  \"capacity\": %d,\n  \"kernel\": \"%s\",\n  \"tsc_ghz\": %.4f,\n",
+                BENCH_LIB_SOURCE, (int)BIGNUM_CAPACITY, kernel, tsc_ghz);
+        fprintf(json, "  \"samples\": %d,\n  \"ops_per_sample\": %d,\n  \"results\": [", samples_count, BATCH_OPS);
+    }
+
+    int first = 1;
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        prepare_numbers(len);
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            size_t shift = class_shift((shift_class_t)cls, len);
+            if (shift == 0) continue;
+            for (int impl = 0; impl < IMPL_COUNT; ++impl) {
+                for (int mode = 0; mode < MODE_COUNT; ++mode) {
+                    cell_result_t r = run_cell((bench_impl_t)impl, (bench_mode_t)mode, shift,
+                                               samples, samples_count);
+                    double ns = r.median_cycles / tsc_ghz;
+                    printf("%-20s %-10s %-8s %4zu %6zu %10.1f %10.1f %10.2f\n",
+                           impl_names[impl], mode_names[mode], class_names[cls], len, shift,
+                           r.median_cycles, r.min_cycles, ns);
+                    if (json) {
+                        fprintf(json, "%s\n    {\"impl\": \"%s\", \"mode\": \"%s\", \"class\": \"%s\", "
+                                      "\"len\": %zu, \"shift\": %zu, \"cycles_per_op\": %.2f, "
+                                      "\"min_cycles_per_op\": %.2f, \"ns_per_op\": %.3f}",
+                                first ? "" : ",", impl_names[impl], mode_names[mode], class_names[cls],
+                                len, shift, r.median_cycles, r.min_cycles, ns);
+                        first = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+        printf("JSON report: %s\n", json_path);
+    }
+    for (size_t n = 0; n < BATCH_OPS; ++n) {
+        mpz_clear(gmp_src[n]);
+        mpz_clear(gmp_dst[n]);
+    }
+    free(samples);
+    return 0;
+}
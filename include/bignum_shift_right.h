@@ -19,7 +19,7 @@
  *    2. Нулевой сдвиг — быстрый выход.
  *    3. Разбиение `shift_amount` на сдвиг по словам (`word_shift`) и битам (`bit_shift`).
  *    4. Если сдвиг по словам превышает длину числа, обнулить его и вернуть BIGNUM_SHIFT_RIGHT_ZEROED.
- *    5. Сдвиг по словам, затем побитовый сдвиг с переносами между словами.
+ *    5. Сдвиг по словам и побитовый сдвиг с переносами между словами за один проход.
  *    6. Обновление `len` и нормализация результата.
  *
  * @see     bignum.h
@@ -31,6 +31,61 @@
  *                         BIGNUM_SHIFT_RIGHT_ZEROED, уточнена документация
  *                         потокобезопасности и поведения при обнулении.
  *   - rev. 3 (10.11.2025): Removed version control functions.
+ *   - rev. 4 (14.10.2026): Добавлен пакетный API: bignum_shift_right_batch и
+ *                         bignum_shift_right_batch_uniform.
+ *   - rev. 5 (14.10.2026): Векторные ядра побитового сдвига (AVX2, AVX-512F,
+ *                         AVX-512 VBMI2) с выбором по CPUID; добавлены
+ *                         bignum_shift_right_get_kernel/set_kernel и код
+ *                         BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED.
+ *   - rev. 6 (14.10.2026): Добавлен сдвиг без копирования bignum_shift_right_to.
+ *   - rev. 7 (14.10.2026): Сдвиг по словам и по битам объединен в один проход.
+ *   - rev. 8 (14.10.2026): Проверки раскладки bignum_t для заданной BIGNUM_CAPACITY
+ *                         (static_assert) и константа bignum_shift_right_capacity.
+ *   - rev. 9 (14.10.2026): Встраиваемые функции для сдвигов, известных при компиляции:
+ *                         bignum_shift_right_1, bignum_shift_right_bits,
+ *                         bignum_shift_right_words и макрос BIGNUM_SHIFT_RIGHT.
+ *   - rev. 10 (14.10.2026): Сдвиг с сохранением выпавших бит: bignum_shift_right_rem
+ *                          (остаток от деления на 2^k) и bignum_shift_right_sticky
+ *                          (старшие выпавшие биты и sticky-бит для округления).
+ *   - rev. 11 (14.10.2026): Арифметический сдвиг bignum_shift_right_arith.
+ *   - rev. 12 (14.10.2026): Сдвиг с округлением bignum_shift_right_round.
+ *   - rev. 13 (14.10.2026): Извлечение битового окна: bignum_shift_right_extract_bits
+ *                          и встраиваемая bignum_shift_right_extract_u64.
+ *   - rev. 14 (14.10.2026): Сдвиг со знаком bignum_shift_right_signed (s < 0 — влево)
+ *                          и код BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW.
+ *   - rev. 15 (14.10.2026): bignum_view_t и bignum_shift_right_view для чисел любой
+ *                          длины во внешних буферах.
+ *   - rev. 16 (14.10.2026): Многопоточный сдвиг bignum_shift_right_view_parallel.
+ *   - rev. 17 (14.10.2026): Потоковые записи для больших внешних буферов и
+ *                          bignum_shift_right_set_stream_threshold.
+ *   - rev. 18 (14.10.2026): Сдвиг за постоянное время bignum_shift_right_ct.
+ *   - rev. 19 (14.10.2026): Отложенный сдвиг bignum_lazy_t: накопление цепочки
+ *                          сдвигов и один проход ядра при материализации.
+ *   - rev. 20 (14.10.2026): Сдвиг на число младших нулевых бит bignum_shift_right_ctz.
+ *   - rev. 21 (14.10.2026): Пакетный формат SoA bignum_soa_t: bignum_shift_right_soa,
+ *                          bignum_shift_right_soa_pack и bignum_shift_right_soa_unpack.
+ *   - rev. 22 (14.10.2026): Сдвиг без проверок bignum_shift_right_unchecked с контролем
+ *                          предусловий при BIGNUM_SHIFT_RIGHT_DEBUG.
+ *   - rev. 23 (14.10.2026): Счетчики путей, гистограмма len и такты bignum_shift_right
+ *                          в инструментированной сборке (INSTRUMENT=yes):
+ *                          bignum_shift_right_stats_get/reset.
+ *   - rev. 24 (14.10.2026): Входы для известного класса сдвига bignum_shift_right_bits_only
+ *                          и bignum_shift_right_words_only; диспетчер
+ *                          bignum_shift_right_dispatch с порядком проверок из профиля
+ *                          (BIGNUM_SHIFT_RIGHT_PROFILE_ORDER, bignum_shift_right_stats_profile).
+ *   - rev. 25 (14.10.2026): Пул чисел в слотах, выровненных на строку кэша (bignum_pool_t),
+ *                          и пакетный сдвиг по массиву указателей bignum_shift_right_batch_ptr.
+ *   - rev. 26 (14.10.2026): Асинхронные пакеты: bignum_shift_right_submit (пул потоков с
+ *                          кражей отрезков), bignum_shift_right_async_wait и счетчики
+ *                          bignum_shift_right_async_stats_get/reset.
+ *   - rev. 27 (14.10.2026): Ядро BIGNUM_SHIFT_RIGHT_KERNEL_NEON переносимой реализации
+ *                          на C (src/bignum_shift_right.c, AArch64).
+ *   - rev. 28 (14.10.2026): Сериализация сдвинутого числа: bignum_shift_right_export_be.
+ *   - rev. 29 (14.10.2026): Сдвиг на величину bignum_t: bignum_shift_right_by и
+ *                          bignum_shift_right_by_nz (насыщение только записью len = 0).
+ *   - rev. 30 (14.10.2026): Режим «грязного хвоста»: bignum_shift_right_nz,
+ *                          bignum_shift_right_to_nz и bignum_shift_right_clear_tail.
+ *   - rev. 31 (14.10.2026): Пакетные функции предзагружают все строки элемента i + 2.
  */
 
 #ifndef BIGNUM_SHIFT_RIGHT_H
@@ -45,6 +100,23 @@
 #  error "bignum.h must define BIGNUM_CAPACITY"
 #endif
 
+#ifdef __cplusplus
+#  define BIGNUM_SHIFT_RIGHT_STATIC_ASSERT static_assert
+#else
+#  define BIGNUM_SHIFT_RIGHT_STATIC_ASSERT _Static_assert
+#endif
+
+// Раскладка bignum_t, на которую рассчитана ассемблерная реализация: смещения
+// в ней вычисляются из BIGNUM_CAPACITY, переданной при сборке библиотеки.
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(offsetof(bignum_t, words) == 0,
+                                 "bignum_t.words must be the first field");
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(sizeof(((bignum_t*)0)->words) == BIGNUM_CAPACITY * sizeof(uint64_t),
+                                 "bignum_t.words must hold BIGNUM_CAPACITY 64-bit words");
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(offsetof(bignum_t, len) == BIGNUM_CAPACITY * sizeof(uint64_t),
+                                 "bignum_t.len must follow words without padding");
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(sizeof(bignum_t) == BIGNUM_CAPACITY * sizeof(uint64_t) + 8,
+                                 "sizeof(bignum_t) must be BIGNUM_CAPACITY * 8 + 8");
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,11 +126,96 @@ extern "C" {
  * @brief Коды состояния для функции bignum_shift_right.
  */
 typedef enum {
-    BIGNUM_SHIFT_RIGHT_SUCCESS         =  0, /**< Успех. Сдвиг выполнен. */
-    BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG  = -1, /**< Указатель `num` равен NULL. */
-    BIGNUM_SHIFT_RIGHT_ZEROED          =  1, /**< Сдвиг больше длины числа, результат обнулен. */
+    BIGNUM_SHIFT_RIGHT_SUCCESS           =  0, /**< Успех. Сдвиг выполнен. */
+    BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG    = -1, /**< Указатель `num` равен NULL. */
+    BIGNUM_SHIFT_RIGHT_ZEROED            =  1, /**< Сдвиг больше длины числа, результат обнулен. */
+    BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED = -2, /**< Запрошенное ядро не поддерживается CPU или ОС. */
+    BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW    = -3, /**< Результат не помещается в BIGNUM_CAPACITY слов, число не изменено. */
 } bignum_shift_right_status_t;
 
+/**
+ * @brief Ядра побитового сдвига, между которыми выбирает bignum_shift_right.
+ *
+ * @details
+ *   По умолчанию при первом сдвиге числа длиной от 8 слов выбирается
+ *   лучшее ядро, поддерживаемое CPU и ОС (CPUID + XGETBV):
+ *   AVX-512 VBMI2 (Ice Lake, Zen 4) → AVX-512F (Skylake-SP) → AVX2 → скалярное.
+ *   Реализация на C (`make USE_ASM=no`) на AArch64 выбирает NEON.
+ *   Короткие числа всегда сдвигаются скалярным кодом.
+ */
+typedef enum {
+    BIGNUM_SHIFT_RIGHT_KERNEL_AUTO         = 0, /**< Лучшее доступное ядро (только для set_kernel). */
+    BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR       = 1, /**< Скалярное ядро ror/and/shr/or. */
+    BIGNUM_SHIFT_RIGHT_KERNEL_AVX2         = 2, /**< AVX2: vpsrlq/vpsllq, 4 слова за итерацию. */
+    BIGNUM_SHIFT_RIGHT_KERNEL_AVX512       = 3, /**< AVX-512F: vpsrlq/vpsllq, 8 слов за итерацию. */
+    BIGNUM_SHIFT_RIGHT_KERNEL_AVX512_VBMI2 = 4, /**< AVX-512 VBMI2: vpshrdvq, 8 слов за итерацию. */
+    BIGNUM_SHIFT_RIGHT_KERNEL_NEON         = 5, /**< AArch64 NEON: ushl, 4 слова за итерацию (только реализация на C). */
+} bignum_shift_right_kernel_t;
+
+/**
+ * @brief Режимы округления для bignum_shift_right_round.
+ */
+typedef enum {
+    BIGNUM_SHIFT_RIGHT_ROUND_TRUNC     = 0, /**< Отбрасывание (как bignum_shift_right). */
+    BIGNUM_SHIFT_RIGHT_ROUND_CEIL      = 1, /**< Вверх, если выпал хотя бы один ненулевой бит. */
+    BIGNUM_SHIFT_RIGHT_ROUND_HALF_UP   = 2, /**< К ближайшему, половина — вверх. */
+    BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN = 3, /**< К ближайшему, половина — к четному. */
+} bignum_shift_right_round_t;
+
+/**
+ * @brief Представление числа во внешнем буфере произвольной длины.
+ *
+ * @details
+ *   Слова little-endian, как в bignum_t, но буфер принадлежит вызывающему
+ *   коду и не ограничен BIGNUM_CAPACITY (например, RSA-8192 или факториалы),
+ *   а длина — полноценный size_t. Должно выполняться `len <= cap`.
+ */
+typedef struct {
+    uint64_t* words; /**< Слова числа, младшее первым. */
+    size_t    len;   /**< Число значащих слов. */
+    size_t    cap;   /**< Размер буфера words в словах. */
+} bignum_view_t;
+
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(offsetof(bignum_view_t, len) == 8 && offsetof(bignum_view_t, cap) == 16,
+                                 "bignum_view_t must be {words, len, cap} with 8-byte fields");
+
+/**
+ * @brief Пакет чисел одинаковой длины в формате SoA (structure of arrays).
+ *
+ * @details
+ *   Слово `i` числа `j` хранится в `words[i * count + j]`: слова с одним номером
+ *   у всех чисел лежат подряд, и векторные инструкции обрабатывают по 4 (AVX2)
+ *   или 8 (AVX-512) чисел. `len` — общая длина пакета (максимум длин чисел);
+ *   слова выше длины конкретного числа равны нулю. Буфер `words` принадлежит
+ *   вызывающему коду и должен вмещать `count * BIGNUM_CAPACITY` слов.
+ */
+typedef struct {
+    uint64_t* words; /**< Слова пакета, строка i — слова i всех чисел. */
+    size_t    count; /**< Количество чисел в пакете. */
+    size_t    len;   /**< Общая длина пакета в словах, не больше BIGNUM_CAPACITY. */
+} bignum_soa_t;
+
+BIGNUM_SHIFT_RIGHT_STATIC_ASSERT(offsetof(bignum_soa_t, count) == 8 && offsetof(bignum_soa_t, len) == 16,
+                                 "bignum_soa_t must be {words, count, len} with 8-byte fields");
+
+/**
+ * @brief Емкость bignum_t (в словах), с которой собрана библиотека.
+ *
+ * @details
+ *   Задается при сборке (`make BIGNUM_CAPACITY=N`). Раскладка bignum_t
+ *   проверяется при компиляции, но библиотека, собранная с другой емкостью,
+ *   обнаруживается только при выполнении — см. bignum_shift_right_capacity_matches().
+ */
+extern const uint64_t bignum_shift_right_capacity;
+
+/**
+ * @brief  Проверяет, что библиотека собрана с той же BIGNUM_CAPACITY, что и вызывающий код.
+ * @return 1, если емкости совпадают, иначе 0.
+ */
+static inline int bignum_shift_right_capacity_matches(void) {
+    return bignum_shift_right_capacity == BIGNUM_CAPACITY;
+}
+
 /**
  * @brief      Выполняет логический сдвиг большого числа вправо.
  *
@@ -68,9 +225,10 @@ typedef enum {
  *   2.  Если `shift_amount` равен 0, немедленно вернуть успех.
  *   3.  Вычислить сдвиг в целых словах (`word_shift`) и в битах внутри слова (`bit_shift`).
  *   4.  Если `word_shift` больше или равен `len`, обнулить число и вернуть `BIGNUM_SHIFT_RIGHT_ZEROED`.
- *   5.  Выполнить сдвиг по словам, перемещая данные в младшие позиции.
- *   6.  Выполнить побитовый сдвиг внутри слов, распространяя биты-переносы
- *       из старших слов в младшие.
+ *   5.  За один проход записать в `words[i]` результат сдвига пары
+ *       `words[i + word_shift]`, `words[i + word_shift + 1]` на `bit_shift` бит
+ *       (при `bit_shift == 0` — просто перенести слово).
+ *   6.  Обнулить освободившиеся старшие `word_shift` слов.
  *   7.  Обновить поле `len` и нормализовать результат (удалить ведущие нули).
  *
  * @param[in,out] num           Указатель на число для модификации.
@@ -84,6 +242,1099 @@ typedef enum {
  */
 bignum_shift_right_status_t bignum_shift_right(bignum_t* restrict num, size_t shift_amount);
 
+/**
+ * @brief      Логический сдвиг вправо без проверок аргументов и без кода возврата.
+ *
+ * @details
+ *   Для горячих циклов с заведомо корректными аргументами: нет проверки NULL,
+ *   быстрых выходов при `len == 0` и `shift_amount == 0`, статус не
+ *   возвращается. Результат совпадает с `bignum_shift_right`, включая
+ *   нормализацию и обнуление освободившихся слов; `len == 0` и
+ *   `shift_amount == 0` допустимы, но обрабатываются общим путем.
+ *
+ *   **Предусловия:** `num != NULL`, `num->len <= BIGNUM_CAPACITY`, число
+ *   нормализовано (`len == 0` или `words[len - 1] != 0`). Нарушение — UB.
+ *   При `BIGNUM_SHIFT_RIGHT_DEBUG` (по умолчанию в `make CONFIG=debug`)
+ *   предусловия проверяются `assert` в вызывающем коде и `ud2` в библиотеке.
+ *
+ * @param[in,out] num           Указатель на число для модификации.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ */
+void bignum_shift_right_unchecked(bignum_t* restrict num, size_t shift_amount);
+
+#ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+#  include <assert.h>
+/** @brief Проверка предусловий bignum_shift_right_unchecked (только при BIGNUM_SHIFT_RIGHT_DEBUG). */
+static inline void bignum_shift_right_unchecked_debug(bignum_t* restrict num, size_t shift_amount) {
+    assert(num != NULL && "bignum_shift_right_unchecked: num is NULL");
+    assert(num->len <= BIGNUM_CAPACITY && "bignum_shift_right_unchecked: len > BIGNUM_CAPACITY");
+    assert((num->len == 0 || num->words[num->len - 1] != 0) && "bignum_shift_right_unchecked: num is not normalized");
+    (bignum_shift_right_unchecked)(num, shift_amount);
+}
+#  define bignum_shift_right_unchecked(num, shift_amount) \
+    bignum_shift_right_unchecked_debug((num), (shift_amount))
+#endif
+
+/**
+ * @brief      Сдвиг вправо на 1..63 бит без разбора сдвига на слова и биты.
+ *
+ * @details
+ *   Для вызывающего кода, который знает, что `word_shift == 0`: нет проверок
+ *   `shift == 0`, полного сдвига, переноса и обнуления слов — сразу ядро
+ *   побитового сдвига на месте и нормализация. Результат и коды возврата
+ *   совпадают с `bignum_shift_right(num, bits)`.
+ *
+ *   **Предусловие:** `1 <= bits <= 63`, иначе результат не определен
+ *   (при `BIGNUM_SHIFT_RIGHT_DEBUG` — `ud2`).
+ *
+ * @param[in,out] num   Указатель на число для модификации.
+ * @param[in]     bits  Количество бит для сдвига, 1..63.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ */
+bignum_shift_right_status_t bignum_shift_right_bits_only(bignum_t* restrict num, size_t bits);
+
+/**
+ * @brief      Сдвиг вправо на целое число слов без разбора сдвига на слова и биты.
+ *
+ * @details
+ *   Для вызывающего кода, который знает, что `bit_shift == 0`: без маски и
+ *   ядра побитового сдвига — только перенос и обнуление слов (или полное
+ *   обнуление при `shift_amount / 64 >= len`). Результат и коды возврата
+ *   совпадают с `bignum_shift_right(num, shift_amount)`; `shift_amount == 0`
+ *   допустим, но идет общим путем (перенос слов на место).
+ *
+ *   **Предусловие:** `shift_amount % 64 == 0`, иначе результат не определен
+ *   (при `BIGNUM_SHIFT_RIGHT_DEBUG` — `ud2`).
+ *
+ * @param[in,out] num           Указатель на число для модификации.
+ * @param[in]     shift_amount  Количество бит для сдвига, кратное 64.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ */
+bignum_shift_right_status_t bignum_shift_right_words_only(bignum_t* restrict num, size_t shift_amount);
+
+/**
+ * @brief      Сдвигает `num` вправо на `amount` бит, где `amount` — число `bignum_t`.
+ *
+ * @details
+ *   Для вызывающего кода, у которого величина сдвига сама является большим
+ *   числом (например, разность экспонент): сводить ее к `size_t` и проверять
+ *   диапазон не нужно. `amount->len > 1` означает сдвиг не меньше 2^64 бит,
+ *   что больше длины любого числа, поэтому результат сразу насыщается до 0
+ *   (проверка за O(1), без разбора `amount`). Остальные величины дают тот же
+ *   результат, что `bignum_shift_right(num, amount->words[0])`.
+ *
+ * @param[in,out] num     Указатель на число для модификации.
+ * @param[in]     amount  Указатель на нормализованную величину сдвига в битах;
+ *                        может совпадать с `num` (читается до сдвига).
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`;
+ *             `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1), если `num` или `amount` равен NULL.
+ */
+bignum_shift_right_status_t bignum_shift_right_by(bignum_t* num, const bignum_t* amount);
+
+/**
+ * @brief      `bignum_shift_right_by`, при насыщении без очистки слов.
+ *
+ * @details
+ *   Если сдвиг не меньше `len * 64` бит, записывается только `len = 0`, без
+ *   обнуления `len` слов, — O(1) при любой длине числа. Слова с номерами
+ *   `>= len` после такого вызова не определены, поэтому функция для
+ *   вызывающих, которые не читают слова за `len`; код, сравнивающий все
+ *   `BIGNUM_CAPACITY` слов или рассчитывающий на нулевой хвост, к результату
+ *   не применим (см. `bignum_shift_right_nz`). Остальные сдвиги выполняются
+ *   как `bignum_shift_right_nz(num, amount->words[0])`.
+ *
+ * @param[in,out] num     Указатель на число для модификации.
+ * @param[in]     amount  Указатель на нормализованную величину сдвига в битах.
+ *
+ * @return     Коды те же, что у `bignum_shift_right_by`.
+ */
+bignum_shift_right_status_t bignum_shift_right_by_nz(bignum_t* num, const bignum_t* amount);
+
+/**
+ * @brief      Логический сдвиг вправо в режиме «грязного хвоста» (входы `_nz`).
+ *
+ * @details
+ *   Инвариант библиотеки — слова с номерами `>= len` равны нулю. Входы `_nz`
+ *   (`bignum_shift_right_nz`, `bignum_shift_right_to_nz`,
+ *   `bignum_shift_right_by_nz`) его не поддерживают: после них эти слова не
+ *   определены. Освободившиеся `shift_amount / 64` слов не обнуляются, при
+ *   полном сдвиге записывается только `len = 0`, а `_to_nz` не трогает
+ *   `dst->words[len .. BIGNUM_CAPACITY)`. Нормализация опирается только на
+ *   `len`: проверяется `words[len - 1]`, которое записано ядром. Результат
+ *   `words[0 .. len)` и коды возврата совпадают с `bignum_shift_right`.
+ *
+ *   Совместимость:
+ *   - все функции этой библиотеки читают только `words[0 .. len)` и
+ *     принимают числа с грязным хвостом (`bignum_shift_right_ct` сам обнуляет
+ *     хвост перед сдвигом); функции без `_nz` хвост не восстанавливают;
+ *   - функции bignum-common и любой код, рассчитывающий на нулевой хвост
+ *     (сравнение или сложение по всем `BIGNUM_CAPACITY` словам, `memcmp`
+ *     структур), должны получать число только после
+ *     `bignum_shift_right_clear_tail`.
+ *
+ * @param[in,out] num           Указатель на число для модификации.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ */
+bignum_shift_right_status_t bignum_shift_right_nz(bignum_t* restrict num, size_t shift_amount);
+
+/**
+ * @brief      `bignum_shift_right_to` в режиме «грязного хвоста».
+ *
+ * @details
+ *   Записывает только `len - shift_amount / 64` слов результата и `len`;
+ *   `dst->words[dst->len .. BIGNUM_CAPACITY)` не определены (см.
+ *   `bignum_shift_right_nz`). Время не зависит от `BIGNUM_CAPACITY`.
+ *   `dst == src` — сдвиг на месте, как `bignum_shift_right_nz`.
+ *
+ * @param[out] dst           Указатель на результат (может быть неинициализирован).
+ * @param[in]  src           Указатель на исходное число.
+ * @param[in]  shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     Коды те же, что у `bignum_shift_right_to`.
+ */
+bignum_shift_right_status_t bignum_shift_right_to_nz(bignum_t* dst, const bignum_t* src,
+                                                     size_t shift_amount);
+
+/**
+ * @brief      Восстанавливает инвариант нулевого хвоста после входов `_nz`.
+ * @details    Обнуляет `words[len .. BIGNUM_CAPACITY)`; `len` и значение не меняются.
+ * @param[in,out] num  Указатель на число; NULL игнорируется.
+ */
+static inline void bignum_shift_right_clear_tail(bignum_t* num) {
+    if (!num) return;
+    for (size_t i = num->len; i < BIGNUM_CAPACITY; ++i) num->words[i] = 0;
+}
+
+/**
+ * @brief      Выполняет арифметический (с сохранением знака) сдвиг вправо.
+ *
+ * @details
+ *   Число трактуется как значение в дополнительном коде шириной `len * 64` бит:
+ *   знак — старший бит `words[len - 1]`. Результат равен `floor(num / 2^k)`;
+ *   освобождающиеся старшие биты заполняются знаком. Представление результата
+ *   минимально: старшее слово отбрасывается, если оно состоит только из знака
+ *   и бит 63 слова под ним совпадает со знаком; слова выше `len` обнуляются
+ *   (знаковое расширение за `len` подразумевается). 0 хранится как `len = 0`,
+ *   -1 — как `{~0, len = 1}`.
+ *
+ *   Сдвиг выполняется тем же однопроходным ядром, что и `bignum_shift_right`,
+ *   без обходного пути через отрицание. Предполагается, что входное
+ *   представление минимально (тогда нормализация занимает O(1)).
+ *
+ * @param[in,out] num           Указатель на число в дополнительном коде.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – остался только знак: результат 0 или -1.
+ */
+bignum_shift_right_status_t bignum_shift_right_arith(bignum_t* restrict num, size_t shift_amount);
+
+/**
+ * @brief      Сдвигает число вправо на `s` бит, а при отрицательном `s` — влево на `-s`.
+ *
+ * @details
+ *   Единая точка входа для кода, в котором направление сдвига определяется
+ *   знаком величины. `s >= 0` — это `bignum_shift_right(num, s)`.
+ *   При `s < 0` выполняется логический сдвиг влево тем же приемом масок
+ *   (rol/and), что и у скалярного ядра сдвига вправо: один проход сверху
+ *   вниз, младшие `-s / 64` слов обнуляются. Если результат не помещается
+ *   в `BIGNUM_CAPACITY` слов, число не изменяется.
+ *
+ * @param[in,out] num  Указатель на число для модификации.
+ * @param[in]     s    Величина сдвига: > 0 — вправо, < 0 — влево.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – (только `s > 0`) все значащие биты потеряны.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW` (-3) – (только `s < 0`) значащие биты
+ *     вышли бы за `BIGNUM_CAPACITY`; число не изменено.
+ */
+bignum_shift_right_status_t bignum_shift_right_signed(bignum_t* restrict num, ptrdiff_t s);
+
+/**
+ * @brief      Логический сдвиг вправо за постоянное время (для секретных данных).
+ *
+ * @details
+ *   Результат тот же, что у `bignum_shift_right`, но время выполнения и
+ *   адреса обращений к памяти не зависят ни от `shift_amount`, ни от `len`:
+ *   всегда обрабатываются все `BIGNUM_CAPACITY` слов, сдвиг по словам
+ *   выполняется `ceil(log2(BIGNUM_CAPACITY))` ступенями с условными
+ *   пересылками (cmov), сдвиг по битам — без `shrd` и без ветки для
+ *   `bit_shift == 0`. Слова выше `len` считаются нулевыми (и обнуляются);
+ *   `len` результата всегда нормализован. Проверка: `make test_dudect`.
+ *
+ * @param[in,out] num           Указатель на число.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо (может быть секретным).
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все значащие биты были потеряны.
+ */
+bignum_shift_right_status_t bignum_shift_right_ct(bignum_t* num, size_t shift_amount);
+
+/**
+ * @brief      Записывает в `dst` результат логического сдвига `src` вправо.
+ *
+ * @details
+ *   Эквивалентно `*dst = *src; bignum_shift_right(dst, shift_amount)`, но без
+ *   промежуточной копии: из `src` читаются только слова, попадающие в результат,
+ *   а каждое слово `dst` записывается ровно один раз (значащие слова, затем нули
+ *   до `BIGNUM_CAPACITY`). Поэтому `dst` может быть неинициализирован.
+ *
+ * @param[out] dst           Указатель на результат. Может совпадать с `src`
+ *                           (тогда выполняется сдвиг на месте), но не должен
+ *                           перекрываться с ним частично.
+ * @param[in]  src           Указатель на исходное число; при `dst != src` не изменяется.
+ * @param[in]  shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `dst` или `src` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все значащие биты `src` были потеряны,
+ *     `dst` равен 0.
+ */
+bignum_shift_right_status_t bignum_shift_right_to(bignum_t* dst, const bignum_t* src,
+                                                  size_t shift_amount);
+
+/**
+ * @brief      Выполняет логический сдвиг вправо числа во внешнем буфере.
+ *
+ * @details
+ *   Тот же однопроходный сдвиг, что и `bignum_shift_right` (те же ядра и
+ *   выбор по CPU), но над `view->words` любой длины: длина не ограничена
+ *   ни `BIGNUM_CAPACITY`, ни 32 битами. Освободившиеся старшие слова
+ *   `[new_len, len)` обнуляются; слова `[len, cap)` не изменяются.
+ *   Память не выделяется.
+ *
+ * @param[in,out] view          Указатель на представление числа.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `view` равен NULL либо
+ *     `view->words` равен NULL при `len > 0`.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все значащие биты были потеряны.
+ */
+bignum_shift_right_status_t bignum_shift_right_view(bignum_view_t* restrict view, size_t shift_amount);
+
+/** Наибольшее число потоков bignum_shift_right_view_parallel (включая вызывающий). */
+#define BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS 64
+/** Меньшие числа (слов после сдвига по словам) сдвигаются в одном потоке. */
+#define BIGNUM_SHIFT_RIGHT_PARALLEL_MIN_WORDS 16384
+
+/**
+ * @brief      Многопоточный логический сдвиг вправо числа во внешнем буфере.
+ *
+ * @details
+ *   Результат тот же, что у `bignum_shift_right_view`. Слова результата
+ *   делятся на отрезки, кратные строке кэша, и сдвигаются потоками
+ *   постоянного пула (создается при первом вызове). При сдвиге на месте
+ *   отрезок читает слова из области записи соседа; такие граничные слова
+ *   копируются заранее (при `word_shift <= 32768`), иначе сдвиг идет
+ *   раундами по `word_shift` слов, внутри которых чтение и запись не
+ *   пересекаются.
+ *
+ *   Числа короче `BIGNUM_SHIFT_RIGHT_PARALLEL_MIN_WORDS` слов, `nthreads == 1`
+ *   и вызовы, пришедшие, пока пул занят другим потоком, выполняются
+ *   однопоточным `bignum_shift_right_view`. Функция потокобезопасна для
+ *   разных `view`.
+ *
+ * @param[in,out] view          Указатель на представление числа.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ * @param[in]     nthreads      Число потоков, включая вызывающий; 0 — по числу
+ *                              процессоров. Не больше
+ *                              `BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS`.
+ *
+ * @return     Те же коды, что у `bignum_shift_right_view`.
+ */
+bignum_shift_right_status_t bignum_shift_right_view_parallel(bignum_view_t* view, size_t shift_amount,
+                                                            unsigned nthreads);
+
+/**
+ * @brief      Записывает в `dst` биты `[lo, lo + width)` числа `src`.
+ *
+ * @details
+ *   Эквивалентно `bignum_shift_right_to(dst, src, lo)` с последующим
+ *   маскированием до `width` бит, но из `src` читаются только
+ *   `ceil(width / 64) + 1` слов, начиная с `words[lo / 64]` (не дальше `len`),
+ *   а результат собирается тем же однопроходным ядром сдвига. Слова `dst`
+ *   выше окна обнуляются до `BIGNUM_CAPACITY`, поэтому `dst` может быть
+ *   неинициализирован. Для окон до 64 бит см. `bignum_shift_right_extract_u64`.
+ *
+ * @param[out] dst    Указатель на результат. Может совпадать с `src`, но не
+ *                    должен перекрываться с ним частично.
+ * @param[in]  src    Указатель на исходное число; при `dst != src` не изменяется.
+ * @param[in]  lo     Номер младшего бита окна.
+ * @param[in]  width  Ширина окна в битах.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – в окне есть ненулевые биты.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `dst` или `src` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все биты окна нулевые, `dst` равен 0.
+ */
+bignum_shift_right_status_t bignum_shift_right_extract_bits(bignum_t* dst, const bignum_t* src,
+                                                            size_t lo, size_t width);
+
+/**
+ * @brief      Записывает `src >> k` в `out` как big-endian число из `out_len` байт.
+ *
+ * @details
+ *   Формат совпадает с `mbedtls_mpi_write_binary` / `BN_bn2binpad`: старший
+ *   байт первым, слева дополнение нулями до ровно `out_len` байт. Слова
+ *   результата вычисляются из `src` на лету и сразу пишутся в `out` с
+ *   перестановкой байт, поэтому `src` не изменяется, а промежуточный
+ *   `bignum_t` (копия + сдвиг + экспорт) не нужен.
+ *
+ * @param[in]  src           Указатель на исходное число (не изменяется).
+ * @param[in]  shift_amount  Количество бит для сдвига вправо (k).
+ * @param[out] out           Буфер результата; может быть NULL при `out_len == 0`.
+ * @param[in]  out_len       Размер `out` в байтах.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – результат записан (в т.ч. `src == 0`).
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `src` равен NULL или `out`
+ *     равен NULL при `out_len > 0`.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все значащие биты `src` ушли, `out`
+ *     заполнен нулями.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW` (-3) – значащих байт результата
+ *     больше `out_len`; `out` не изменен.
+ */
+bignum_shift_right_status_t bignum_shift_right_export_be(const bignum_t* src, size_t shift_amount,
+                                                         uint8_t* out, size_t out_len);
+
+/**
+ * @brief      Сдвигает `num` вправо и сохраняет выпавшие биты в `rem`.
+ *
+ * @details
+ *   За один вызов вычисляет частное и остаток от деления на 2^k:
+ *   `rem = num mod 2^k`, затем `num = num >> k`. В `rem` копируются только
+ *   `ceil(k / 64)` младших слов (не больше `len`), неполное слово маскируется,
+ *   остальные слова `rem` обнуляются до `BIGNUM_CAPACITY`. Поэтому `rem` может
+ *   быть неинициализирован.
+ *
+ * @param[in,out] num           Указатель на число для сдвига.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо (k).
+ * @param[out]    rem           Указатель на остаток. Не должен совпадать с `num`.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` или `rem` равен NULL;
+ *     ничего не изменено.
+ */
+bignum_shift_right_status_t bignum_shift_right_rem(bignum_t* restrict num, size_t shift_amount,
+                                                   bignum_t* restrict rem);
+
+/**
+ * @brief      Сдвигает `num` вправо и возвращает старшие выпавшие биты с sticky-битом.
+ *
+ * @details
+ *   В `*dropped` записываются биты `[k - 64, k)` исходного числа, выровненные
+ *   влево: бит 63 — последний выпавший бит (k - 1). Если выпало больше 64 бит
+ *   и хотя бы один из более младших ненулевой, в бит 0 добавляется 1 (sticky).
+ *   Этого достаточно для любого режима округления результата:
+ *   - `*dropped == 0` – сдвиг точный;
+ *   - `*dropped == 1ULL << 63` – ровно половина младшего разряда результата;
+ *   - `*dropped > 1ULL << 63` – больше половины.
+ *   Читаются только `words[0 .. k / 64]`, дополнительного прохода нет.
+ *
+ * @param[in,out] num           Указатель на число для сдвига.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо (k).
+ * @param[out]    dropped       Указатель на выпавшие биты.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` или `dropped` равен NULL;
+ *     ничего не изменено.
+ */
+bignum_shift_right_status_t bignum_shift_right_sticky(bignum_t* restrict num, size_t shift_amount,
+                                                      uint64_t* restrict dropped);
+
+/**
+ * @brief      Сдвигает `num` вправо на число его младших нулевых бит.
+ *
+ * @details
+ *   Делает `num` нечетным: `num = num >> ctz(num)`, `*shifted_out = ctz(num)`.
+ *   Младшие слова просматриваются один раз (tzcnt по словам) — сразу за ними
+ *   выполняется тот же однопроходный сдвиг, что в `bignum_shift_right`.
+ *   Для бинарного НОД и разложения `n - 1 = d * 2^s` в тесте Миллера — Рабина.
+ *   Нечетное число не переписывается.
+ *
+ * @param[in,out] num          Указатель на число для сдвига.
+ * @param[out]    shifted_out  Величина выполненного сдвига в битах.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен, `num` нечетно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` или `shifted_out` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – `num == 0`: `len = 0`, `*shifted_out = 0`.
+ */
+bignum_shift_right_status_t bignum_shift_right_ctz(bignum_t* restrict num, size_t* restrict shifted_out);
+
+/**
+ * @brief      Сдвигает `num` вправо с округлением результата.
+ *
+ * @details
+ *   Вычисляет `num / 2^k`, округленное в режиме `mode`. Бит округления
+ *   (последний выпавший) и sticky-бит (OR более младших выпавших) вычисляются
+ *   по отбрасываемым словам, которые сам сдвиг не читает, затем к результату
+ *   при необходимости прибавляется 1. Отдельного прохода по исходному числу
+ *   нет. Результат не больше исходного числа, поэтому емкость не превышается.
+ *
+ * @param[in,out] num           Указатель на число для сдвига.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо (k).
+ * @param[in]     mode          Режим округления `bignum_shift_right_round_t`.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен успешно.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `num` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все значащие биты потеряны и округление
+ *     дало 0.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED` (-2) – неизвестный `mode`; число не изменено.
+ */
+bignum_shift_right_status_t bignum_shift_right_round(bignum_t* restrict num, size_t shift_amount,
+                                                     bignum_shift_right_round_t mode);
+
+/**
+ * @brief      Выполняет логический сдвиг вправо для массива чисел, у каждого свой сдвиг.
+ *
+ * @details
+ *   Эквивалентно циклу `statuses[i] = bignum_shift_right(&nums[i], shifts[i])`,
+ *   но проверка аргументов выполняется один раз на весь пакет, а все строки
+ *   кэша элемента `i + 2` (слова и `len`) предзагружаются до обработки элемента `i`.
+ *
+ * @param[in,out] nums      Массив из `count` чисел, расположенных подряд.
+ * @param[in]     shifts    Массив из `count` величин сдвига.
+ * @param[in]     count     Количество элементов. При 0 функция ничего не делает.
+ * @param[out]    statuses  Массив из `count` статусов (`SUCCESS` или `ZEROED`
+ *                          для каждого элемента) или NULL, если они не нужны.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – пакет обработан.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `nums` или `shifts` равен NULL
+ *     при `count > 0`; числа не изменены.
+ */
+bignum_shift_right_status_t bignum_shift_right_batch(bignum_t* restrict nums,
+                                                     const size_t* restrict shifts,
+                                                     size_t count,
+                                                     bignum_shift_right_status_t* restrict statuses);
+
+/**
+ * @brief      Выполняет логический сдвиг вправо для массива чисел на одну величину.
+ *
+ * @details
+ *   Эквивалентно циклу `statuses[i] = bignum_shift_right(&nums[i], shift_amount)`.
+ *   Разбор сдвига на `word_shift`, `bit_shift` и маску выполняется один раз
+ *   на весь пакет. Предвыборка — как в `bignum_shift_right_batch`.
+ *
+ * @param[in,out] nums          Массив из `count` чисел, расположенных подряд.
+ * @param[in]     shift_amount  Количество бит для сдвига каждого числа.
+ * @param[in]     count         Количество элементов. При 0 функция ничего не делает.
+ * @param[out]    statuses      Массив из `count` статусов или NULL.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – пакет обработан.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `nums` равен NULL при `count > 0`.
+ */
+bignum_shift_right_status_t bignum_shift_right_batch_uniform(bignum_t* restrict nums,
+                                                             size_t shift_amount,
+                                                             size_t count,
+                                                             bignum_shift_right_status_t* restrict statuses);
+
+/**
+ * @brief      Выполняет логический сдвиг вправо на одну величину для чисел по массиву указателей.
+ *
+ * @details
+ *   То же, что `bignum_shift_right_batch_uniform`, но числа не обязаны идти
+ *   подряд — например, слоты `bignum_pool_t`. Все строки кэша числа элемента
+ *   `i + 2` предзагружаются до обработки элемента `i`.
+ *
+ * @param[in]     nums          Массив из `count` указателей; разные элементы
+ *                              не должны указывать на одно число.
+ * @param[in]     shift_amount  Количество бит для сдвига каждого числа.
+ * @param[in]     count         Количество элементов. При 0 функция ничего не делает.
+ * @param[out]    statuses      Массив из `count` статусов или NULL; элемент NULL
+ *                              получает `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG`.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – пакет обработан.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `nums` равен NULL при `count > 0`.
+ */
+bignum_shift_right_status_t bignum_shift_right_batch_ptr(bignum_t* const* restrict nums,
+                                                         size_t shift_amount,
+                                                         size_t count,
+                                                         bignum_shift_right_status_t* restrict statuses);
+
+/**
+ * @brief      Сдвигает вправо на одну величину все числа пакета SoA.
+ *
+ * @details
+ *   Для каждого числа результат совпадает с `bignum_shift_right`, но векторы
+ *   идут поперек чисел: строка слов `i` вычисляется из строк `i + word_shift`
+ *   и `i + word_shift + 1` по 8 (AVX-512F) или 4 (AVX2) числа за инструкцию,
+ *   ядро выбирается так же, как для `bignum_shift_right`. Освободившиеся
+ *   строки обнуляются, `len` уменьшается до старшей ненулевой строки;
+ *   длины отдельных чисел нормализует `bignum_shift_right_soa_unpack`.
+ *
+ * @param[in,out] soa           Указатель на пакет.
+ * @param[in]     shift_amount  Количество бит для сдвига каждого числа.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – сдвиг выполнен (или пакет пуст, или сдвиг 0).
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `soa` или `soa->words` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ZEROED` (1) – все числа пакета стали нулевыми, `len = 0`.
+ */
+bignum_shift_right_status_t bignum_shift_right_soa(bignum_soa_t* soa, size_t shift_amount);
+
+/**
+ * @brief      Переводит массив `bignum_t` в пакет SoA.
+ *
+ * @details
+ *   Устанавливает `soa->count = count` и `soa->len` = максимум длин чисел;
+ *   слова выше длины числа заполняются нулями.
+ *
+ * @param[out] soa    Пакет; `soa->words` должен вмещать `count * BIGNUM_CAPACITY` слов.
+ * @param[in]  nums   Массив из `count` чисел, расположенных подряд.
+ * @param[in]  count  Количество чисел.
+ *
+ * @return     `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) или `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1),
+ *             если `soa` равен NULL либо `nums` или `soa->words` равен NULL при `count > 0`.
+ */
+bignum_shift_right_status_t bignum_shift_right_soa_pack(bignum_soa_t* restrict soa,
+                                                        const bignum_t* restrict nums, size_t count);
+
+/**
+ * @brief      Переводит пакет SoA обратно в массив `bignum_t`.
+ *
+ * @details
+ *   Длина каждого числа нормализуется отдельно, слова выше нее до
+ *   `BIGNUM_CAPACITY` обнуляются.
+ *
+ * @param[out] nums  Массив из `soa->count` чисел.
+ * @param[in]  soa   Указатель на пакет.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – числа записаны.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `nums`, `soa` или `soa->words` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW` (-3) – `soa->len > BIGNUM_CAPACITY`; `nums` не изменены.
+ */
+bignum_shift_right_status_t bignum_shift_right_soa_unpack(bignum_t* restrict nums,
+                                                          const bignum_soa_t* restrict soa);
+
+/**
+ * @brief      Возвращает активное ядро побитового сдвига.
+ * @details    Если ядро еще не выбрано, выбирает лучшее для текущего CPU.
+ * @return     Одно из значений `bignum_shift_right_kernel_t`, кроме `AUTO`.
+ */
+bignum_shift_right_kernel_t bignum_shift_right_get_kernel(void);
+
+/**
+ * @brief      Принудительно выбирает ядро побитового сдвига.
+ *
+ * @details
+ *   Предназначена для тестов и бенчмарков. Выбор действует на весь процесс;
+ *   вызов параллельно со сдвигами безопасен (каждый сдвиг выполняется
+ *   целиком либо старым, либо новым ядром), но сам выбор не синхронизирован
+ *   с другими вызовами set_kernel.
+ *
+ * @param[in]  kernel  Ядро или `BIGNUM_SHIFT_RIGHT_KERNEL_AUTO` для автоматического выбора.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – ядро выбрано.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED` (-2) – ядро не поддерживается;
+ *     активное ядро не изменилось.
+ */
+bignum_shift_right_status_t bignum_shift_right_set_kernel(bignum_shift_right_kernel_t kernel);
+
+/** Потоковые записи выключены (порог по умолчанию). */
+#define BIGNUM_SHIFT_RIGHT_STREAM_OFF SIZE_MAX
+/**
+ * Рекомендуемый порог, слов результата (2 МиБ — больше L2 и доли L3 одного
+ * ядра), если результат читается позже или другим ядром.
+ */
+#define BIGNUM_SHIFT_RIGHT_STREAM_RECOMMENDED_WORDS 262144
+
+/**
+ * @brief      Задает порог, с которого сдвиги во внешних буферах пишут в обход кэша.
+ *
+ * @details
+ *   `bignum_shift_right_view` и `bignum_shift_right_view_parallel` (для
+ *   каждого отрезка) при `min_words` и более словах результата выполняют
+ *   побитовый сдвиг потоковым ядром: записи `movntdq`/`movnti`, предвыборка
+ *   источника `prefetchnta`, `sfence` в конце. Результат не вытесняет рабочий
+ *   набор вызывающего кода из L2/L3; выгодно, если результат читается не
+ *   сразу или другим ядром; если результат сразу читается тем же ядром и
+ *   помещается в L3, обычные записи быстрее, поэтому по умолчанию режим
+ *   выключен. На `bignum_t` порог не влияет. Действует на весь процесс; как
+ *   и `set_kernel`, не синхронизирован с другими вызовами.
+ *
+ * @param[in]  min_words  Порог в словах (например,
+ *                        `BIGNUM_SHIFT_RIGHT_STREAM_RECOMMENDED_WORDS`);
+ *                        `BIGNUM_SHIFT_RIGHT_STREAM_OFF` — выключить.
+ *
+ * @return     Предыдущий порог.
+ */
+size_t bignum_shift_right_set_stream_threshold(size_t min_words);
+
+/**
+ * @brief Пути bignum_shift_right, которые различает инструментированная сборка.
+ */
+typedef enum {
+    BIGNUM_SHIFT_RIGHT_PATH_NULL_ARG     = 0, /**< `num == NULL` (.error_null_arg). */
+    BIGNUM_SHIFT_RIGHT_PATH_SUCCESS_ZERO = 1, /**< `len == 0` или `shift == 0`, выход без записи (.success_zero). */
+    BIGNUM_SHIFT_RIGHT_PATH_ZERO_OUT     = 2, /**< `word_shift >= len`, число обнулено (.zero_out). */
+    BIGNUM_SHIFT_RIGHT_PATH_WORD         = 3, /**< Только перенос слов (`bit_shift == 0`). */
+    BIGNUM_SHIFT_RIGHT_PATH_BIT          = 4, /**< Только побитовый сдвиг (`word_shift == 0`). */
+    BIGNUM_SHIFT_RIGHT_PATH_COMBINED     = 5, /**< Перенос слов и побитовый сдвиг за один проход. */
+    BIGNUM_SHIFT_RIGHT_PATH_COUNT        = 6  /**< Число путей (размер массивов статистики). */
+} bignum_shift_right_path_t;
+
+/**
+ * @brief Статистика вызовов bignum_shift_right одного потока.
+ *
+ * @details
+ *   Заполняется только в сборке с `INSTRUMENT=yes` (`-DBIGNUM_SHIFT_RIGHT_INSTRUMENT`
+ *   для C и asm); такты — только с `INSTRUMENT=cycles`. Учитываются только
+ *   вызовы публичной `bignum_shift_right` (в том числе из встраиваемых функций
+ *   заголовка, когда они до нее доходят); пакетные функции, `_to`, `_view`
+ *   и прочие входы не учитываются.
+ */
+typedef struct {
+    uint64_t calls[BIGNUM_SHIFT_RIGHT_PATH_COUNT];  /**< Вызовы по путям. */
+    uint64_t cycles[BIGNUM_SHIFT_RIGHT_PATH_COUNT]; /**< Сумма тактов TSC по путям (0 без INSTRUMENT=cycles). */
+    uint64_t len_hist[BIGNUM_CAPACITY + 1];         /**< Вызовы по исходной `len` (0..BIGNUM_CAPACITY), кроме NULL. */
+} bignum_shift_right_stats_t;
+
+/**
+ * @brief      Копирует статистику bignum_shift_right вызывающего потока.
+ *
+ * @details
+ *   Счетчики хранятся в thread-local памяти и обновляются без атомарных
+ *   операций, поэтому каждый поток читает только свои; для сводки по
+ *   процессу статистику собирает каждый поток.
+ *
+ * @param[out] stats  Статистика; обнуляется, если библиотека собрана без INSTRUMENT.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – статистика скопирована.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `stats` равен NULL.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED` (-2) – библиотека собрана без INSTRUMENT.
+ */
+bignum_shift_right_status_t bignum_shift_right_stats_get(bignum_shift_right_stats_t* stats);
+
+/**
+ * @brief      Обнуляет статистику bignum_shift_right вызывающего потока.
+ */
+void bignum_shift_right_stats_reset(void);
+
+/**
+ * @brief      Формирует профиль для bignum_shift_right_dispatch по статистике.
+ *
+ * @details
+ *   Записывает в `buf` (как `snprintf`) заголовок с определением
+ *   `BIGNUM_SHIFT_RIGHT_PROFILE_ORDER`: классы `BIT` (пути BIT) и `WORD`
+ *   (пути WORD) по убыванию числа вызовов. Класс, вызванный не чаще прочих
+ *   сдвигов (COMBINED и ZERO_OUT), в профиль не попадает: для него проверка
+ *   диспетчера только удлиняет путь. Пути NULL_ARG и SUCCESS_ZERO не
+ *   учитываются. Профиль подключается к сборке вызывающего кода через
+ *   `make PROFILE=<файл>` (`-include`).
+ *
+ * @param[in]  stats  Статистика (обычно из инструментированной сборки на реальной нагрузке).
+ * @param[out] buf    Буфер для текста; может быть NULL при `size == 0`.
+ * @param[in]  size   Размер буфера в байтах.
+ *
+ * @return     Длина текста без завершающего нуля; 0, если `stats` равен NULL.
+ */
+size_t bignum_shift_right_stats_profile(const bignum_shift_right_stats_t* stats, char* buf, size_t size);
+
+/* --- Встраиваемые функции для сдвигов, известных при компиляции --- */
+
+/**
+ * @brief Максимальная длина (в словах), которую bignum_shift_right_bits
+ *        сдвигает встроенным кодом. Замеры `>> 1`: до 8 слов встроенный
+ *        цикл быстрее вызова в ~2 раза, с 16 слов медленнее векторных ядер.
+ */
+#ifndef BIGNUM_SHIFT_RIGHT_INLINE_MAX_LEN
+#  define BIGNUM_SHIFT_RIGHT_INLINE_MAX_LEN 8
+#endif
+
+/**
+ * @brief      Встраиваемый сдвиг вправо на `bits` бит (1..63) без сдвига по словам.
+ *
+ * @details
+ *   Поведение совпадает с `bignum_shift_right(num, bits)`, включая коды
+ *   возврата и нормализацию (проверяется только старшее слово). При
+ *   `bits`, известном на этапе компиляции, компилятор подставляет константы
+ *   сдвигов и может развернуть цикл. Числа длиннее
+ *   `BIGNUM_SHIFT_RIGHT_INLINE_MAX_LEN` слов (где быстрее векторные ядра)
+ *   сдвигаются `bignum_shift_right_bits_only`; при `bits == 0` и `bits >= 64`
+ *   вызывается `bignum_shift_right`.
+ *
+ * @param[in,out] num   Указатель на число для модификации.
+ * @param[in]     bits  Количество бит для сдвига.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ */
+static inline bignum_shift_right_status_t bignum_shift_right_bits(bignum_t* restrict num, size_t bits) {
+    if (bits == 0 || bits >= 64 || !num) {
+        return bignum_shift_right(num, bits);
+    }
+    if (num->len > BIGNUM_SHIFT_RIGHT_INLINE_MAX_LEN) {
+        return bignum_shift_right_bits_only(num, bits);
+    }
+    size_t len = num->len;
+    if (len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    for (size_t i = 0; i + 1 < len; ++i) {
+        num->words[i] = (num->words[i] >> bits) | (num->words[i + 1] << (64 - bits));
+    }
+    num->words[len - 1] >>= bits;
+    if (num->words[len - 1] == 0) --len;
+    num->len = len;
+    return len == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/**
+ * @brief      Встраиваемый сдвиг вправо на 1 бит (деление пополам).
+ * @param[in,out] num  Указатель на число для модификации.
+ * @return     Код состояния, как у `bignum_shift_right(num, 1)`.
+ */
+static inline bignum_shift_right_status_t bignum_shift_right_1(bignum_t* restrict num) {
+    return bignum_shift_right_bits(num, 1);
+}
+
+/**
+ * @brief      Встраиваемый сдвиг вправо на `k` целых слов (`k * 64` бит).
+ *
+ * @details
+ *   Поведение совпадает с `bignum_shift_right(num, k * 64)`: при `k >= len`
+ *   число обнуляется и возвращается `BIGNUM_SHIFT_RIGHT_ZEROED`,
+ *   освободившиеся старшие слова обнуляются.
+ *
+ * @param[in,out] num  Указатель на число для модификации.
+ * @param[in]     k    Количество слов для сдвига.
+ *
+ * @return     Код состояния, как у `bignum_shift_right(num, k * 64)`.
+ */
+static inline bignum_shift_right_status_t bignum_shift_right_words(bignum_t* restrict num, size_t k) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = num->len;
+    if (len == 0 || k == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (k >= len) {
+        for (size_t i = 0; i < len; ++i) num->words[i] = 0;
+        num->len = 0;
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+    size_t n = len - k;
+    for (size_t i = 0; i < n; ++i) num->words[i] = num->words[i + k];
+    for (size_t i = n; i < len; ++i) num->words[i] = 0;
+    if (num->words[n - 1] == 0) --n;
+    num->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/**
+ * @brief      Встраиваемое извлечение битового окна шириной до 64 бит.
+ *
+ * @details
+ *   Возвращает биты `[lo, lo + width)` числа `src`, сдвинутые к нулевому биту.
+ *   Читает не больше двух слов (`words[lo / 64]` и следующее, если оно в
+ *   пределах `len`); биты за `len` считаются нулевыми.
+ *
+ * @param[in] src    Указатель на исходное число.
+ * @param[in] lo     Номер младшего бита окна.
+ * @param[in] width  Ширина окна, 0..64 (большие значения ограничиваются 64).
+ *
+ * @return     Значение окна; 0, если `src` равен NULL.
+ */
+static inline uint64_t bignum_shift_right_extract_u64(const bignum_t* src, size_t lo, size_t width) {
+    size_t ws = lo / 64;
+    unsigned bs = (unsigned)(lo % 64);
+    if (!src || width == 0 || ws >= src->len) return 0;
+    uint64_t v = src->words[ws] >> bs;
+    if (bs != 0 && ws + 1 < src->len) v |= src->words[ws + 1] << (64 - bs);
+    return width < 64 ? v & ((UINT64_C(1) << width) - 1) : v;
+}
+
+/**
+ * @brief      Сдвиг вправо с выбором реализации по величине сдвига.
+ *
+ * @details
+ *   Если `shift` — константа времени компиляции (GCC/Clang, `__builtin_constant_p`),
+ *   сдвиг меньше 64 бит выполняется через `bignum_shift_right_bits`, кратный 64 —
+ *   через `bignum_shift_right_words`; в остальных случаях вызывается
+ *   `bignum_shift_right`. `shift` и `num` вычисляются один раз.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define BIGNUM_SHIFT_RIGHT(num, shift)                                           \
+    (__builtin_constant_p(shift) && (size_t)(shift) < 64                           \
+         ? bignum_shift_right_bits((num), (shift))                                 \
+         : __builtin_constant_p(shift) && (size_t)(shift) % 64 == 0                \
+               ? bignum_shift_right_words((num), (size_t)(shift) / 64)             \
+               : bignum_shift_right((num), (shift)))
+#else
+#  define BIGNUM_SHIFT_RIGHT(num, shift) bignum_shift_right((num), (shift))
+#endif
+
+/* --- Диспетчер по профилю сдвигов --- */
+
+/**
+ * @brief Порядок проверок bignum_shift_right_dispatch: X(BIT) и/или X(WORD).
+ *
+ * @details
+ *   Обычно задается профилем, сформированным bignum_shift_right_stats_profile
+ *   (`make PROFILE=<файл>`). По умолчанию — сначала побитовые сдвиги, затем
+ *   сдвиги на целые слова. Пустой порядок — всегда `bignum_shift_right`.
+ */
+#ifndef BIGNUM_SHIFT_RIGHT_PROFILE_ORDER
+#  define BIGNUM_SHIFT_RIGHT_PROFILE_ORDER(X) X(BIT) X(WORD)
+#endif
+
+#define BIGNUM_SHIFT_RIGHT_DISPATCH_BIT(num, shift)                     \
+    if ((shift) - 1 < 63) return bignum_shift_right_bits_only((num), (shift));
+#define BIGNUM_SHIFT_RIGHT_DISPATCH_WORD(num, shift)                    \
+    if ((shift) % 64 == 0) return bignum_shift_right_words_only((num), (shift));
+#define BIGNUM_SHIFT_RIGHT_DISPATCH_TRY(cls) BIGNUM_SHIFT_RIGHT_DISPATCH_##cls(num, shift)
+
+/**
+ * @brief      Сдвиг вправо через вход для класса сдвига в порядке из профиля.
+ *
+ * @details
+ *   Проверяет классы в порядке `BIGNUM_SHIFT_RIGHT_PROFILE_ORDER` и вызывает
+ *   bignum_shift_right_bits_only (`1 <= shift <= 63`) или
+ *   bignum_shift_right_words_only (`shift % 64 == 0`); остальные сдвиги —
+ *   `bignum_shift_right`. Самый частый класс стоит одно сравнение
+ *   вместо лестницы проверок в начале `bignum_shift_right`. Результат и
+ *   коды возврата совпадают с `bignum_shift_right(num, shift)`.
+ *
+ * @param[in,out] num    Указатель на число для модификации.
+ * @param[in]     shift  Количество бит для сдвига вправо.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`, как у `bignum_shift_right`.
+ */
+static inline bignum_shift_right_status_t bignum_shift_right_dispatch(bignum_t* restrict num, size_t shift) {
+    BIGNUM_SHIFT_RIGHT_PROFILE_ORDER(BIGNUM_SHIFT_RIGHT_DISPATCH_TRY)
+    return bignum_shift_right(num, shift);
+}
+
+/* --- Отложенный сдвиг --- */
+
+/**
+ * @brief  Число с отложенным сдвигом вправо: значение равно `num >> pending`.
+ *
+ * @details
+ *   Цепочка сдвигов (`>> 3`, затем `>> 61`, затем `>> 7`) только складывает
+ *   `pending`; слова переписываются один раз — в `bignum_lazy_materialize`.
+ *   Инициализация: `bignum_lazy_t lz = { num, 0 };`.
+ */
+typedef struct {
+    bignum_t num;       /**< Несдвинутое значение. */
+    size_t   pending;   /**< Накопленный сдвиг в битах (насыщается на SIZE_MAX). */
+} bignum_lazy_t;
+
+/**
+ * @brief      Откладывает сдвиг `lazy` вправо на `shift_amount` бит.
+ *
+ * @details
+ *   Слова не изменяются. Сумма сдвигов насыщается на `SIZE_MAX`: любой
+ *   сдвиг не меньше `BIGNUM_CAPACITY * 64` даёт ноль, так что результат не
+ *   меняется.
+ *
+ * @param[in,out] lazy          Указатель на число с отложенным сдвигом.
+ * @param[in]     shift_amount  Количество бит для сдвига вправо.
+ *
+ * @return     `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) или
+ *             `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1), если `lazy` равен NULL.
+ *             `BIGNUM_SHIFT_RIGHT_ZEROED` возвращает `bignum_lazy_materialize`.
+ */
+static inline bignum_shift_right_status_t bignum_lazy_shift_right(bignum_lazy_t* lazy, size_t shift_amount) {
+    if (!lazy) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    lazy->pending = shift_amount > SIZE_MAX - lazy->pending ? SIZE_MAX : lazy->pending + shift_amount;
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/**
+ * @brief      Применяет накопленный сдвиг одним вызовом `bignum_shift_right`.
+ *
+ * @details
+ *   После вызова `lazy->num` содержит сдвинутое нормализованное значение,
+ *   `lazy->pending == 0`. Без накопленного сдвига слова не переписываются.
+ *
+ * @param[in,out] lazy  Указатель на число с отложенным сдвигом.
+ *
+ * @return     Код состояния, как у `bignum_shift_right(&lazy->num, lazy->pending)`;
+ *             `BIGNUM_SHIFT_RIGHT_SUCCESS`, если сдвига не было.
+ */
+static inline bignum_shift_right_status_t bignum_lazy_materialize(bignum_lazy_t* lazy) {
+    if (!lazy) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (lazy->pending == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    bignum_shift_right_status_t status = bignum_shift_right(&lazy->num, lazy->pending);
+    lazy->pending = 0;
+    return status;
+}
+
+/**
+ * @brief      Возвращает слово `i` значения `num >> pending` без материализации.
+ *
+ * @details
+ *   Читает не больше двух слов `num`; слова за `len` считаются нулевыми.
+ *   Результат совпадает с `words[i]` после `bignum_lazy_materialize`.
+ *
+ * @param[in] lazy  Указатель на число с отложенным сдвигом.
+ * @param[in] i     Номер слова результата.
+ *
+ * @return     Значение слова; 0, если `lazy` равен NULL или слово за пределами числа.
+ */
+static inline uint64_t bignum_lazy_get_word(const bignum_lazy_t* lazy, size_t i) {
+    if (!lazy) return 0;
+    size_t ws = lazy->pending / 64;
+    unsigned bs = (unsigned)(lazy->pending % 64);
+    size_t len = lazy->num.len;
+    if (ws >= len || i >= len - ws) return 0;
+    size_t j = ws + i;
+    uint64_t v = lazy->num.words[j] >> bs;
+    if (bs != 0 && j + 1 < len) v |= lazy->num.words[j + 1] << (64 - bs);
+    return v;
+}
+
+/* --- Пул выровненных чисел --- */
+
+/** Выравнивание слотов пула: строка кэша. */
+#define BIGNUM_POOL_ALIGN 64
+/** Шаг слотов пула: sizeof(bignum_t), округленный вверх до BIGNUM_POOL_ALIGN. */
+#define BIGNUM_POOL_SLOT_SIZE ((sizeof(bignum_t) + BIGNUM_POOL_ALIGN - 1) / BIGNUM_POOL_ALIGN * BIGNUM_POOL_ALIGN)
+
+/**
+ * @brief  Пул чисел фиксированного размера (непрозрачный тип).
+ *
+ * @details
+ *   Каждое число пула начинается с границы строки кэша и занимает
+ *   `BIGNUM_POOL_SLOT_SIZE` байт: в массиве `bignum_t` подряд (шаг
+ *   `BIGNUM_CAPACITY * 8 + 8`) границы строк у каждого элемента свои, и
+ *   запись `len` часто попадает в отдельную строку. Ядра AVX-512 для
+ *   выровненных чисел обрабатывают полные блоки без масок.
+ *
+ *   Пул не потокобезопасен: каждый поток использует свой пул (сдвиги чисел
+ *   из пула, как обычно, безопасны в разных потоках для разных чисел).
+ */
+typedef struct bignum_pool bignum_pool_t;
+
+/**
+ * @brief      Создает пул на `count` чисел.
+ * @param[in]  count  Число слотов (> 0).
+ * @return     Пул или NULL, если `count == 0` или памяти недостаточно.
+ */
+bignum_pool_t* bignum_pool_create(size_t count);
+
+/**
+ * @brief      Освобождает пул вместе со всеми его числами.
+ * @param[in]  pool  Пул или NULL (ничего не делает).
+ */
+void bignum_pool_destroy(bignum_pool_t* pool);
+
+/**
+ * @brief      Выделяет число из пула.
+ * @param[in]  pool  Пул.
+ * @return     Нулевое число (`len == 0`, все слова 0), выровненное на
+ *             `BIGNUM_POOL_ALIGN`; NULL, если `pool` равен NULL или свободных слотов нет.
+ */
+bignum_t* bignum_pool_alloc(bignum_pool_t* pool);
+
+/**
+ * @brief      Возвращает число в пул.
+ * @param[in]  pool  Пул, из которого выделено `num`.
+ * @param[in]  num   Число или NULL (ничего не делает).
+ */
+void bignum_pool_free(bignum_pool_t* pool, bignum_t* num);
+
+/* --- Асинхронные пакеты --- */
+
+/** Пакеты не больше стольких чисел bignum_shift_right_submit выполняет сразу в вызывающем потоке. */
+#define BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX 256
+/** Размер отрезка, на которые делится асинхронный пакет, чисел. */
+#define BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK 512
+
+/**
+ * @brief  Описание пакета для bignum_shift_right_submit.
+ *
+ * @details
+ *   Эквивалентно `bignum_shift_right_batch(nums, shifts, count, statuses)` при
+ *   `shifts != NULL` и `bignum_shift_right_batch_uniform(nums, shift_amount,
+ *   count, statuses)` при `shifts == NULL`.
+ */
+typedef struct {
+    bignum_t*                    nums;          /**< Массив из `count` чисел подряд. */
+    const size_t*                shifts;        /**< Сдвиги элементов или NULL — всем `shift_amount`. */
+    size_t                       shift_amount;  /**< Сдвиг всех чисел при `shifts == NULL`. */
+    size_t                       count;         /**< Количество чисел. */
+    bignum_shift_right_status_t* statuses;      /**< Статусы элементов или NULL. */
+} bignum_shift_right_batch_t;
+
+/**
+ * @brief  Обратный вызов завершения пакета.
+ * @param  batch  Копия описания пакета (действительна только во время вызова).
+ * @param  user   Значение `user`, переданное в bignum_shift_right_submit.
+ */
+typedef void (*bignum_shift_right_complete_t)(const bignum_shift_right_batch_t* batch, void* user);
+
+/** Счетчики асинхронных пакетов (с запуска процесса или bignum_shift_right_async_stats_reset). */
+typedef struct {
+    uint64_t submitted;        /**< Принято пакетов. */
+    uint64_t completed_inline; /**< Выполнено в вызывающем потоке (малые пакеты). */
+    uint64_t completed_async;  /**< Выполнено пулом. */
+    uint64_t chunks;           /**< Отрезков, выполненных потоками пула. */
+    uint64_t chunks_stolen;    /**< Из них взято из чужой очереди. */
+    uint64_t chunks_caller;    /**< Отрезков, выполненных вызывающим потоком при полной очереди. */
+    uint64_t latency_ns_total; /**< Сумма времени от submit до обратного вызова (пул), нс. */
+    uint64_t latency_ns_max;   /**< Наибольшее такое время, нс. */
+    unsigned workers;          /**< Потоков пула (0 — пул еще не запускался). */
+} bignum_shift_right_async_stats_t;
+
+/**
+ * @brief      Выполняет пакет сдвигов асинхронно.
+ *
+ * @details
+ *   Пакет до `BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX` чисел выполняется сразу, и
+ *   `complete` вызывается до возврата. Больший пакет делится на отрезки по
+ *   `BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK` чисел, которые выполняют потоки пула
+ *   (один на CPU, создаются при первом таком пакете; простаивающий поток
+ *   забирает отрезки из очередей других). `complete` вызывается из потока,
+ *   выполнившего последний отрезок (это может быть и вызывающий поток, если
+ *   очередь была полна). Массивы пакета должны оставаться доступными и не
+ *   изменяться другими потоками до обратного вызова.
+ *
+ * @param[in]  batch     Описание пакета (копируется).
+ * @param[in]  complete  Обратный вызов или NULL.
+ * @param[in]  user      Передается в `complete`.
+ *
+ * @return     Код состояния `bignum_shift_right_status_t`.
+ *   - `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) – пакет выполнен или принят.
+ *   - `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1) – `batch` равен NULL или
+ *     `batch->nums` равен NULL при `count > 0`; `complete` не вызывается.
+ */
+bignum_shift_right_status_t bignum_shift_right_submit(const bignum_shift_right_batch_t* batch,
+                                                      bignum_shift_right_complete_t complete, void* user);
+
+/**
+ * @brief      Ждет завершения всех принятых асинхронных пакетов (из любых потоков),
+ *             включая их обратные вызовы.
+ */
+void bignum_shift_right_async_wait(void);
+
+/**
+ * @brief      Копирует счетчики асинхронных пакетов.
+ * @param[out] stats  Куда записать счетчики.
+ * @return     `BIGNUM_SHIFT_RIGHT_SUCCESS` (0) или `BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG` (-1).
+ */
+bignum_shift_right_status_t bignum_shift_right_async_stats_get(bignum_shift_right_async_stats_t* stats);
+
+/** @brief Обнуляет счетчики асинхронных пакетов (кроме `workers`). */
+void bignum_shift_right_async_stats_reset(void);
+
 
 #ifdef __cplusplus
 }
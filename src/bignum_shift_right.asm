@@ -1,8 +1,8 @@
 ; -----------------------------------------------------------------------------
 ; @file    bignum_shift_right.asm
 ; @author  git@bayborodov.com
-; @version 1.0.15
-; @date    27.06.2026
+; @version 1.0.39
+; @date    14.10.2026
 ;
 ; @brief   Низкоуровневая реализация логического сдвига bignum_t вправо.
 ;
@@ -29,16 +29,234 @@
 ;                           - Избавление от медленной инструкции shrd (Microcode Sequencer Bottleneck).
 ;                           - Устранение избыточных чтений памяти (Loop-Carried Dependency).
 ;                           - O(1) Нормализация без цикла и rep stosq (Математический факт).
+;   - rev. 16 (14.10.2026): Пакетный API:
+;                           - Ядро разделено на точки входа .entry (без проверки NULL)
+;                             и .decoded (сдвиг уже разобран, маска в r8).
+;                           - Добавлены bignum_shift_right_batch и
+;                             bignum_shift_right_batch_uniform.
+;   - rev. 17 (14.10.2026): Векторные ядра побитового сдвига:
+;                           - AVX2 (4 слова за итерацию), AVX-512F и AVX-512 VBMI2
+;                             (8 слов за итерацию, хвост через маски k1/k2).
+;                           - Ядро выбирается один раз через CPUID/XGETBV и
+;                             хранится в указателе bit_shift_kernel (.bss).
+;                           - EVEX-инструкции закодированы через db (yasm их не знает).
+;   - rev. 18 (14.10.2026): Сдвиг без копирования (out-of-place):
+;                           - Ядра побитового сдвига переведены на контракт
+;                             (dst = rdi, src = rsi, n = rdx) и вызываются через call
+;                             из bit_shift_words; in-place проход — частный случай dst == src.
+;                           - Добавлен bignum_shift_right_to(dst, src, shift).
+;   - rev. 19 (14.10.2026): Однопроходный сдвиг:
+;                           - При word_shift != 0 и bit_shift != 0 ядро читает
+;                             words[i + word_shift] и words[i + word_shift + 1]
+;                             сразу, без предварительного rep movsq.
+;                           - rep movsq/rep stosq заменены на word_move/word_zero:
+;                             цикл SSE2 до WORD_REP_MIN_LEN слов, rep movsb/stosb (ERMSB)
+;                             только начиная с этого порога (по замерам).
+;   - rev. 20 (14.10.2026): Специализация по емкости:
+;                           - BIGNUM_CAPACITY задается при сборке (-D, Makefile),
+;                             смещения len и размер bignum_t выводятся из нее.
+;                           - При BIGNUM_CAPACITY <= BIT_SHIFT_UNROLL_MAX_CAPACITY
+;                             скалярное ядро полностью развернуто: вход по вычисленному
+;                             адресу, без счетчика цикла.
+;                           - Экспортирована константа bignum_shift_right_capacity.
+;   - rev. 21 (14.10.2026): Сдвиг с сохранением выпавших бит:
+;                           - bignum_shift_right_rem (num mod 2^k в отдельный bignum_t).
+;                           - bignum_shift_right_sticky (старшие 64 выпавших бита
+;                             и sticky-бит для округления).
+;   - rev. 22 (14.10.2026): Арифметический сдвиг bignum_shift_right_arith (дополнительный
+;                           код, знаковая нормализация O(1)) на общих ядрах.
+;   - rev. 23 (14.10.2026): Сдвиг с округлением bignum_shift_right_round (TRUNC, CEIL,
+;                           HALF_UP, HALF_EVEN) поверх bignum_shift_right_sticky.
+;   - rev. 24 (14.10.2026): Извлечение битового окна bignum_shift_right_extract_bits
+;                           (читает только слова окна и одно следующее).
+;   - rev. 25 (14.10.2026): Сдвиг со знаком bignum_shift_right_signed: при s < 0 —
+;                           сдвиг влево (rol/and/xor, контроль переполнения емкости).
+;   - rev. 26 (14.10.2026): Сдвиг чисел во внешних буферах bignum_shift_right_view
+;                           (bignum_view_t, 64-битная длина). Развернутое скалярное
+;                           ядро передает n > BIGNUM_CAPACITY циклу bit_shift_scalar_loop.
+;   - rev. 27 (14.10.2026): Внутренняя точка входа bignum_shift_right_segment (отрезок
+;                           слов с явным соседом) для bignum_shift_right_view_parallel.
+;   - rev. 28 (14.10.2026): Потоковое ядро bit_shift_stream (movntdq/movnti, prefetchnta,
+;                           sfence) для внешних буферов; включается порогом
+;                           bignum_shift_right_set_stream_threshold.
+;   - rev. 29 (14.10.2026): Сдвиг за постоянное время bignum_shift_right_ct (все
+;                           BIGNUM_CAPACITY слов, barrel shifter на cmov, без shrd).
+;   - rev. 30 (14.10.2026): Сдвиг на число младших нулевых бит bignum_shift_right_ctz
+;                           (tzcnt по словам, затем bignum_shift_right.decoded).
+;   - rev. 31 (14.10.2026): Пакетный формат SoA (bignum_soa_t): bignum_shift_right_soa
+;                           (AVX-512F/AVX2 поперек чисел) и pack/unpack из bignum_t[].
+;   - rev. 32 (14.10.2026): Вход без проверок bignum_shift_right_unchecked (void, сразу
+;                           в .decoded); при BIGNUM_SHIFT_RIGHT_DEBUG — ud2 при
+;                           нарушении предусловий.
+;   - rev. 33 (14.10.2026): Инструментированная сборка (-D BIGNUM_SHIFT_RIGHT_INSTRUMENT):
+;                           bignum_shift_right передает len, сдвиг и такты (при
+;                           BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES) в счетчики потока
+;                           bignum_shift_right_stats_record.
+;   - rev. 34 (14.10.2026): Входы для известного класса сдвига без разбора shift:
+;                           bignum_shift_right_bits_only (1..63, сразу bit_shift_words)
+;                           и bignum_shift_right_words_only (кратный 64, сразу word_move).
+;   - rev. 35 (14.10.2026): Выровненные числа (слоты bignum_pool_t):
+;                           - bignum_shift_right_batch_ptr — пакет по массиву указателей.
+;                           - Ядра AVX-512F/VBMI2 при dst и src, выровненных на 64 байта,
+;                             обрабатывают полные блоки без масок (vmovdqa64).
+;   - rev. 36 (14.10.2026): Сериализация bignum_shift_right_export_be: src >> k сразу в
+;                           big-endian байты (bswap), без промежуточного bignum_t.
+;   - rev. 37 (14.10.2026): Сдвиг на число bignum_shift_right_by (насыщение за O(1) при
+;                           amount->len > 1) и bignum_shift_right_by_nz, у которого
+;                           насыщение только записывает len = 0 (.zero_len).
+;   - rev. 38 (14.10.2026): Режим «грязного хвоста»: bignum_shift_right_nz и
+;                           bignum_shift_right_to_nz не обнуляют слова за новым len
+;                           (нет .zero_top, .zero_tail и очистки при полном сдвиге);
+;                           bignum_shift_right_by_nz идет через bignum_shift_right_nz.
+;   - rev. 39 (14.10.2026): Пакетные циклы предзагружают все строки кэша элемента
+;                           (слова и len, PREFETCH_BIGNUM) на BATCH_PREFETCH_AHEAD
+;                           элемента вперед, а не первую строку слов и строку len
+;                           следующего.
 ; -----------------------------------------------------------------------------
 
 section .text
 
 ; --- Публичные символы ---
 global bignum_shift_right
+global bignum_shift_right_unchecked
+global bignum_shift_right_bits_only
+global bignum_shift_right_words_only
+global bignum_shift_right_by
+global bignum_shift_right_by_nz
+global bignum_shift_right_nz
+global bignum_shift_right_to_nz
+global bignum_shift_right_arith
+global bignum_shift_right_signed
+global bignum_shift_right_ct
+global bignum_shift_right_to
+global bignum_shift_right_view
+global bignum_shift_right_segment
+global bignum_shift_right_extract_bits
+global bignum_shift_right_export_be
+global bignum_shift_right_rem
+global bignum_shift_right_sticky
+global bignum_shift_right_ctz
+global bignum_shift_right_round
+global bignum_shift_right_batch
+global bignum_shift_right_batch_uniform
+global bignum_shift_right_batch_ptr
+global bignum_shift_right_soa
+global bignum_shift_right_soa_pack
+global bignum_shift_right_soa_unpack
+global bignum_shift_right_get_kernel
+global bignum_shift_right_set_kernel
+global bignum_shift_right_set_stream_threshold
+global bignum_shift_right_capacity
+
+; --- Емкость (задается при сборке: yasm -D BIGNUM_CAPACITY=N) ---
+; Должна совпадать с BIGNUM_CAPACITY из bignum.h, с которой собирается C-код;
+; см. bignum_shift_right_capacity и проверки в bignum_shift_right.h.
+%ifndef BIGNUM_CAPACITY
+  %define BIGNUM_CAPACITY 32
+%endif
+%if BIGNUM_CAPACITY < 1
+  %error "BIGNUM_CAPACITY must be positive"
+%endif
 
 ; --- Константы ---
 BIGNUM_WORDS_OFFSET equ 0
-BIGNUM_LEN_OFFSET   equ 256
+BIGNUM_LEN_OFFSET   equ BIGNUM_CAPACITY * 8
+BIGNUM_SIZE         equ BIGNUM_CAPACITY * 8 + 8 ; sizeof(bignum_t): слова + len
+
+; Пакетные циклы: на сколько элементов вперед предзагружается число. Через один
+; элемент у предвыборки есть время целого сдвига, а не только его начала.
+BATCH_PREFETCH_AHEAD equ 2
+
+; -----------------------------------------------------------------------------
+; PREFETCH_BIGNUM base: prefetcht0 каждой 64-байтной строки bignum_t по адресу
+; base (BIGNUM_SIZE байт: слова и len). Последний байт — отдельно: число в
+; массиве не выровнено на строку и задевает на одну строку больше.
+; -----------------------------------------------------------------------------
+%macro PREFETCH_BIGNUM 1
+%assign prefetch_off 0
+%rep (BIGNUM_SIZE + 63) / 64
+    prefetcht0 [%1 + prefetch_off]
+%assign prefetch_off prefetch_off + 64
+%endrep
+    prefetcht0 [%1 + BIGNUM_SIZE - 1]
+%endmacro
+
+; Раскладка bignum_view_t { uint64_t* words; size_t len; size_t cap; }
+VIEW_WORDS_OFFSET   equ 0
+VIEW_LEN_OFFSET     equ 8
+VIEW_CAP_OFFSET     equ 16
+
+; Раскладка bignum_soa_t { uint64_t* words; size_t count; size_t len; }
+SOA_WORDS_OFFSET    equ 0
+SOA_COUNT_OFFSET    equ 8
+SOA_LEN_OFFSET      equ 16
+
+; Идентификаторы ядер (bignum_shift_right_kernel_t)
+KERNEL_AUTO         equ 0
+KERNEL_SCALAR       equ 1
+KERNEL_AVX2         equ 2
+KERNEL_AVX512       equ 3
+KERNEL_AVX512_VBMI2 equ 4
+
+; Режимы округления (bignum_shift_right_round_t)
+ROUND_TRUNC         equ 0
+ROUND_CEIL          equ 1
+ROUND_HALF_UP       equ 2
+ROUND_HALF_EVEN     equ 3
+
+; Минимальное число слов результата, с которого побитовый сдвиг
+; передается векторному ядру. Для более коротких чисел накладные
+; расходы на подготовку векторов не окупаются.
+BIT_SHIFT_VECTOR_MIN_LEN equ 8
+
+; Порог (в словах), начиная с которого перенос и обнуление слов выполняются
+; через rep movsb/rep stosb (ERMSB). Замеры (Ice Lake, FSRM): до 64 слов
+; цикл movdqu быстрее в 1.5-5 раз из-за стартовой стоимости rep, с 128 слов
+; rep быстрее в 2-4 раза. При перекрытии src и dst ближе 64 байт rep movsb
+; уходит в медленный микрокод (в 10-40 раз медленнее цикла), поэтому для
+; переноса дополнительно требуется расстояние WORD_REP_MIN_DIST слов.
+WORD_REP_MIN_LEN  equ 128
+WORD_REP_MIN_DIST equ 8
+
+; Максимальная емкость, для которой скалярное ядро разворачивается полностью
+; (BIGNUM_CAPACITY - 1 шагов по BIT_SHIFT_STEP_SIZE байт). Замеры (Ice Lake):
+; при емкости 16 полная развертка в пределах ±1 такта от цикла x4 (выигрыш на
+; длинах с остатком, проигрыш на 1-2 словах из-за вычисления адреса входа);
+; при емкости 32 она медленнее на 3-7% на длинных числах (~1 КБ кода шагов).
+; Для больших емкостей используется цикл с разверткой x4.
+BIT_SHIFT_UNROLL_MAX_CAPACITY equ 16
+BIT_SHIFT_STEP_SIZE           equ 32        ; Размер шага развернутого ядра, байт
+BIT_SHIFT_STEP_SIZE_LOG2      equ 5
+
+; Порог (в словах результата) для потокового ядра bit_shift_stream у сдвигов
+; во внешних буферах (bignum_shift_right_view, _view_parallel). По умолчанию
+; выключено (SIZE_MAX): если результат читается сразу и помещается в L3,
+; обычные записи быстрее (замер, буфер 32 МиБ на месте: в ~4 раза).
+; Включается bignum_shift_right_set_stream_threshold.
+BIT_SHIFT_STREAM_OFF     equ -1
+; Дистанция программной предвыборки источника в потоковом ядре, байт
+; (16 строк кэша: покрывает задержку DRAM при ~1 слове за такт).
+BIT_SHIFT_PREFETCH_DIST  equ 1024
+
+%ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT
+; Счетчики потока (bignum_shift_right_stats.c)
+extern bignum_shift_right_stats_record
+%endif
+
+section .rodata
+align 8
+bignum_shift_right_capacity: dq BIGNUM_CAPACITY ; Емкость, с которой собрана библиотека
+
+section .data
+align 8
+bit_shift_stream_min: dq BIT_SHIFT_STREAM_OFF ; Порог bit_shift_stream, слов
+
+section .bss
+align 8
+bit_shift_kernel:    resq 1                 ; Адрес выбранного ядра (0 — еще не выбрано)
+bit_shift_kernel_id: resd 1                 ; Идентификатор выбранного ядра
+
+section .text
 
 ; =============================================================================
 ; @brief      Выполняет логический сдвиг большого числа вправо.
@@ -46,12 +264,66 @@ BIGNUM_LEN_OFFSET   equ 256
 ; @param      rsi: size_t shift_amount - Количество бит для сдвига.
 ; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG).
 ; @note       Использует ABI System V AMD64.
-; @version    1.0.15
+; @note       Внутренние точки входа (для пакетных функций, через call):
+;             - .entry:   rdi != NULL, rsi = shift_amount.
+;             - .decoded: rdi != NULL, rdx = len (!= 0), r9 = word_shift,
+;                         r11 = bit_shift, r8 = маска старших бит для bit_shift.
+;             Обе портят только caller-saved регистры.
+; @note       При -D BIGNUM_SHIFT_RIGHT_INSTRUMENT публичный вход вызывает сдвиг
+;             (.checked) и передает исходные len и shift_amount (и такты TSC при
+;             BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES) в bignum_shift_right_stats_record.
+;             Внутренние входы .entry и .decoded не учитываются.
+; @version    1.0.33
 ; =============================================================================
 bignum_shift_right:
+%ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    sub     rsp, 8                          ; Выравнивание стека для call
+    mov     r12, rsi                        ; r12 = shift_amount
+    mov     r13, -1                         ; r13 = len (SIZE_MAX, если num == NULL)
+    test    rdi, rdi
+    jz      .instrument_start
+    mov     r13d, [rdi + BIGNUM_LEN_OFFSET]
+
+.instrument_start:
+    xor     r14d, r14d                      ; r14 = такты (0 без _CYCLES)
+%ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES
+    lfence
+    rdtsc
+    shl     rdx, 32
+    or      rax, rdx
+    mov     r14, rax                        ; r14 = TSC до сдвига
+%endif
+    call    .checked
+    mov     rbx, rax                        ; rbx = код возврата
+%ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES
+    rdtscp                                  ; Ждет завершения сдвига
+    shl     rdx, 32
+    or      rax, rdx
+    sub     rax, r14
+    mov     r14, rax                        ; r14 = такты сдвига
+%endif
+    mov     rdi, r13
+    mov     rsi, r12
+    mov     rdx, r14
+    call    bignum_shift_right_stats_record
+    mov     rax, rbx
+    add     rsp, 8
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+.checked:
+%endif
     test    rdi, rdi
     jz      .error_null_arg
 
+.entry:
     mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
     test    edx, edx
     jz      .success_zero                   ; Если len == 0, возвращаем 0
@@ -60,144 +332,438 @@ bignum_shift_right:
     jz      .success_zero                   ; Если shift == 0, возвращаем 0
 
     ; --- Вычисление сдвигов ---
-    mov     r8, rsi
-    shr     r8, 6                           ; r8 = word_shift = shift / 64
-    mov     r11, rsi
-    and     r11, 63                         ; r11 = bit_shift = shift % 64
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift = shift / 64
+    mov     ecx, esi
+    and     ecx, 63
+    mov     r11, rcx                        ; r11 = bit_shift = shift % 64
+
+    ; Подготовка маски для замены медленного shrd
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
 
+.decoded:
     ; --- Проверка на полный сдвиг ---
-    cmp     r8, rdx
+    cmp     r9, rdx
     jae     .zero_out
 
-    ; --- 1. Сдвиг на целые слова ---
-    test    r8, r8
-    jz      .bit_shift_part                 ; Если word_shift == 0, пропускаем
+    lea     rsi, [rdi + r9 * 8]             ; src = num + word_shift
+    sub     rdx, r9                         ; rdx = new_len = len - word_shift
+    test    r11, r11
+    jz      .word_move                      ; bit_shift == 0: только перенос слов
 
-    mov     r9, rdx
-    sub     r9, r8                          ; r9 = new_len = len - word_shift
+    ; --- Однопроходный сдвиг: words[i] = words[i + ws] >> bs | words[i + ws + 1] << (64 - bs) ---
+    mov     rcx, r11                        ; cl = bit_shift
+    call    bit_shift_words
+    jmp     .zero_top
 
-    ; Копируем слова
-    mov     rcx, r9                         ; count = new_len
-    mov     rsi, rdi
-    lea     rsi, [rsi + r8 * 8]             ; src = num + word_shift
+.word_move:
+    call    word_move                       ; words[i] = words[i + word_shift]
+
+.zero_top:
+    ; --- Обнуление освободившихся старших word_shift слов ---
+    mov     ecx, [rdi + BIGNUM_LEN_OFFSET]  ; Старый len еще не перезаписан
+    sub     rcx, rdx                        ; count = word_shift (может быть 0)
     mov     r10, rdi                        ; сохраняем rdi (num)
-    rep movsq                               ; Сдвигаем слова вниз
+    lea     rdi, [rdi + rdx * 8]
+    call    word_zero
+    mov     rdi, r10                        ; восстанавливаем rdi
 
-    ; Обнуляем старшие слова
-    mov     rcx, r8                         ; count = word_shift
+.normalize:
+    ; --- 3. Нормализация длины O(1) ---
+    ; Сдвиг < 64 бит может уменьшить длину нормализованного числа максимум на 1 слово.
+    ; Хвост уже обнулен (word_zero и shr старшего слова в ядре).
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    jne     .set_len
+    dec     rdx
+.set_len:
+    mov     [rdi + BIGNUM_LEN_OFFSET], edx
     xor     eax, eax
-    rep stosq                               ; Обнуляем старшие слова
+    test    edx, edx
+    setz    al                              ; Возвращаем 1 (ZEROED), если len == 0, иначе 0 (SUCCESS)
+    ret
 
-    mov     rdi, r10                        ; восстанавливаем rdi
-    mov     rdx, r9                         ; обновляем len = new_len
+.zero_out:
+    ; --- Полное обнуление числа ---
+    mov     rcx, rdx
+    call    word_zero
 
-.bit_shift_part:
-    ; --- 2. Сдвиг на биты ---
-    test    r11, r11
-    jz      .normalize                      ; Если bit_shift == 0, переходим к нормализации
+.zero_len:
+    ; --- Только len = 0 (слова не очищаются, для входов _nz) ---
+    mov     dword [rdi + BIGNUM_LEN_OFFSET], 0
+    mov     eax, 1                          ; Код возврата: ZEROED
+    ret
 
-    mov     rcx, r11                        ; cl = bit_shift
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
 
-    ; Подготовка маски для замены медленного shrd
+.success_zero:
+    xor     rax, rax                        ; Код возврата: SUCCESS
+    ret
+
+; =============================================================================
+; @brief      Логический сдвиг вправо без проверок аргументов и без кода возврата.
+; @param      rdi: bignum_t* num - Предусловие: не NULL, len <= BIGNUM_CAPACITY,
+;             число нормализовано (len == 0 или words[len - 1] != 0).
+; @param      rsi: size_t shift_amount - Количество бит для сдвига.
+; @return     Нет (rax не определен).
+; @note       Нет проверки NULL и быстрых выходов при len == 0 и shift == 0:
+;             сдвиг сразу разбирается и передается в bignum_shift_right.decoded.
+;             len == 0 и shift == 0 по-прежнему дают верный результат (полное
+;             обнуление нуля и перенос слов на место), просто без экономии.
+; @note       При сборке с -D BIGNUM_SHIFT_RIGHT_DEBUG (CONFIG=debug) нарушение
+;             предусловий останавливает процесс инструкцией ud2 (SIGILL).
+; @version    1.0.32
+; =============================================================================
+bignum_shift_right_unchecked:
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    test    rdi, rdi
+    jz      .precondition_failed
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]
+    cmp     rdx, BIGNUM_CAPACITY
+    ja      .precondition_failed
+    test    edx, edx
+    jz      .decode
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    je      .precondition_failed        ; Ненормализованное число
+.decode:
+%endif
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, esi
+    and     ecx, 63
+    mov     r11, rcx                        ; r11 = bit_shift
     mov     r8, -1
     shr     r8, cl
     not     r8                              ; r8 = маска для старших битов
+    jmp     bignum_shift_right.decoded
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
 
-    mov     r10, rdx
-    dec     r10                             ; r10 = len - 1
-    jz      .bit_shift_last                 ; Если len == 1, сдвигаем только одно слово
+.precondition_failed:
+    ud2
+%endif
 
-    mov     r9, rdi                         ; r9 = num
-    mov     rax, [r9]                       ; Загружаем первое слово до цикла
+; =============================================================================
+; @brief      Сдвиг вправо на 1..63 бит без разбора сдвига.
+; @param      rdi: bignum_t* num - Указатель на bignum_t.
+; @param      rsi: size_t bits - Предусловие: 1 <= bits <= 63.
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       word_shift == 0 < len, поэтому нет проверки полного сдвига, переноса
+;             и обнуления слов: сразу bit_shift_words на месте и нормализация
+;             bignum_shift_right.normalize. Проверки NULL и len == 0 остаются.
+; @note       При -D BIGNUM_SHIFT_RIGHT_DEBUG bits вне 1..63 — ud2.
+; @version    1.0.34
+; =============================================================================
+bignum_shift_right_bits_only:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    lea     rax, [rsi - 1]
+    cmp     rax, 62
+    ja      .precondition_failed
+%endif
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len = new_len
+    test    edx, edx
+    jz      bignum_shift_right.success_zero
+    mov     ecx, esi                        ; cl = bit_shift
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    mov     rsi, rdi                        ; src = dst
+    call    bit_shift_words
+    jmp     bignum_shift_right.normalize
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
 
-    shr     r10, 2                          ; r10 = count / 4
-    jz      .bit_shift_tail_loop            ; Если < 4, идем в хвостовой цикл
+.precondition_failed:
+    ud2
+%endif
 
-.bit_shift_unrolled_loop:
-    ; Итерация 1
-    mov     r11, [r9 + 8]
-    mov     rsi, r11
-    ror     rsi, cl
-    and     rsi, r8
-    shr     rax, cl
-    or      rax, rsi
-    mov     [r9], rax
+; =============================================================================
+; @brief      Сдвиг вправо на целое число слов без разбора сдвига.
+; @param      rdi: bignum_t* num - Указатель на bignum_t.
+; @param      rsi: size_t shift_amount - Предусловие: shift_amount % 64 == 0.
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       bit_shift == 0: без маски и ядра побитового сдвига, сразу
+;             bignum_shift_right.word_move (или .zero_out). shift_amount == 0
+;             проходит тот же путь (перенос слов на место).
+; @note       При -D BIGNUM_SHIFT_RIGHT_DEBUG shift_amount % 64 != 0 — ud2.
+; @version    1.0.34
+; =============================================================================
+bignum_shift_right_words_only:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    test    esi, 63
+    jnz     .precondition_failed
+%endif
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      bignum_shift_right.success_zero
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    cmp     r9, rdx
+    jae     bignum_shift_right.zero_out
+    lea     rsi, [rdi + r9 * 8]             ; src = num + word_shift
+    sub     rdx, r9                         ; rdx = new_len
+    jmp     bignum_shift_right.word_move
+%ifdef BIGNUM_SHIFT_RIGHT_DEBUG
 
-    ; Итерация 2
-    mov     rax, [r9 + 16]
-    mov     rsi, rax
-    ror     rsi, cl
-    and     rsi, r8
-    shr     r11, cl
-    or      r11, rsi
-    mov     [r9 + 8], r11
+.precondition_failed:
+    ud2
+%endif
 
-    ; Итерация 3
-    mov     r11, [r9 + 24]
-    mov     rsi, r11
-    ror     rsi, cl
-    and     rsi, r8
-    shr     rax, cl
-    or      rax, rsi
-    mov     [r9 + 16], rax
+; =============================================================================
+; @brief      Сдвиг вправо на величину, заданную числом bignum_t.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: const bignum_t* amount - Величина сдвига в битах (нормализована).
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       amount->len > 1 означает сдвиг >= 2^64 бит, заведомо больше длины
+;             любого числа: сразу насыщение (.zero_out) без сведения amount к
+;             size_t. При amount->len == 1 — обычный разбор в
+;             bignum_shift_right.entry, amount->len == 0 — сдвиг на 0.
+; @version    1.0.37
+; =============================================================================
+bignum_shift_right_by:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
+    test    rsi, rsi
+    jz      bignum_shift_right.error_null_arg
+    mov     eax, [rsi + BIGNUM_LEN_OFFSET]  ; rax = amount->len
+    cmp     eax, 1
+    jb      bignum_shift_right.success_zero ; amount == 0
+    mov     rsi, [rsi]                      ; rsi = amount->words[0]
+    je      bignum_shift_right.entry        ; amount < 2^64 (mov не меняет флаги)
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      bignum_shift_right.success_zero
+    jmp     bignum_shift_right.zero_out     ; Насыщение: amount >= 2^64
 
-    ; Итерация 4
-    mov     rax, [r9 + 32]
-    mov     rsi, rax
-    ror     rsi, cl
-    and     rsi, r8
-    shr     r11, cl
-    or      r11, rsi
-    mov     [r9 + 24], r11
+; =============================================================================
+; @brief      bignum_shift_right_by без обнуления слов за новым len.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: const bignum_t* amount - Величина сдвига в битах (нормализована).
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       Если сдвиг не меньше len * 64 бит, записывается только len = 0
+;             (bignum_shift_right.zero_len) за O(1): слова с номерами >= len
+;             после вызова не определены. Для вызывающих, которые не читают
+;             слова за len. Остальные сдвиги — bignum_shift_right_nz.
+; @version    1.0.38
+; =============================================================================
+bignum_shift_right_by_nz:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
+    test    rsi, rsi
+    jz      bignum_shift_right.error_null_arg
+    mov     eax, [rsi + BIGNUM_LEN_OFFSET]  ; rax = amount->len
+    cmp     eax, 1
+    jb      bignum_shift_right.success_zero ; amount == 0
+    mov     rsi, [rsi]                      ; rsi = amount->words[0]
+    je      bignum_shift_right_nz.entry     ; amount < 2^64 (mov не меняет флаги)
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      bignum_shift_right.success_zero
+    jmp     bignum_shift_right.zero_len     ; Насыщение: amount >= 2^64
 
-    add     r9, 32
-    dec     r10
-    jnz     .bit_shift_unrolled_loop
+; =============================================================================
+; @brief      Логический сдвиг вправо без обнуления слов за новым len.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига.
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       Режим «грязного хвоста» (входы _nz): слова с номерами >= len после
+;             вызова не определены. Нет word_zero освободившихся word_shift слов
+;             (.zero_top) и очистки при полном сдвиге (сразу .zero_len).
+;             Нормализация та же (bignum_shift_right.normalize): она читает
+;             только words[new_len - 1], записанное ядром.
+; @version    1.0.38
+; =============================================================================
+bignum_shift_right_nz:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
 
-.bit_shift_tail_loop:
-    mov     r10, rdx
-    dec     r10
-    and     r10, 3                          ; r10 = count % 4
-    jz      .bit_shift_last
+.entry:
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      bignum_shift_right.success_zero
+    test    rsi, rsi
+    jz      bignum_shift_right.success_zero
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    cmp     r9, rdx
+    jae     bignum_shift_right.zero_len     ; Полный сдвиг: только len = 0
 
-.bit_shift_tail:
-    mov     r11, [r9 + 8]
-    mov     rsi, r11
-    ror     rsi, cl
-    and     rsi, r8
-    shr     rax, cl
-    or      rax, rsi
-    mov     [r9], rax
-    mov     rax, r11                        ; Переносим старшее слово в младшее для следующего шага
-    add     r9, 8
-    dec     r10
-    jnz     .bit_shift_tail
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    lea     rsi, [rdi + r9 * 8]             ; src = num + word_shift
+    sub     rdx, r9                         ; rdx = new_len
+    test    ecx, ecx
+    jz      .word_move
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words
+    jmp     bignum_shift_right.normalize
 
-.bit_shift_last:
-    shr     qword [rdi + rdx * 8 - 8], cl   ; Сдвиг самого старшего слова
+.word_move:
+    call    word_move
+    jmp     bignum_shift_right.normalize
 
-.normalize:
-    ; --- 3. Нормализация длины O(1) ---
-    ; Сдвиг < 64 бит может уменьшить длину нормализованного числа максимум на 1 слово.
-    ; Хвост уже обнулен (либо word_shift, либо shr в .bit_shift_last).
-    cmp     qword [rdi + rdx * 8 - 8], 0
+; =============================================================================
+; @brief      Сдвиг вне места без обнуления dst->words[len .. CAPACITY).
+; @param      rdi: bignum_t* dst - Результат (может быть неинициализирован).
+; @param      rsi: const bignum_t* src - Исходное число (не изменяется при dst != src).
+; @param      rdx: size_t shift_amount - Количество бит для сдвига.
+; @return     rax: Код состояния, как у bignum_shift_right_to.
+; @note       Как bignum_shift_right_to, но без .zero_tail: записываются только
+;             len - word_shift слов результата и len, поэтому время не зависит от
+;             BIGNUM_CAPACITY. Слова dst с номерами >= dst->len не определены.
+;             dst == src — bignum_shift_right_nz.
+; @version    1.0.38
+; =============================================================================
+bignum_shift_right_to_nz:
+    test    rdi, rdi
+    jz      bignum_shift_right.error_null_arg
+    test    rsi, rsi
+    jz      bignum_shift_right.error_null_arg
+    cmp     rdi, rsi
+    je      .in_place
+
+    mov     r10d, [rsi + BIGNUM_LEN_OFFSET] ; r10 = len
+    mov     r9, rdx
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, edx
+    and     ecx, 63                         ; cl = bit_shift
+    cmp     r9, r10
+    jae     .zero_dst                       ; Все слова уходят (в т.ч. len == 0)
+
+    lea     rsi, [rsi + r9 * 8]             ; src = src->words + word_shift
+    mov     rdx, r10
+    sub     rdx, r9                         ; rdx = n = len - word_shift
+    test    ecx, ecx
+    jz      .copy
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words
+    jmp     bignum_shift_right_to.normalize
+
+.copy:
+    call    word_move
+    jmp     bignum_shift_right_to.normalize
+
+.zero_dst:
+    xor     eax, eax
+    mov     [rdi + BIGNUM_LEN_OFFSET], rax  ; Только len: слова не очищаются
+    test    r10, r10
+    setnz   al                              ; ZEROED, если src был ненулевым
+    ret
+
+.in_place:
+    mov     rsi, rdx
+    jmp     bignum_shift_right_nz.entry
+
+; =============================================================================
+; @brief      Выполняет арифметический сдвиг большого числа вправо.
+; @param      rdi: bignum_t* num - Число в дополнительном коде шириной len * 64 бит
+;             (знак — бит 63 слова words[len - 1]).
+; @param      rsi: size_t shift_amount - Количество бит для сдвига.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED — остался только знак,
+;             т. е. результат 0 или -1), -1 (ERROR_NULL_ARG).
+; @note       Слова результата вычисляются тем же ядром, что и логический сдвиг;
+;             затем старшее слово восстанавливается как sar(words[len - 1], bs):
+;             ядро пишет в него words[len - 1] >> bs, а shl/sar на bs возвращают
+;             знаковые биты. Освободившиеся слова выше нового len обнуляются —
+;             знаковое расширение за len подразумевается, как в дополнительном коде.
+; @note       Нормализация O(1): для числа без избыточного старшего слова
+;             (words[len - 1] != знак или бит 63 words[len - 2] != знак) сдвиг
+;             делает избыточным не более одного слова. -1 хранится как {~0, len=1}.
+; @version    1.0.22
+; =============================================================================
+bignum_shift_right_arith:
+    test    rdi, rdi
+    jz      .error_null_arg
+
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      .success_zero                   ; Если len == 0, возвращаем 0
+    test    rsi, rsi
+    jz      .success_zero                   ; Если shift == 0, возвращаем 0
+
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    cmp     r9, rdx
+    jae     .sign_out
+
+    lea     rsi, [rdi + r9 * 8]             ; src = num + word_shift
+    sub     rdx, r9                         ; rdx = new_len = len - word_shift
+    test    ecx, ecx
+    jz      .word_move
+
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words                 ; Слова как при логическом сдвиге
+    mov     rax, [rdi + rdx * 8 - 8]        ; words[len - 1] >> bs
+    shl     rax, cl
+    sar     rax, cl                         ; = sar(words[len - 1], bs)
+    mov     [rdi + rdx * 8 - 8], rax
+    jmp     .zero_top
+
+.word_move:
+    call    word_move                       ; words[i] = words[i + word_shift]
+
+.zero_top:
+    ; --- Обнуление освободившихся старших word_shift слов ---
+    mov     ecx, [rdi + BIGNUM_LEN_OFFSET]  ; Старый len еще не перезаписан
+    sub     rcx, rdx                        ; count = word_shift (может быть 0)
+    mov     r10, rdi
+    lea     rdi, [rdi + rdx * 8]
+    call    word_zero
+    mov     rdi, r10
+
+    ; --- Нормализация O(1): отбрасываем старшее слово, если оно — только знак ---
+    mov     rax, [rdi + rdx * 8 - 8]
+    mov     r11, rax
+    sar     r11, 63                         ; r11 = знак (0 или -1)
+    cmp     rax, r11
     jne     .set_len
+    cmp     rdx, 1
+    je      .single
+    mov     rax, [rdi + rdx * 8 - 16]
+    xor     rax, r11
+    js      .set_len                        ; Бит 63 слова ниже не равен знаку: слово нужно
+    mov     qword [rdi + rdx * 8 - 8], 0
     dec     rdx
+    jmp     .set_len
+
+.single:
+    test    rax, rax
+    jnz     .set_len                        ; -1 остается {~0, len=1}
+    dec     rdx                             ; 0 -> len = 0
+
 .set_len:
     mov     [rdi + BIGNUM_LEN_OFFSET], edx
     xor     eax, eax
-    test    edx, edx
-    setz    al                              ; Возвращаем 1 (ZEROED), если len == 0, иначе 0 (SUCCESS)
+    cmp     rdx, 1
+    ja      .done
+    cmp     [rdi], r11                      ; len <= 1 и words[0] == знак: результат 0 или -1
+    sete    al
+.done:
     ret
 
-.zero_out:
-    ; --- Полное обнуление числа ---
+.sign_out:
+    ; --- Все значащие биты ушли: результат 0 или -1 ---
+    mov     r11, [rdi + rdx * 8 - 8]
+    sar     r11, 63                         ; r11 = знак
     mov     rcx, rdx
-    xor     eax, eax
-    mov     r8, rdi
-    rep stosq
-    mov     rdi, r8
-    mov     dword [rdi + BIGNUM_LEN_OFFSET], 0
+    call    word_zero
+    mov     [rdi], r11                      ; words[0] = 0 или ~0
+    and     r11d, 1
+    mov     [rdi + BIGNUM_LEN_OFFSET], r11d ; len = 0 или 1
     mov     eax, 1                          ; Код возврата: ZEROED
     ret
 
@@ -206,5 +772,2263 @@ bignum_shift_right:
     ret
 
 .success_zero:
-    xor     rax, rax                        ; Код возврата: SUCCESS
-    ret
\ No newline at end of file
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+; =============================================================================
+; @brief      Сдвигает число вправо при s >= 0 и влево на -s при s < 0.
+; @param      rdi: bignum_t* num - Указатель на bignum_t.
+; @param      rsi: ptrdiff_t s - Величина сдвига со знаком.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG),
+;             -3 (ERROR_OVERFLOW — сдвиг влево вышел бы за BIGNUM_CAPACITY).
+; @note       s >= 0 — хвостовой переход в bignum_shift_right. Для s < 0
+;             neg дает модуль, в т.ч. 2^63 для PTRDIFF_MIN.
+; @version    1.0.25
+; =============================================================================
+bignum_shift_right_signed:
+    test    rsi, rsi
+    jns     bignum_shift_right
+    neg     rsi                             ; rsi = |s|
+    ; Проваливаемся в shift_left
+
+; =============================================================================
+; @internal
+; @brief      Логический сдвиг влево (num <<= k) с контролем переполнения емкости.
+; @param      rdi: bignum_t* num (может быть NULL).
+; @param      rsi: size_t k (> 0).
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG), -3 (ERROR_OVERFLOW — число
+;             не изменено).
+; @note       Та же техника масок, что у bit_shift_scalar, в зеркальном виде:
+;             t[i] = rol(words[i], bs), out[i + ws] = t[i - 1] ^ ((t[i] ^ t[i - 1]) & hi),
+;             hi = -1 << bs (при bs == 0 hi = -1 и out = t[i], т. е. перенос слов).
+;             Слова обрабатываются сверху вниз парами, загрузки шага выполняются
+;             до записи, поэтому сдвиг на месте безопасен. Старшие выдвинутые
+;             биты (t[len - 1] & ~hi) дают новое слово, младшие ws слов обнуляются.
+; =============================================================================
+shift_left:
+    test    rdi, rdi
+    jz      .error_null_arg
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    test    edx, edx
+    jz      .success                        ; 0 << k = 0
+
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    mov     r11, -1
+    shl     r11, cl                         ; r11 = hi = маска старших бит слова
+    lea     r10, [rdx + r9]                 ; r10 = len + word_shift
+    cmp     r10, BIGNUM_CAPACITY
+    ja      .overflow
+
+    mov     rax, [rdi + rdx * 8 - 8]
+    rol     rax, cl                         ; rax = t[len - 1]
+    mov     r8, r11
+    not     r8
+    and     r8, rax                         ; r8 = выдвинутые биты старшего слова
+    jz      .no_spill
+    cmp     r10, BIGNUM_CAPACITY
+    je      .overflow
+    mov     [rdi + r10 * 8], r8             ; Новое старшее слово
+    inc     r10
+.no_spill:
+    mov     [rdi + BIGNUM_LEN_OFFSET], r10d ; new_len
+
+    lea     rsi, [rdi + r9 * 8]             ; rsi = dst = words + word_shift
+    dec     rdx                             ; rdx = i = len - 1 (пишем out[i] .. out[1])
+    jz      .last
+    test    dl, 1
+    jz      .pair
+    mov     r10, [rdi + rdx * 8 - 8]
+    rol     r10, cl                         ; t[i - 1]
+    xor     rax, r10
+    and     rax, r11
+    xor     rax, r10                        ; out[i] = t[i] & hi | t[i - 1] & ~hi
+    mov     [rsi + rdx * 8], rax
+    mov     rax, r10
+    dec     rdx
+    jz      .last
+
+.pair:
+    mov     r10, [rdi + rdx * 8 - 8]        ; words[i - 1]
+    mov     r8, [rdi + rdx * 8 - 16]        ; words[i - 2]
+    rol     r10, cl
+    rol     r8, cl
+    xor     rax, r10
+    and     rax, r11
+    xor     rax, r10
+    mov     [rsi + rdx * 8], rax            ; out[i]
+    xor     r10, r8
+    and     r10, r11
+    xor     r10, r8
+    mov     [rsi + rdx * 8 - 8], r10        ; out[i - 1]
+    mov     rax, r8
+    sub     rdx, 2
+    jnz     .pair
+
+.last:
+    and     rax, r11
+    mov     [rsi], rax                      ; out[0] = t[0] & hi
+
+    mov     rcx, r9
+    call    word_zero                       ; words[0 .. word_shift) = 0
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.overflow:
+    mov     rax, -3                         ; Код возврата: ERROR_OVERFLOW
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Логический сдвиг вправо за постоянное время (секретные данные).
+; @param      rdi: bignum_t* num - Указатель на bignum_t.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига (секрет).
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG).
+; @note       Время и адреса обращений не зависят ни от shift_amount, ни от len:
+;             всегда обрабатываются все BIGNUM_CAPACITY слов, циклы имеют
+;             постоянное число итераций, выбор — только cmov (cmov с памятью
+;             читает операнд всегда).
+;             1. Слова i >= len (и все слова при word_shift >= CAPACITY) обнуляются.
+;             2. Сдвиг по битам ror/and/shr/or без shrd; маска ~(-1 >> s) при
+;                s = 0 равна нулю, поэтому отдельной ветки для s = 0 нет.
+;             3. Сдвиг по словам — ceil(log2(CAPACITY)) ступеней barrel shifter:
+;                ступень d = 2^k переносит words[i + d] в words[i], если бит k
+;                word_shift установлен.
+;             4. len — номер старшего ненулевого слова + 1 (проход по всем словам).
+;             Ветвление только по num == NULL (не секрет).
+; @version    1.0.29
+; =============================================================================
+bignum_shift_right_ct:
+    test    rdi, rdi
+    jz      .error_null_arg
+
+    xor     r10d, r10d                      ; r10 = 0 (источник для cmov)
+    mov     r8d, [rdi + BIGNUM_LEN_OFFSET]  ; r8 = len
+    xor     r11d, r11d
+    test    r8, r8
+    setnz   r11b
+    xor     eax, eax
+    test    rsi, rsi
+    setnz   al
+    and     r11d, eax                       ; r11 = 1, если len != 0 и shift != 0
+    mov     rdx, rsi
+    shr     rdx, 6                          ; rdx = word_shift
+    cmp     rdx, BIGNUM_CAPACITY
+    cmovae  r8, r10                         ; word_shift >= CAPACITY: результат 0
+
+    ; --- 1. words[i] = 0 для i >= len ---
+    mov     r9, -BIGNUM_CAPACITY            ; r9 = i - CAPACITY
+.mask_loop:
+    lea     rcx, [r9 + BIGNUM_CAPACITY]     ; rcx = i
+    mov     rax, [rdi + r9 * 8 + BIGNUM_CAPACITY * 8]
+    cmp     rcx, r8
+    cmovae  rax, r10
+    mov     [rdi + r9 * 8 + BIGNUM_CAPACITY * 8], rax
+    inc     r9
+    jnz     .mask_loop
+
+    ; --- 2. Сдвиг по битам (s = 0..63); сдвиги вправо коммутируют, поэтому
+    ;        биты сдвигаются до слов ---
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = ~(-1 >> s), 0 при s = 0
+%if BIGNUM_CAPACITY > 1
+    mov     r9, -(BIGNUM_CAPACITY - 1)      ; r9 = i - (CAPACITY - 1), i < CAPACITY - 1
+.bit_loop:
+    mov     rax, [rdi + r9 * 8 + (BIGNUM_CAPACITY - 1) * 8]
+    mov     rsi, [rdi + r9 * 8 + BIGNUM_CAPACITY * 8]
+    shr     rax, cl
+    ror     rsi, cl
+    and     rsi, r8
+    or      rax, rsi                        ; words[i] >> s | words[i + 1] << (64 - s)
+    mov     [rdi + r9 * 8 + (BIGNUM_CAPACITY - 1) * 8], rax
+    inc     r9
+    jnz     .bit_loop
+%endif
+    shr     qword [rdi + (BIGNUM_CAPACITY - 1) * 8], cl
+
+    ; --- 3. Сдвиг по словам: ступени d = 1, 2, 4 ... < CAPACITY ---
+    mov     ecx, 1                          ; rcx = d
+.stage:
+    cmp     rcx, BIGNUM_CAPACITY
+    jae     .length
+    mov     r8, rdx
+    and     r8, rcx                         ; r8 != 0: ступень переносит слова
+    lea     r9, [rcx - BIGNUM_CAPACITY]     ; r9 = i - (CAPACITY - d), i < CAPACITY - d
+    lea     rax, [rcx * 8]
+    mov     rsi, rdi
+    sub     rsi, rax                        ; rsi + CAPACITY * 8 = &words[CAPACITY - d]
+.stage_move:
+    mov     rax, [rsi + r9 * 8 + BIGNUM_CAPACITY * 8]       ; words[i]
+    test    r8, r8
+    cmovnz  rax, [rdi + r9 * 8 + BIGNUM_CAPACITY * 8]       ; words[i + d]
+    mov     [rsi + r9 * 8 + BIGNUM_CAPACITY * 8], rax
+    inc     r9
+    jnz     .stage_move
+    mov     r9, rcx
+    neg     r9                              ; Старшие d слов: words[i] = 0
+.stage_zero:
+    mov     rax, [rdi + r9 * 8 + BIGNUM_CAPACITY * 8]
+    test    r8, r8
+    cmovnz  rax, r10
+    mov     [rdi + r9 * 8 + BIGNUM_CAPACITY * 8], rax
+    inc     r9
+    jnz     .stage_zero
+    add     rcx, rcx
+    jmp     .stage
+
+    ; --- 4. len = старшее ненулевое слово + 1 ---
+.length:
+    xor     edx, edx
+    mov     r9, -BIGNUM_CAPACITY
+.len_loop:
+    lea     rax, [r9 + BIGNUM_CAPACITY + 1]
+    cmp     qword [rdi + r9 * 8 + BIGNUM_CAPACITY * 8], 0
+    cmovne  rdx, rax
+    inc     r9
+    jnz     .len_loop
+    mov     [rdi + BIGNUM_LEN_OFFSET], edx
+    xor     eax, eax
+    test    edx, edx
+    setz    al
+    and     eax, r11d                       ; 1 (ZEROED), если биты были и все потеряны
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает src вправо и записывает результат в dst за один проход.
+; @param      rdi: bignum_t* dst - Результат (может быть неинициализирован).
+; @param      rsi: const bignum_t* src - Исходное число (не изменяется).
+; @param      rdx: size_t shift_amount - Количество бит для сдвига.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG).
+; @note       Читаются только src->words[word_shift .. len), каждое слово dst
+;             записывается ровно один раз: n = len - word_shift слов результата,
+;             затем нули до BIGNUM_CAPACITY. Если dst == src, выполняется
+;             обычный сдвиг на месте.
+; @version    1.0.18
+; =============================================================================
+bignum_shift_right_to:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rsi, rsi
+    jz      .error_null_arg
+    cmp     rdi, rsi
+    je      .in_place
+
+    mov     r10d, [rsi + BIGNUM_LEN_OFFSET] ; r10 = len
+    mov     r9, rdx
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, edx
+    and     ecx, 63                         ; cl = bit_shift
+    cmp     r9, r10
+    jae     .zero_dst                       ; Все слова уходят (в т.ч. len == 0)
+
+    lea     rsi, [rsi + r9 * 8]             ; src = src->words + word_shift
+    mov     rdx, r10
+    sub     rdx, r9                         ; rdx = n = len - word_shift
+    test    ecx, ecx
+    jz      .copy
+
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words                 ; dst[0 .. n) = src[...] >> bit_shift
+    jmp     .zero_tail
+
+.copy:
+    ; --- bit_shift == 0: перенос слов без изменения ---
+    call    word_move
+
+.zero_tail:
+    ; --- Обнуление dst->words[n .. CAPACITY) ---
+    mov     r11, rdi
+    lea     rdi, [rdi + rdx * 8]
+    mov     ecx, BIGNUM_CAPACITY
+    sub     rcx, rdx
+    call    word_zero
+    mov     rdi, r11
+
+.normalize:
+    ; --- Нормализация O(1), как в bignum_shift_right ---
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    jne     .set_len
+    dec     rdx
+.set_len:
+    mov     [rdi + BIGNUM_LEN_OFFSET], rdx  ; Все 8 байт: dst может быть неинициализирован
+    xor     eax, eax
+    test    edx, edx
+    setz    al                              ; 1 (ZEROED), если len == 0, иначе 0 (SUCCESS)
+    ret
+
+.zero_dst:
+    ; --- Результат равен нулю ---
+    mov     ecx, BIGNUM_CAPACITY
+    call    word_zero
+    xor     eax, eax
+    mov     [rdi + BIGNUM_LEN_OFFSET], rax
+    test    r10, r10
+    setnz   al                              ; ZEROED, если src был ненулевым
+    ret
+
+.in_place:
+    mov     rsi, rdx
+    jmp     bignum_shift_right.entry
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Логический сдвиг вправо числа во внешнем буфере (bignum_view_t).
+; @param      rdi: bignum_view_t* view - {words, len, cap}; len — 64-битный.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG).
+; @note       Те же word_move / bit_shift_words / word_zero, что и у bignum_shift_right,
+;             но длина читается и пишется целиком (без ограничения 32 битами
+;             и BIGNUM_CAPACITY). Обнуляются только освободившиеся слова
+;             [new_len, len); слова [len, cap) не трогаются. Начиная с
+;             bit_shift_stream_min слов результата побитовый сдвиг идет потоковым
+;             ядром bit_shift_stream (записи в обход кэша).
+; @version    1.0.28
+; =============================================================================
+bignum_shift_right_view:
+    test    rdi, rdi
+    jz      .error_null_arg
+    mov     rdx, [rdi + VIEW_LEN_OFFSET]    ; rdx = len
+    test    rdx, rdx
+    jz      .success_zero                   ; Пустое число: words может быть NULL
+    cmp     qword [rdi + VIEW_WORDS_OFFSET], 0
+    je      .error_null_arg
+    test    rsi, rsi
+    jz      .success_zero
+
+    push    rbx
+    mov     rbx, rdi                        ; rbx = view
+    mov     rdi, [rdi + VIEW_WORDS_OFFSET]  ; rdi = words
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    cmp     r9, rdx
+    jae     .zero_out
+
+    lea     rsi, [rdi + r9 * 8]             ; src = words + word_shift
+    sub     rdx, r9                         ; rdx = new_len
+    test    ecx, ecx
+    jz      .word_move
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words_large
+    jmp     .zero_top
+
+.word_move:
+    call    word_move
+
+.zero_top:
+    mov     rcx, [rbx + VIEW_LEN_OFFSET]   ; Старый len еще не перезаписан
+    sub     rcx, rdx                        ; count = word_shift (ядра портят r9)
+    mov     r10, rdi
+    lea     rdi, [rdi + rdx * 8]
+    call    word_zero                       ; words[new_len .. len) = 0
+    mov     rdi, r10
+
+    ; --- Нормализация O(1), как в bignum_shift_right ---
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    jne     .set_len
+    dec     rdx
+.set_len:
+    mov     [rbx + VIEW_LEN_OFFSET], rdx
+    xor     eax, eax
+    test    rdx, rdx
+    setz    al                              ; 1 (ZEROED), если len == 0, иначе 0 (SUCCESS)
+    pop     rbx
+    ret
+
+.zero_out:
+    mov     rcx, rdx
+    call    word_zero                       ; words[0 .. len) = 0
+    mov     qword [rbx + VIEW_LEN_OFFSET], 0
+    mov     eax, 1                          ; Код возврата: ZEROED
+    pop     rbx
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+.success_zero:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Сдвиг отрезка слов с явно заданным старшим соседом.
+; @param      rdi: uint64_t* dst - Слова результата.
+; @param      rsi: const uint64_t* src - Исходные слова (src >= dst или без перекрытия).
+; @param      rdx: size_t n - Число слов (>= 1).
+; @param      ecx: unsigned bit_shift (0..63).
+; @param      r8:  uint64_t hi - Значение слова src[n] (из памяти не читается).
+; @note       dst[i] = (src[i] >> s) | (src[i + 1] << (64 - s)), где src[n] = hi.
+;             Используется параллельным ядром (bignum_shift_right_parallel.c):
+;             соседа за границей отрезка поток берет из заранее сохраненной
+;             копии, поэтому соседние отрезки можно сдвигать одновременно.
+;             Длинные отрезки, как и у bignum_shift_right_view, пишутся
+;             потоковым ядром.
+; @version    1.0.28
+; =============================================================================
+bignum_shift_right_segment:
+    test    ecx, ecx
+    jz      word_move                       ; bit_shift == 0: только перенос слов
+    push    rbx
+    mov     rbx, r8                         ; rbx = hi (r8 занят маской)
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words_large
+    neg     ecx                             ; cl = 64 - bit_shift (по модулю 64)
+    shl     rbx, cl
+    or      [rdi + rdx * 8 - 8], rbx        ; Биты соседа в старшее слово отрезка
+    pop     rbx
+    ret
+
+; =============================================================================
+; @brief      Извлекает битовое окно [lo, lo + width) числа src в dst.
+; @param      rdi: bignum_t* dst - Результат (может быть неинициализирован).
+; @param      rsi: const bignum_t* src - Исходное число (не изменяется).
+; @param      rdx: size_t lo - Номер младшего бита окна.
+; @param      rcx: size_t width - Ширина окна в битах.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED — все биты окна нулевые),
+;             -1 (ERROR_NULL_ARG).
+; @note       Читаются только src->words[lo / 64 .. lo / 64 + ceil(width / 64)]
+;             (не дальше len): ядру bit_shift_words передается на одно слово
+;             больше, чем нужно результату, чтобы старшее слово окна получило
+;             биты следующего слова; лишнее слово затем обнуляется вместе с
+;             хвостом. dst == src допустимо (сдвиг на месте).
+; @version    1.0.24
+; =============================================================================
+bignum_shift_right_extract_bits:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rsi, rsi
+    jz      .error_null_arg
+
+    push    rbx
+    push    r12
+    mov     rbx, rcx                        ; rbx = width
+    mov     r10d, [rsi + BIGNUM_LEN_OFFSET] ; r10 = len
+    mov     r9, rdx
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, edx
+    and     ecx, 63                         ; cl = bit_shift
+    mov     rax, rbx
+    shr     rax, 6
+    test    ebx, 63
+    setnz   dl
+    movzx   edx, dl
+    add     rax, rdx                        ; rax = m = ceil(width / 64)
+    cmp     r9, r10
+    jae     .zero_dst                       ; Окно выше len
+
+    lea     rsi, [rsi + r9 * 8]             ; src = src->words + word_shift
+    sub     r10, r9                         ; r10 = доступно слов
+    mov     r12, rax
+    cmp     r12, r10
+    cmova   r12, r10                        ; r12 = e = min(m, доступно)
+    test    r12, r12
+    jz      .zero_dst                       ; width == 0
+
+    mov     rdx, r12
+    test    ecx, ecx
+    jz      .copy
+    cmp     r12, r10
+    adc     rdx, 0                          ; +1 слово для старших бит окна, если есть
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска для старших битов
+    call    bit_shift_words
+    jmp     .mask
+
+.copy:
+    call    word_move
+
+.mask:
+    ; --- Маскирование старшего слова окна (только если окно не выходит за len) ---
+    mov     rdx, r12
+    mov     ecx, ebx
+    and     ecx, 63
+    jz      .zero_tail
+    shr     rbx, 6
+    cmp     rdx, rbx
+    jbe     .zero_tail                      ; e <= width / 64: неполное слово за len
+    mov     rax, -1
+    shl     rax, cl
+    not     rax
+    and     [rdi + rdx * 8 - 8], rax
+
+.zero_tail:
+    mov     r11, rdi
+    lea     rdi, [rdi + rdx * 8]
+    mov     ecx, BIGNUM_CAPACITY
+    sub     rcx, rdx
+    call    word_zero                       ; dst->words[e .. CAPACITY) = 0
+    mov     rdi, r11
+
+.normalize:
+    ; --- Нормализация: окно может начинаться с нулевых слов, поэтому цикл ---
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    jne     .set_len
+    dec     rdx
+    jnz     .normalize
+
+.set_len:
+    mov     [rdi + BIGNUM_LEN_OFFSET], rdx  ; Все 8 байт: dst может быть неинициализирован
+    xor     eax, eax
+    test    rdx, rdx
+    setz    al                              ; ZEROED, если все биты окна нулевые
+    pop     r12
+    pop     rbx
+    ret
+
+.zero_dst:
+    mov     ecx, BIGNUM_CAPACITY
+    call    word_zero
+    mov     qword [rdi + BIGNUM_LEN_OFFSET], 0
+    mov     eax, 1                          ; Код возврата: ZEROED
+    pop     r12
+    pop     rbx
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Записывает src >> k в out как беззнаковое big-endian число из
+;             ровно out_len байт (с ведущими нулями), не изменяя src.
+; @param      rdi: const bignum_t* src - Исходное число (не изменяется).
+; @param      rsi: size_t shift_amount - Количество бит для сдвига (k).
+; @param      rdx: uint8_t* out - Буфер результата (может быть NULL при out_len == 0).
+; @param      rcx: size_t out_len - Размер out в байтах.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED — все значащие биты src
+;             ушли, out заполнен нулями), -1 (ERROR_NULL_ARG), -3 (ERROR_OVERFLOW —
+;             результат длиннее out_len байт, out не изменяется).
+; @note       Слова результата собираются из пары соседних слов src (как в
+;             bit_shift_words) и сразу пишутся в out через bswap, от младших
+;             байт (конец буфера) к старшим; промежуточного bignum_t нет.
+;             Число значащих байт считается по старшему слову (bsr) до записи,
+;             поэтому при переполнении out не трогается. bswap вместо movbe:
+;             movbe требует проверки CPUID, а bswap + mov есть на любом x86-64.
+; @version    1.0.36
+; =============================================================================
+bignum_shift_right_export_be:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rdx, rdx
+    jnz     .args_ok
+    test    rcx, rcx
+    jnz     .error_null_arg                 ; out == NULL при out_len > 0
+
+.args_ok:
+    push    rbx
+    push    r12
+    lea     r8, [rdx + rcx]                 ; r8 = out + out_len: запись идет вниз
+    mov     rdx, rcx                        ; rdx = незаписанные байты out[0 .. rdx)
+    xor     r12d, r12d                      ; r12 = статус (SUCCESS) и ноль для cmov
+    mov     r10d, [rdi + BIGNUM_LEN_OFFSET] ; r10 = len
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    cmp     r9, r10
+    jae     .zero_result                    ; Все слова уходят (в т.ч. len == 0)
+
+    lea     rsi, [rdi + r9 * 8]             ; rsi = src->words + word_shift
+    sub     r10, r9                         ; r10 = m = len - word_shift
+    mov     r11, -1
+    shr     r11, cl
+    not     r11                             ; r11 = маска для старших битов
+
+    ; --- n слов результата и число его значащих байт ---
+    mov     r9, r10                         ; r9 = n
+    mov     rax, [rsi + r10 * 8 - 8]
+    shr     rax, cl                         ; У старшего слова нет соседа
+    test    rax, rax                        ; shr на 0 не меняет флаги
+    jnz     .have_top
+    dec     r9                              ; Старшее слово ушло целиком
+    jz      .zero_result
+    mov     rax, [rsi + r9 * 8 - 8]
+    mov     rbx, [rsi + r9 * 8]
+    shr     rax, cl
+    ror     rbx, cl
+    and     rbx, r11
+    or      rax, rbx                        ; != 0: сюда перешли биты words[len - 1]
+
+.have_top:
+    bsr     rax, rax
+    shr     eax, 3
+    lea     rax, [rax + r9 * 8 - 7]         ; (n - 1) * 8 + bsr / 8 + 1 значащих байт
+    cmp     rax, rdx
+    ja      .overflow
+
+    xor     edi, edi                        ; rdi = i
+.word_loop:
+    cmp     rdi, r9
+    jae     .pad
+    mov     rax, [rsi + rdi * 8]
+    mov     rbx, [rsi + rdi * 8 + 8]        ; При i + 1 == m — words[len] или len (внутри bignum_t)
+    inc     rdi
+    cmp     rdi, r10
+    cmovae  rbx, r12                        ; Соседа нет: 0
+    shr     rax, cl
+    ror     rbx, cl
+    and     rbx, r11
+    or      rax, rbx                        ; rax = слово i результата
+    cmp     rdx, 8
+    jb      .partial
+    bswap   rax
+    sub     r8, 8
+    mov     [r8], rax                       ; out[out_len - 8 (i + 1) .. out_len - 8 i)
+    sub     rdx, 8
+    jmp     .word_loop
+
+.partial:
+    ; --- Старшее слово в неполные rdx байт (значащие байты помещаются, см. выше) ---
+    dec     r8
+    mov     [r8], al
+    shr     rax, 8
+    dec     rdx
+    jnz     .partial
+    jmp     .done
+
+.zero_result:
+    test    r10, r10
+    setnz   r12b                            ; ZEROED, если src был ненулевым
+
+.pad:
+    ; --- Ведущие нули out[0 .. rdx) ---
+    cmp     rdx, 8
+    jb      .pad_bytes
+    sub     r8, 8
+    mov     qword [r8], 0
+    sub     rdx, 8
+    jmp     .pad
+.pad_bytes:
+    test    rdx, rdx
+    jz      .done
+    dec     r8
+    mov     byte [r8], 0
+    dec     rdx
+    jmp     .pad_bytes
+
+.done:
+    mov     rax, r12
+    pop     r12
+    pop     rbx
+    ret
+
+.overflow:
+    mov     rax, -3                         ; Код возврата: ERROR_OVERFLOW
+    pop     r12
+    pop     rbx
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает число вправо и сохраняет выпавшие биты (num mod 2^k) в rem.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига (k).
+; @param      rdx: bignum_t* rem - Остаток (может быть неинициализирован, != num).
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       В rem копируются только words[0 .. ceil(k / 64)) (не больше len),
+;             неполное слово маскируется, затем rem нормализуется и его хвост
+;             обнуляется до BIGNUM_CAPACITY. Сдвиг num выполняется хвостовым
+;             переходом в bignum_shift_right.entry.
+; @version    1.0.21
+; =============================================================================
+bignum_shift_right_rem:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rdx, rdx
+    jz      .error_null_arg
+
+    push    rbx
+    push    r12
+    push    r13
+    mov     rbx, rdi                        ; rbx = num
+    mov     r12, rsi                        ; r12 = shift_amount
+    mov     r13, rdx                        ; r13 = rem
+
+    ; --- m = min(word_shift + (bit_shift != 0), len) слов остатка ---
+    mov     rdx, rsi
+    shr     rdx, 6
+    xor     eax, eax
+    test    esi, 63
+    setnz   al
+    add     rdx, rax
+    mov     eax, [rbx + BIGNUM_LEN_OFFSET]
+    cmp     rdx, rax
+    cmova   rdx, rax                        ; rdx = m
+
+    mov     rdi, r13
+    test    rdx, rdx
+    jz      .normalize                      ; Ничего не выпадает
+    mov     rsi, rbx
+    call    word_move                       ; rem.words[0 .. m) = num.words[0 .. m)
+
+    ; --- Маскирование неполного слова words[word_shift] ---
+    mov     rcx, r12
+    shr     rcx, 6
+    cmp     rcx, rdx
+    jae     .normalize                      ; word_shift >= m: неполного слова нет
+    mov     ecx, r12d                       ; cl = bit_shift (!= 0, раз m = word_shift + 1)
+    mov     rax, -1
+    shl     rax, cl
+    not     rax                             ; rax = младшие bit_shift бит
+    and     [rdi + rdx * 8 - 8], rax
+
+.normalize:
+    ; --- Нормализация rem: младшие слова могут быть нулевыми, поэтому цикл ---
+    test    rdx, rdx
+    jz      .set_len
+    cmp     qword [rdi + rdx * 8 - 8], 0
+    jne     .set_len
+    dec     rdx
+    jmp     .normalize
+
+.set_len:
+    mov     [rdi + BIGNUM_LEN_OFFSET], rdx  ; Все 8 байт: rem может быть неинициализирован
+    lea     rdi, [rdi + rdx * 8]
+    mov     ecx, BIGNUM_CAPACITY
+    sub     rcx, rdx
+    call    word_zero                       ; rem.words[len .. CAPACITY) = 0
+
+    mov     rdi, rbx
+    mov     rsi, r12
+    pop     r13
+    pop     r12
+    pop     rbx
+    jmp     bignum_shift_right.entry        ; Сдвиг num
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает число вправо и возвращает старшие 64 выпавших бита с sticky-битом.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига (k).
+; @param      rdx: uint64_t* dropped - Результат: биты [k - 64, k) исходного числа,
+;             выровненные влево (бит 63 = бит k - 1), с OR всех более младших
+;             выпавших бит в бит 0.
+; @return     rax: Код состояния, как у bignum_shift_right.
+; @note       dropped == 0 — сдвиг точный; dropped == 1 << 63 — ровно половина
+;             младшего разряда результата; больше — больше половины.
+;             Читаются только words[0 .. word_shift], затем хвостовой переход
+;             в bignum_shift_right.entry.
+; @version    1.0.21
+; =============================================================================
+bignum_shift_right_sticky:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rdx, rdx
+    jz      .error_null_arg
+
+    mov     r8, rdx                         ; r8 = dropped
+    mov     r10d, [rdi + BIGNUM_LEN_OFFSET] ; r10 = len
+    xor     eax, eax                        ; rax = старшие 64 выпавших бита
+    xor     r11d, r11d                      ; r11 = OR более младших выпавших бит
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    mov     r9, rsi
+    shr     r9, 6                           ; r9 = word_shift
+    test    r9, r9
+    jnz     .wide
+
+    ; --- k < 64: выпадают младшие bit_shift бит words[0] ---
+    test    ecx, ecx
+    jz      .store
+    test    r10, r10
+    jz      .store
+    mov     rax, [rdi]
+    neg     ecx                             ; cl = 64 - bit_shift (по модулю 64)
+    shl     rax, cl
+    jmp     .store
+
+.wide:
+    cmp     r9, r10
+    ja      .beyond
+    mov     rax, [rdi + r9 * 8 - 8]         ; lo = words[word_shift - 1]
+    xor     edx, edx                        ; hi = 0, если word_shift == len
+    cmp     r9, r10
+    jae     .have_hi
+    mov     rdx, [rdi + r9 * 8]             ; hi = words[word_shift]
+.have_hi:
+    test    ecx, ecx
+    jz      .lower_words
+    mov     r11, rax
+    shr     rax, cl                         ; lo >> bit_shift
+    neg     ecx                             ; cl = 64 - bit_shift
+    shl     r11, cl                         ; Младшие bit_shift бит lo — в sticky
+    shl     rdx, cl
+    or      rax, rdx                        ; rax = (lo >> s) | (hi << (64 - s))
+
+.lower_words:
+    ; --- sticky |= words[0 .. word_shift - 1) ---
+    lea     rcx, [r9 - 1]
+    test    rcx, rcx
+    jz      .store
+.or_loop:
+    or      r11, [rdi + rcx * 8 - 8]
+    dec     rcx
+    jnz     .or_loop
+    jmp     .store
+
+.beyond:
+    ; --- word_shift > len: все биты числа младше 64 старших выпавших ---
+    mov     r11, r10                        ; sticky = (len != 0)
+
+.store:
+    xor     edx, edx
+    test    r11, r11
+    setnz   dl
+    or      rax, rdx
+    mov     [r8], rax
+    jmp     bignum_shift_right.entry        ; Сдвиг num
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает число вправо на число его младших нулевых бит.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: size_t* shifted_out - Результат: величина сдвига (ctz(num)).
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED — num == 0, *shifted_out = 0),
+;             -1 (ERROR_NULL_ARG).
+; @note       Слова читаются снизу до первого ненулевого; сдвиг уже разобран
+;             (word_shift = номер слова, bit_shift = tzcnt), поэтому переход идет
+;             сразу в bignum_shift_right.decoded. На CPU без BMI1 tzcnt выполняется
+;             как bsf — для ненулевого слова результат тот же.
+; @note       Нечетное число не переписывается. Если ненулевых слов в [0, len) нет,
+;             число обнуляется, как при полном сдвиге (bignum_shift_right.zero_out).
+; @version    1.0.30
+; =============================================================================
+bignum_shift_right_ctz:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rsi, rsi
+    jz      .error_null_arg
+
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]  ; rdx = len
+    xor     r9d, r9d                        ; r9 = номер слова
+.scan:
+    cmp     r9, rdx
+    jae     .zero
+    mov     rax, [rdi + r9 * 8]
+    test    rax, rax
+    jnz     .found
+    inc     r9
+    jmp     .scan
+
+.found:
+    tzcnt   r11, rax                        ; r11 = bit_shift
+    mov     rax, r9
+    shl     rax, 6
+    add     rax, r11
+    mov     [rsi], rax                      ; *shifted_out = word_shift * 64 + bit_shift
+    test    rax, rax
+    jz      .success                        ; Нечетное число: сдвигать нечего
+
+    mov     ecx, r11d
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска старших бит для bit_shift
+    jmp     bignum_shift_right.decoded
+
+.zero:
+    mov     qword [rsi], 0
+    jmp     bignum_shift_right.zero_out     ; rdx = len: обнуление и ZEROED
+
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает число вправо с округлением результата.
+; @param      rdi: bignum_t* num - Число для сдвига.
+; @param      rsi: size_t shift_amount - Количество бит для сдвига.
+; @param      edx: bignum_shift_right_round_t mode - Режим округления.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED), -1 (ERROR_NULL_ARG),
+;             -2 (ERROR_UNSUPPORTED — неизвестный режим).
+; @note       Бит округления и sticky-бит берутся из bignum_shift_right_sticky
+;             (words[0 .. word_shift], которые сдвиг отбрасывает и не читает),
+;             так что каждое слово числа читается один раз. Инкремент после
+;             сдвига обычно затрагивает одно слово; результат не превышает
+;             исходное число, поэтому перенос не выходит за исходный len.
+; @version    1.0.23
+; =============================================================================
+bignum_shift_right_round:
+    test    rdi, rdi
+    jz      .error_null_arg
+    cmp     edx, ROUND_HALF_EVEN
+    ja      .unsupported
+
+    push    rbx
+    push    r12
+    sub     rsp, 8                          ; Слот для выпавших бит (и выравнивание)
+    mov     rbx, rdi                        ; rbx = num
+    mov     r12d, edx                       ; r12 = mode
+    mov     rdx, rsp
+    call    bignum_shift_right_sticky       ; rax = статус сдвига, [rsp] = выпавшие биты
+    mov     rcx, [rsp]
+
+    cmp     r12d, ROUND_CEIL
+    jb      .done                           ; TRUNC
+    je      .ceil
+    test    rcx, rcx
+    jns     .done                           ; HALF_UP, HALF_EVEN: бит округления = 0
+    cmp     r12d, ROUND_HALF_UP
+    je      .increment
+    add     rcx, rcx                        ; HALF_EVEN: остались только sticky-биты
+    jnz     .increment                      ; Больше половины
+    test    byte [rbx], 1
+    jz      .done                           ; Ровно половина, результат четный
+    jmp     .increment
+
+.ceil:
+    test    rcx, rcx
+    jz      .done                           ; Сдвиг точный
+
+.increment:
+    ; --- num += 1 с переносом ---
+    xor     ecx, ecx
+.carry:
+    add     qword [rbx + rcx * 8], 1
+    jnc     .carried
+    inc     rcx
+    jmp     .carry
+.carried:
+    inc     rcx                             ; rcx = число затронутых слов
+    mov     edx, [rbx + BIGNUM_LEN_OFFSET]
+    cmp     rcx, rdx
+    cmova   edx, ecx
+    mov     [rbx + BIGNUM_LEN_OFFSET], edx  ; Результат 0 + 1 или перенос в новое слово
+    xor     eax, eax                        ; Код возврата: SUCCESS (результат != 0)
+
+.done:
+    add     rsp, 8
+    pop     r12
+    pop     rbx
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+.unsupported:
+    mov     rax, -2                         ; Код возврата: ERROR_UNSUPPORTED
+    ret
+
+; =============================================================================
+; @brief      Пакетный сдвиг массива bignum_t на индивидуальные величины.
+; @param      rdi: bignum_t* nums - Массив чисел (count элементов подряд).
+; @param      rsi: const size_t* shifts - Массив величин сдвига (count элементов).
+; @param      rdx: size_t count - Количество элементов.
+; @param      rcx: bignum_shift_right_status_t* statuses - Массив статусов
+;             (count элементов) или NULL, если статусы не нужны.
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG, если nums или shifts NULL при count > 0).
+; @note       Проверка NULL выполняется один раз на весь пакет, элементы
+;             обрабатываются через bignum_shift_right.entry. Все строки
+;             кэша элемента i + BATCH_PREFETCH_AHEAD (слова и len)
+;             предзагружаются до обработки элемента i.
+; @version    1.0.39
+; =============================================================================
+bignum_shift_right_batch:
+    test    rdx, rdx
+    jz      .success                        ; Пустой пакет — успех
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rsi, rsi
+    jz      .error_null_arg
+
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    mov     rbx, rdi                        ; rbx = текущий элемент
+    mov     r14, rsi                        ; r14 = текущий сдвиг
+    mov     r12, rdx                        ; r12 = оставшееся количество
+    mov     r13, rcx                        ; r13 = статусы (или NULL)
+    PREFETCH_BIGNUM rbx + BIGNUM_SIZE       ; Элемент 1; дальше — в цикле
+
+.loop:
+    PREFETCH_BIGNUM rbx + BATCH_PREFETCH_AHEAD * BIGNUM_SIZE ; За концом массива — без ошибок
+    mov     rdi, rbx
+    mov     rsi, [r14]
+    call    bignum_shift_right.entry
+
+    test    r13, r13
+    jz      .next
+    mov     [r13], eax
+    add     r13, 4
+.next:
+    add     r14, 8
+    add     rbx, BIGNUM_SIZE
+    dec     r12
+    jnz     .loop
+
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Пакетный сдвиг массива bignum_t на одну и ту же величину.
+; @param      rdi: bignum_t* nums - Массив чисел (count элементов подряд).
+; @param      rsi: size_t shift_amount - Величина сдвига для всех элементов.
+; @param      rdx: size_t count - Количество элементов.
+; @param      rcx: bignum_shift_right_status_t* statuses - Массив статусов или NULL.
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG, если nums NULL при count > 0).
+; @note       word_shift, bit_shift и маска вычисляются один раз и живут в
+;             callee-saved регистрах; каждый элемент входит сразу в
+;             bignum_shift_right.decoded. Предвыборка — как в
+;             bignum_shift_right_batch.
+; @version    1.0.39
+; =============================================================================
+bignum_shift_right_batch_uniform:
+    test    rdx, rdx
+    jz      .success                        ; Пустой пакет — успех
+    test    rdi, rdi
+    jz      .error_null_arg
+
+    test    rsi, rsi
+    jnz     .setup
+    ; --- Нулевой сдвиг: числа не меняются, все статусы SUCCESS ---
+    test    rcx, rcx
+    jz      .success
+    mov     rdi, rcx
+    mov     rcx, rdx
+    xor     eax, eax
+    rep stosd
+    ret
+
+.setup:
+    push    rbx
+    push    rbp
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    mov     rbx, rdi                        ; rbx = текущий элемент
+    mov     r12, rdx                        ; r12 = оставшееся количество
+    mov     r13, rcx                        ; r13 = статусы (или NULL)
+
+    ; --- Разбор сдвига один раз на весь пакет ---
+    mov     r14, rsi
+    shr     r14, 6                          ; r14 = word_shift
+    mov     ecx, esi
+    and     ecx, 63
+    mov     r15, rcx                        ; r15 = bit_shift
+    mov     rbp, -1
+    shr     rbp, cl
+    not     rbp                             ; rbp = маска для старших битов
+    PREFETCH_BIGNUM rbx + BIGNUM_SIZE       ; Элемент 1; дальше — в цикле
+
+.loop:
+    PREFETCH_BIGNUM rbx + BATCH_PREFETCH_AHEAD * BIGNUM_SIZE
+    xor     eax, eax                        ; Статус по умолчанию: SUCCESS (len == 0)
+    mov     edx, [rbx + BIGNUM_LEN_OFFSET]
+    test    edx, edx
+    jz      .store
+    mov     rdi, rbx
+    mov     r9, r14
+    mov     r11, r15
+    mov     r8, rbp
+    call    bignum_shift_right.decoded
+
+.store:
+    test    r13, r13
+    jz      .next
+    mov     [r13], eax
+    add     r13, 4
+.next:
+    add     rbx, BIGNUM_SIZE
+    dec     r12
+    jnz     .loop
+
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbp
+    pop     rbx
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Пакетный сдвиг чисел по массиву указателей на одну величину.
+; @param      rdi: bignum_t* const* nums - Массив из count указателей на числа
+;             (например, слоты bignum_pool_t).
+; @param      rsi: size_t shift_amount - Величина сдвига для всех элементов.
+; @param      rdx: size_t count - Количество элементов.
+; @param      rcx: bignum_shift_right_status_t* statuses - Массив статусов или NULL.
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG, если nums NULL при count > 0).
+; @note       Как bignum_shift_right_batch_uniform, но числа не обязаны идти
+;             подряд: сдвиг разбирается один раз, элемент входит сразу в
+;             bignum_shift_right.decoded, а все строки кэша числа элемента
+;             i + BATCH_PREFETCH_AHEAD предзагружаются до обработки элемента i.
+;             NULL-элемент получает статус ERROR_NULL_ARG.
+; @version    1.0.39
+; =============================================================================
+bignum_shift_right_batch_ptr:
+    test    rdx, rdx
+    jz      .success                        ; Пустой пакет — успех
+    test    rdi, rdi
+    jz      .error_null_arg
+
+    push    rbx
+    push    rbp
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    mov     rbx, rdi                        ; rbx = текущий указатель в массиве
+    mov     r12, rdx                        ; r12 = оставшееся количество
+    mov     r13, rcx                        ; r13 = статусы (или NULL)
+
+    ; --- Разбор сдвига один раз на весь пакет ---
+    mov     r14, rsi
+    shr     r14, 6                          ; r14 = word_shift
+    mov     ecx, esi
+    and     ecx, 63
+    mov     r15, rcx                        ; r15 = bit_shift
+    mov     rbp, -1
+    shr     rbp, cl
+    not     rbp                             ; rbp = маска для старших битов
+    cmp     r12, 1
+    je      .loop
+    mov     rax, [rbx + 8]                  ; Число элемента 1 (NULL prefetch не страшен)
+    PREFETCH_BIGNUM rax
+
+.loop:
+    mov     rdi, [rbx]                      ; rdi = текущее число
+    cmp     r12, BATCH_PREFETCH_AHEAD
+    jbe     .current                        ; Указателя i + AHEAD в массиве нет
+    mov     rax, [rbx + BATCH_PREFETCH_AHEAD * 8]
+    PREFETCH_BIGNUM rax
+
+.current:
+    mov     rax, -1                         ; Статус NULL-элемента: ERROR_NULL_ARG
+    test    rdi, rdi
+    jz      .store
+    xor     eax, eax                        ; Статус по умолчанию: SUCCESS (len == 0, shift == 0)
+    mov     edx, [rdi + BIGNUM_LEN_OFFSET]
+    test    edx, edx
+    jz      .store
+    mov     rcx, r14
+    or      rcx, r15
+    jz      .store
+    mov     r9, r14
+    mov     r11, r15
+    mov     r8, rbp
+    call    bignum_shift_right.decoded
+
+.store:
+    test    r13, r13
+    jz      .next
+    mov     [r13], eax
+    add     r13, 4
+.next:
+    add     rbx, 8
+    dec     r12
+    jnz     .loop
+
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbp
+    pop     rbx
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Сдвигает вправо пакет чисел в формате SoA (bignum_soa_t) на одну величину.
+; @param      rdi: bignum_soa_t* soa - Пакет: слово i числа j — words[i * count + j].
+; @param      rsi: size_t shift_amount - Количество бит для сдвига каждого числа.
+; @return     rax: Код состояния: 0 (SUCCESS), 1 (ZEROED — все числа пакета стали 0),
+;             -1 (ERROR_NULL_ARG).
+; @note       Строка i (count слов подряд) вычисляется из строк i + word_shift и
+;             i + word_shift + 1 независимо по числам, поэтому векторы идут поперек
+;             чисел: 8 (AVX-512F, хвост маской k1) или 4 (AVX2) числа за инструкцию.
+;             Ядро строк выбирается по bit_shift_kernel_id (VBMI2 — как AVX-512F).
+; @note       Строки обрабатываются снизу вверх; строка i пишется после чтения
+;             строк i + word_shift и i + word_shift + 1, поэтому сдвиг на месте
+;             безопасен. Освободившиеся word_shift строк обнуляются, затем len
+;             уменьшается, пока старшая строка целиком нулевая.
+; @version    1.0.31
+; =============================================================================
+bignum_shift_right_soa:
+    test    rdi, rdi
+    jz      .error_null_arg
+    cmp     qword [rdi + SOA_WORDS_OFFSET], 0
+    je      .error_null_arg
+    cmp     qword [rdi + SOA_COUNT_OFFSET], 0
+    je      .success
+    cmp     qword [rdi + SOA_LEN_OFFSET], 0
+    je      .success
+    test    rsi, rsi
+    jz      .success
+
+    push    rbx
+    push    r12
+    push    r13
+    push    r14
+    push    r15
+    mov     r14, rdi                        ; r14 = soa
+    mov     r15d, [rel bit_shift_kernel_id]
+    test    r15d, r15d
+    jnz     .decode
+    call    bit_shift_resolve               ; Первый вызов: выбор ядра по CPUID
+    mov     r15d, [rel bit_shift_kernel_id] ; r15 = идентификатор ядра
+
+.decode:
+    mov     rbx, rsi
+    shr     rbx, 6                          ; rbx = word_shift
+    mov     ecx, esi
+    and     ecx, 63                         ; cl = bit_shift
+    mov     rdx, [r14 + SOA_COUNT_OFFSET]   ; rdx = count
+    mov     rdi, [r14 + SOA_WORDS_OFFSET]   ; rdi = строка результата 0
+    mov     r12, [r14 + SOA_LEN_OFFSET]
+    cmp     rbx, r12
+    jae     .zero_out
+    sub     r12, rbx                        ; r12 = new_len (строк результата)
+    mov     rax, rbx
+    imul    rax, rdx
+    lea     rsi, [rdi + rax * 8]            ; rsi = строка word_shift
+    test    ecx, ecx
+    jnz     .bits
+
+    ; --- bit_shift == 0: перенос new_len строк целиком ---
+    mov     rax, r12
+    imul    rdx, rax                        ; rdx = new_len * count слов
+    call    word_move
+    jmp     .zero_top
+
+.bits:
+    mov     r8, -1
+    shr     r8, cl
+    not     r8                              ; r8 = маска старших бит для bit_shift
+    lea     r13, [rel soa_row_scalar]
+    cmp     r15d, KERNEL_AVX2
+    jb      .rows
+    lea     r13, [rel soa_row_avx2]
+    je      .vector_setup
+    lea     r13, [rel soa_row_avx512]
+.vector_setup:
+    vmovq   xmm0, rcx                       ; xmm0 = bit_shift
+    mov     eax, 64
+    sub     eax, ecx
+    vmovq   xmm1, rax                       ; xmm1 = 64 - bit_shift
+
+.rows:
+    dec     r12                             ; Все строки, кроме старшей
+    jz      .last_row
+.row_loop:
+    lea     r10, [rsi + rdx * 8]            ; Старший сосед — следующая строка
+    call    r13
+    lea     rdi, [rdi + rdx * 8]
+    lea     rsi, [rsi + rdx * 8]
+    dec     r12
+    jnz     .row_loop
+
+.last_row:
+    ; --- Старшая строка: соседа нет (маска 0, сдвиг влево на 64 дает 0) ---
+    mov     r10, rsi
+    xor     r8d, r8d
+    cmp     r15d, KERNEL_AVX2
+    jb      .call_last
+    mov     eax, 64
+    vmovq   xmm1, rax
+.call_last:
+    call    r13
+    cmp     r15d, KERNEL_AVX2
+    jb      .zero_top
+    vzeroupper
+
+.zero_top:
+    ; --- Обнуление освободившихся word_shift строк ---
+    mov     rdx, [r14 + SOA_COUNT_OFFSET]
+    mov     r12, [r14 + SOA_LEN_OFFSET]
+    sub     r12, rbx                        ; r12 = new_len
+    mov     rax, r12
+    imul    rax, rdx
+    mov     rdi, [r14 + SOA_WORDS_OFFSET]
+    lea     r13, [rdi + rax * 8]            ; r13 = строка new_len (конец результата)
+    mov     rcx, rbx
+    imul    rcx, rdx
+    mov     rdi, r13
+    call    word_zero
+
+.trim:
+    ; --- len уменьшается, пока старшая строка нулевая ---
+    test    r12, r12
+    jz      .set_len
+    mov     rcx, rdx
+    neg     rcx                             ; rcx = -count: от начала старшей строки
+.trim_scan:
+    cmp     qword [r13 + rcx * 8], 0
+    jne     .set_len
+    inc     rcx
+    jnz     .trim_scan
+    lea     rax, [rdx * 8]
+    sub     r13, rax                        ; r13 = начало бывшей старшей строки
+    dec     r12
+    jmp     .trim
+
+.set_len:
+    mov     [r14 + SOA_LEN_OFFSET], r12
+    xor     eax, eax
+    test    r12, r12
+    setz    al                              ; 1 (ZEROED), если все числа стали 0
+    jmp     .restore
+
+.zero_out:
+    ; --- Сдвиг не меньше len слов: весь пакет обнуляется ---
+    mov     rcx, r12
+    imul    rcx, rdx
+    call    word_zero
+    mov     qword [r14 + SOA_LEN_OFFSET], 0
+    mov     eax, 1                          ; Код возврата: ZEROED
+
+.restore:
+    pop     r15
+    pop     r14
+    pop     r13
+    pop     r12
+    pop     rbx
+    ret
+
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Переводит массив bignum_t в формат SoA.
+; @param      rdi: bignum_soa_t* soa - Результат; soa->words вмещает
+;             count * BIGNUM_CAPACITY слов.
+; @param      rsi: const bignum_t* nums - Массив из count чисел.
+; @param      rdx: size_t count - Количество чисел.
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG).
+; @note       soa->count = count, soa->len = max(nums[j].len); слова выше
+;             nums[j].len до soa->len заполняются нулями. Числа читаются
+;             последовательно, столбец j пишется с шагом count слов.
+; @version    1.0.31
+; =============================================================================
+bignum_shift_right_soa_pack:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rdx, rdx
+    jz      .empty
+    test    rsi, rsi
+    jz      .error_null_arg
+    mov     r8, [rdi + SOA_WORDS_OFFSET]
+    test    r8, r8
+    jz      .error_null_arg
+
+    ; --- soa->len = max(nums[j].len) ---
+    xor     r9d, r9d
+    mov     rax, rsi
+    mov     rcx, rdx
+.max_len:
+    mov     r10d, [rax + BIGNUM_LEN_OFFSET]
+    cmp     r10, r9
+    cmova   r9, r10
+    add     rax, BIGNUM_SIZE
+    dec     rcx
+    jnz     .max_len
+    mov     [rdi + SOA_COUNT_OFFSET], rdx
+    mov     [rdi + SOA_LEN_OFFSET], r9
+
+    lea     r11, [rdx * 8]                  ; r11 = шаг строки в байтах
+    mov     rdi, r8                         ; rdi = столбец числа j
+.number:
+    mov     r10d, [rsi + BIGNUM_LEN_OFFSET] ; r10 = nums[j].len
+    mov     rax, rdi
+    xor     ecx, ecx
+.copy:
+    cmp     rcx, r10
+    jae     .pad
+    mov     r8, [rsi + rcx * 8]
+    mov     [rax], r8
+    add     rax, r11
+    inc     rcx
+    jmp     .copy
+.pad:
+    cmp     rcx, r9
+    jae     .next
+    mov     qword [rax], 0
+    add     rax, r11
+    inc     rcx
+    jmp     .pad
+.next:
+    add     rsi, BIGNUM_SIZE
+    add     rdi, 8
+    dec     rdx
+    jnz     .number
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.empty:
+    mov     qword [rdi + SOA_COUNT_OFFSET], 0
+    mov     qword [rdi + SOA_LEN_OFFSET], 0
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Переводит пакет SoA обратно в массив bignum_t.
+; @param      rdi: bignum_t* nums - Результат: soa->count чисел.
+; @param      rsi: const bignum_soa_t* soa - Исходный пакет.
+; @return     rax: 0 (SUCCESS), -1 (ERROR_NULL_ARG),
+;             -3 (ERROR_OVERFLOW — soa->len > BIGNUM_CAPACITY, nums не изменены).
+; @note       Длина каждого числа нормализуется отдельно (старшее ненулевое
+;             слово + 1); слова от len до BIGNUM_CAPACITY обнуляются.
+; @version    1.0.31
+; =============================================================================
+bignum_shift_right_soa_unpack:
+    test    rdi, rdi
+    jz      .error_null_arg
+    test    rsi, rsi
+    jz      .error_null_arg
+    mov     rdx, [rsi + SOA_COUNT_OFFSET]   ; rdx = count
+    test    rdx, rdx
+    jz      .success
+    mov     r9, [rsi + SOA_LEN_OFFSET]      ; r9 = len
+    cmp     r9, BIGNUM_CAPACITY
+    ja      .error_overflow
+    mov     r8, [rsi + SOA_WORDS_OFFSET]    ; r8 = столбец числа j
+    test    r8, r8
+    jz      .error_null_arg
+
+    lea     r11, [rdx * 8]                  ; r11 = шаг строки в байтах
+.number:
+    mov     rax, r8
+    xor     ecx, ecx
+    xor     r10d, r10d                      ; r10 = нормализованная длина
+.copy:
+    cmp     rcx, r9
+    jae     .pad
+    mov     rsi, [rax]
+    mov     [rdi + rcx * 8], rsi
+    inc     rcx
+    test    rsi, rsi
+    cmovnz  r10, rcx
+    add     rax, r11
+    jmp     .copy
+.pad:
+    cmp     rcx, BIGNUM_CAPACITY
+    jae     .set_len
+    mov     qword [rdi + rcx * 8], 0
+    inc     rcx
+    jmp     .pad
+.set_len:
+    mov     [rdi + BIGNUM_LEN_OFFSET], r10  ; Все 8 байт: nums могут быть неинициализированы
+    add     rdi, BIGNUM_SIZE
+    add     r8, 8
+    dec     rdx
+    jnz     .number
+
+.success:
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.error_overflow:
+    mov     rax, -3                         ; Код возврата: ERROR_OVERFLOW
+    ret
+
+.error_null_arg:
+    mov     rax, -1                         ; Код возврата: ERROR_NULL_ARG
+    ret
+
+; =============================================================================
+; @brief      Возвращает идентификатор активного ядра побитового сдвига.
+; @return     eax: bignum_shift_right_kernel_t (SCALAR, AVX2, AVX512, AVX512_VBMI2).
+; @note       Если ядро еще не выбрано, выбирает лучшее для текущего CPU.
+; @version    1.0.17
+; =============================================================================
+bignum_shift_right_get_kernel:
+    mov     eax, [rel bit_shift_kernel_id]
+    test    eax, eax
+    jnz     .done
+    call    bit_shift_resolve
+    mov     eax, [rel bit_shift_kernel_id]
+.done:
+    ret
+
+; =============================================================================
+; @brief      Принудительно выбирает ядро побитового сдвига.
+; @param      edi: bignum_shift_right_kernel_t kernel - Ядро или KERNEL_AUTO.
+; @return     rax: 0 (SUCCESS), -2 (ERROR_UNSUPPORTED, если CPU или ОС не
+;             поддерживают ядро); при ошибке активное ядро не меняется.
+; @version    1.0.17
+; =============================================================================
+bignum_shift_right_set_kernel:
+    call    bit_shift_detect                ; eax = маска поддерживаемых ядер
+    test    edi, edi
+    jnz     .explicit
+    bsr     ecx, eax                        ; KERNEL_AUTO: старший поддерживаемый
+    call    bit_shift_install
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.explicit:
+    cmp     edi, KERNEL_AVX512_VBMI2
+    ja      .unsupported
+    bt      eax, edi
+    jnc     .unsupported
+    mov     ecx, edi
+    call    bit_shift_install
+    xor     eax, eax                        ; Код возврата: SUCCESS
+    ret
+
+.unsupported:
+    mov     rax, -2                         ; Код возврата: ERROR_UNSUPPORTED
+    ret
+
+; =============================================================================
+; @brief      Задает порог потоковых записей для сдвигов во внешних буферах.
+; @param      rdi: size_t min_words - Минимальное число слов результата, с
+;             которого используется bit_shift_stream; SIZE_MAX — никогда
+;             (по умолчанию).
+; @return     rax: Предыдущий порог.
+; @version    1.0.28
+; =============================================================================
+bignum_shift_right_set_stream_threshold:
+    mov     rax, [rel bit_shift_stream_min]
+    mov     [rel bit_shift_stream_min], rdi
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Определяет ядра, которые поддерживает текущий CPU и ОС.
+; @return     eax: Битовая маска, бит N установлен, если поддерживается ядро N.
+; @note       Портит rax, r9, r10; rbx, rcx, rdx сохраняются.
+; =============================================================================
+bit_shift_detect:
+    push    rbx
+    push    rcx
+    push    rdx
+    mov     r10d, 1 << KERNEL_SCALAR        ; Скалярное ядро доступно всегда
+
+    xor     eax, eax
+    cpuid
+    cmp     eax, 7
+    jb      .done                           ; Нет leaf 7 — нет AVX2
+
+    mov     eax, 1
+    cpuid
+    and     ecx, (1 << 27) | (1 << 28)      ; OSXSAVE | AVX
+    cmp     ecx, (1 << 27) | (1 << 28)
+    jne     .done
+
+    xor     ecx, ecx
+    xgetbv                                  ; eax = XCR0
+    mov     r9d, eax
+    and     eax, 0x06
+    cmp     eax, 0x06
+    jne     .done                           ; ОС не сохраняет xmm/ymm
+
+    mov     eax, 7
+    xor     ecx, ecx
+    cpuid
+    bt      ebx, 5                          ; AVX2
+    jnc     .done
+    or      r10d, 1 << KERNEL_AVX2
+
+    and     r9d, 0xE6
+    cmp     r9d, 0xE6
+    jne     .done                           ; ОС не сохраняет zmm и k-регистры
+    bt      ebx, 16                         ; AVX-512F
+    jnc     .done
+    bt      ebx, 8                          ; BMI2 (bzhi в расчете масок)
+    jnc     .done
+    or      r10d, 1 << KERNEL_AVX512
+    bt      ecx, 6                          ; AVX-512 VBMI2 (vpshrdvq)
+    jnc     .done
+    or      r10d, 1 << KERNEL_AVX512_VBMI2
+
+.done:
+    mov     eax, r10d
+    pop     rdx
+    pop     rcx
+    pop     rbx
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Выбирает лучшее поддерживаемое ядро и делает его активным.
+; @return     rax: Адрес ядра.
+; @note       Портит rax, r9, r10; остальные регистры сохраняются.
+;             Гонка при первом вызове из нескольких потоков безопасна:
+;             все потоки записывают одно и то же значение.
+; =============================================================================
+bit_shift_resolve:
+    push    rcx
+    call    bit_shift_detect
+    bsr     ecx, eax                        ; ecx = старший поддерживаемый идентификатор
+    call    bit_shift_install
+    pop     rcx
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Делает активным ядро с заданным идентификатором.
+; @param      ecx: Идентификатор поддерживаемого ядра.
+; @return     rax: Адрес ядра.
+; =============================================================================
+bit_shift_install:
+    lea     rax, [rel bit_shift_scalar]
+    cmp     ecx, KERNEL_AVX2
+    jb      .store
+    lea     rax, [rel bit_shift_avx2]
+    je      .store
+    lea     rax, [rel bit_shift_avx512]
+    cmp     ecx, KERNEL_AVX512
+    je      .store
+    lea     rax, [rel bit_shift_avx512_vbmi2]
+.store:
+    mov     [rel bit_shift_kernel_id], ecx
+    mov     [rel bit_shift_kernel], rax
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Перенос слов: dst[i] = src[i] для i < n.
+; @param      rdi: uint64_t* dst.
+; @param      rsi: const uint64_t* src - src > dst или не пересекается с dst.
+; @param      rdx: size_t n - Число слов (>= 1).
+; @note       Копирует снизу вверх блоками по 2 слова (загрузка до записи),
+;             поэтому перекрытие с src > dst безопасно.
+;             rdi, rsi, rdx, r8, r11 сохраняются; портятся rax, rcx, r9, r10, xmm0.
+; =============================================================================
+word_move:
+    cmp     rdx, WORD_REP_MIN_LEN
+    jae     .rep_check
+
+.loop_path:
+    xor     r9d, r9d                        ; r9 = i
+    test    dl, 1
+    jz      .pairs
+    mov     rax, [rsi]                      ; Нечетное n: сначала одно слово
+    mov     [rdi], rax
+    inc     r9
+.pairs:
+    cmp     r9, rdx
+    jae     .done
+.loop:
+    movdqu  xmm0, [rsi + r9 * 8]
+    movdqu  [rdi + r9 * 8], xmm0
+    add     r9, 2
+    cmp     r9, rdx
+    jb      .loop
+.done:
+    ret
+
+.rep_check:
+    mov     rax, rsi
+    sub     rax, rdi
+    cmp     rax, WORD_REP_MIN_DIST * 8
+    jb      .loop_path                      ; Близкое перекрытие: rep movsb медленный
+    mov     r9, rdi
+    mov     r10, rsi
+    lea     rcx, [rdx * 8]
+    rep movsb
+    mov     rdi, r9
+    mov     rsi, r10
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Обнуление слов: dst[i] = 0 для i < n.
+; @param      rdi: uint64_t* dst.
+; @param      rcx: size_t n - Число слов (может быть 0).
+; @note       rdi, rsi, rdx, r8, r10, r11 сохраняются; портятся rax, rcx, r9, xmm0.
+; =============================================================================
+word_zero:
+    cmp     rcx, WORD_REP_MIN_LEN
+    jae     .rep
+
+    pxor    xmm0, xmm0
+    test    cl, 1
+    jz      .pairs
+    dec     rcx
+    mov     qword [rdi + rcx * 8], 0        ; Нечетное n: сначала старшее слово
+.pairs:
+    sub     rcx, 2
+    jb      .done
+.loop:
+    movdqu  [rdi + rcx * 8], xmm0           ; Сверху вниз по 2 слова
+    sub     rcx, 2
+    jae     .loop
+.done:
+    ret
+
+.rep:
+    mov     r9, rdi
+    shl     rcx, 3
+    xor     eax, eax
+    rep stosb
+    mov     rdi, r9
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Побитовый сдвиг больших массивов: выбор потокового ядра по порогу.
+; @param      Как у bit_shift_words.
+; @note       При n >= bit_shift_stream_min — bit_shift_stream, иначе
+;             bit_shift_words. Используется только сдвигами во внешних
+;             буферах: для bignum_t (n <= BIGNUM_CAPACITY) порог недостижим.
+; =============================================================================
+bit_shift_words_large:
+    cmp     rdx, [rel bit_shift_stream_min]
+    jb      bit_shift_words
+
+; =============================================================================
+; @internal
+; @brief      Потоковое ядро побитового сдвига (SSE2, movntdq/movnti).
+; @param      Как у bit_shift_words.
+; @note       Результат пишется в обход кэша (movntdq по 2 слова, movnti для
+;             выравнивающего слова и хвоста), источник подкачивается
+;             prefetchnta на BIT_SHIFT_PREFETCH_DIST байт вперед; в конце
+;             sfence, поэтому после возврата записи видны как обычные.
+;             Загрузки шага выполняются до записи, поэтому src >= dst
+;             безопасно. Контракт регистров — как у остальных ядер.
+; =============================================================================
+bit_shift_stream:
+    xor     r9d, r9d                        ; r9 = i
+    lea     r10, [rdx - 1]                  ; r10 = n - 1: у слов [0, n - 1) есть сосед
+    test    dil, 8
+    jz      .aligned
+    test    r10, r10
+    jz      .last
+    mov     rax, [rsi]                      ; dst не выровнен на 16: одно слово movnti
+    mov     r11, [rsi + 8]
+    shr     rax, cl
+    ror     r11, cl
+    and     r11, r8
+    or      rax, r11
+    movnti  [rdi], rax
+    inc     r9
+
+.aligned:
+    movzx   eax, cl
+    movd    xmm2, eax                       ; xmm2 = s
+    neg     eax
+    add     eax, 64
+    movd    xmm3, eax                       ; xmm3 = 64 - s
+    lea     r11, [r9 + 4]
+    cmp     r11, r10
+    ja      .tail
+
+.loop:
+    prefetchnta [rsi + r9 * 8 + BIT_SHIFT_PREFETCH_DIST]
+    movdqu  xmm0, [rsi + r9 * 8]            ; src[i], src[i + 1]
+    movdqu  xmm1, [rsi + r9 * 8 + 8]        ; src[i + 1], src[i + 2]
+    movdqu  xmm4, [rsi + r9 * 8 + 16]
+    movdqu  xmm5, [rsi + r9 * 8 + 24]       ; src[i + 3], src[i + 4]
+    psrlq   xmm0, xmm2
+    psllq   xmm1, xmm3
+    por     xmm0, xmm1
+    psrlq   xmm4, xmm2
+    psllq   xmm5, xmm3
+    por     xmm4, xmm5
+    movntdq [rdi + r9 * 8], xmm0
+    movntdq [rdi + r9 * 8 + 16], xmm4
+    add     r9, 4
+    lea     r11, [r9 + 4]
+    cmp     r11, r10
+    jbe     .loop
+
+.tail:
+    cmp     r9, r10
+    jae     .last
+.tail_loop:
+    mov     rax, [rsi + r9 * 8]
+    mov     r11, [rsi + r9 * 8 + 8]
+    shr     rax, cl
+    ror     r11, cl
+    and     r11, r8
+    or      rax, r11
+    movnti  [rdi + r9 * 8], rax
+    inc     r9
+    cmp     r9, r10
+    jb      .tail_loop
+
+.last:
+    mov     rax, [rsi + r10 * 8]
+    shr     rax, cl
+    movnti  [rdi + r10 * 8], rax            ; dst[n - 1] = src[n - 1] >> s
+    sfence
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Побитовый сдвиг массива слов: выбор ядра по длине и CPU.
+; @param      rdi: uint64_t* dst - Слова результата.
+; @param      rsi: const uint64_t* src - Исходные слова; src == dst (на месте),
+;             src > dst (сдвиг слов на месте) или не пересекается с dst.
+; @param      rdx: size_t n - Число слов результата (>= 1).
+; @param      cl:  bit_shift (1..63).
+; @param      r8:  Маска старших битов (~(-1 >> bit_shift)).
+; @note       dst[i] = (src[i] >> s) | (src[i + 1] << (64 - s)) для i < n - 1,
+;             dst[n - 1] = src[n - 1] >> s. Слово src[n] не читается.
+;             Контракт всех ядер: rdi, rsi, rdx, rcx, r8 сохраняются,
+;             портятся rax, r9, r10, r11 (и векторные регистры).
+;             Слова обрабатываются снизу вверх, а все загрузки шага выполняются
+;             до записи, поэтому src >= dst безопасно.
+; =============================================================================
+bit_shift_words:
+    cmp     rdx, BIT_SHIFT_VECTOR_MIN_LEN
+    jb      bit_shift_scalar                ; Короткий массив — скалярное ядро
+    mov     rax, [rel bit_shift_kernel]
+    test    rax, rax
+    jz      .resolve
+    jmp     rax
+
+.resolve:
+    call    bit_shift_resolve               ; Первый вызов: выбор ядра по CPUID
+    jmp     rax
+
+; =============================================================================
+; @internal
+; @brief      Скалярное ядро побитового сдвига (ror/and/shr/or).
+; @param      Как у bit_shift_words.
+; @note       .resume — вход из векторных ядер для остатка:
+;             r9 = i (первое необработанное слово), r10 = n - 1, rax = src[i].
+;             При BIGNUM_CAPACITY <= BIT_SHIFT_UNROLL_MAX_CAPACITY ядро полностью
+;             развернуто: шаг j пишет dst'[j] из src'[j + 1], где указатели
+;             dst', src' смещены так, что последний шаг всегда приходится на
+;             слово n - 2. Вход — на шаг CAPACITY - 1 - m (m = n - 1 - i),
+;             все шаги одного размера, поэтому адрес входа — .last - m * size.
+;             Развернутых шагов CAPACITY - 1, поэтому n > CAPACITY (bignum_view_t)
+;             передается циклу bit_shift_scalar_loop; вход .resume из AVX2
+;             (m <= 3) допустим при любом n, если CAPACITY >= 4.
+; =============================================================================
+bit_shift_scalar:
+
+%if BIGNUM_CAPACITY <= BIT_SHIFT_UNROLL_MAX_CAPACITY
+
+    cmp     rdx, BIGNUM_CAPACITY
+    ja      bit_shift_scalar_loop           ; Длиннее развертки: цикл
+    lea     r10, [rdx - 1]                  ; r10 = n - 1 = число пар (слово, сосед)
+    xor     r9d, r9d                        ; r9 = i
+    mov     rax, [rsi]                      ; Загружаем первое слово
+
+.resume:
+    mov     edx, r10d
+    sub     edx, r9d                        ; edx = m = оставшиеся шаги
+    shl     edx, BIT_SHIFT_STEP_SIZE_LOG2
+    lea     r9, [rdi + r10 * 8 - (BIGNUM_CAPACITY - 1) * 8]  ; dst' = dst + (n - CAPACITY) * 8
+    lea     r10, [rsi + r10 * 8 - (BIGNUM_CAPACITY - 1) * 8] ; src' = src + (n - CAPACITY) * 8
+    lea     r11, [rel .last]
+    sub     r11, rdx
+    jmp     r11                             ; Вход на шаг CAPACITY - 1 - m
+
+.steps:
+    ; Шаг j: dst'[j] = (lo >> s) | (ror(src'[j + 1], s) & mask), lo = src'[j].
+    ; Смещения принудительно 32-битные: все шаги ровно BIT_SHIFT_STEP_SIZE байт.
+%assign j 0
+%rep BIGNUM_CAPACITY - 1
+    mov     r11, [dword r10 + j * 8 + 8]
+    mov     rdx, r11
+    ror     rdx, cl
+    and     rdx, r8
+    shr     rax, cl
+    or      rax, rdx
+    mov     [dword r9 + j * 8], rax
+    mov     rax, r11                        ; Старшее слово становится младшим
+%assign j j + 1
+%endrep
+
+.last:
+    shr     rax, cl                         ; Сдвиг самого старшего слова
+    mov     [r9 + (BIGNUM_CAPACITY - 1) * 8], rax
+    lea     rdx, [r9 + BIGNUM_CAPACITY * 8]
+    sub     rdx, rdi
+    shr     rdx, 3                          ; Восстанавливаем rdx = n
+    ret
+
+    ; Проверка при сборке: все шаги имеют размер BIT_SHIFT_STEP_SIZE
+    times (.last - .steps) - (BIGNUM_CAPACITY - 1) * BIT_SHIFT_STEP_SIZE db 0
+    times (BIGNUM_CAPACITY - 1) * BIT_SHIFT_STEP_SIZE - (.last - .steps) db 0
+
+; =============================================================================
+; @internal
+; @brief      Скалярное ядро с циклом x4 для любого n.
+; @param      Как у bit_shift_words.
+; @note       При развернутом bit_shift_scalar используется для n > CAPACITY.
+; =============================================================================
+bit_shift_scalar_loop:
+
+%endif
+
+    lea     r10, [rdx - 1]                  ; r10 = n - 1 = число пар (слово, сосед)
+    xor     r9d, r9d                        ; r9 = i
+    mov     rax, [rsi]                      ; Загружаем первое слово
+
+.resume:
+    mov     edx, r10d
+    sub     edx, r9d
+    test    dl, 3
+    jz      .unrolled_check                 ; Остаток пар кратен 4
+
+.tail:
+    ; Одиночные шаги, пока число оставшихся пар не станет кратно 4
+    mov     r11, [rsi + r9 * 8 + 8]
+    mov     rdx, r11
+    ror     rdx, cl
+    and     rdx, r8
+    shr     rax, cl
+    or      rax, rdx
+    mov     [rdi + r9 * 8], rax
+    mov     rax, r11                        ; Переносим старшее слово в младшее для следующего шага
+    inc     r9
+    mov     edx, r10d
+    sub     edx, r9d
+    test    dl, 3
+    jnz     .tail
+
+.unrolled_check:
+    cmp     r9, r10
+    jae     .last
+
+.unrolled_loop:
+    ; Итерация 1
+    mov     r11, [rsi + r9 * 8 + 8]
+    mov     rdx, r11
+    ror     rdx, cl
+    and     rdx, r8
+    shr     rax, cl
+    or      rax, rdx
+    mov     [rdi + r9 * 8], rax
+
+    ; Итерация 2
+    mov     rax, [rsi + r9 * 8 + 16]
+    mov     rdx, rax
+    ror     rdx, cl
+    and     rdx, r8
+    shr     r11, cl
+    or      r11, rdx
+    mov     [rdi + r9 * 8 + 8], r11
+
+    ; Итерация 3
+    mov     r11, [rsi + r9 * 8 + 24]
+    mov     rdx, r11
+    ror     rdx, cl
+    and     rdx, r8
+    shr     rax, cl
+    or      rax, rdx
+    mov     [rdi + r9 * 8 + 16], rax
+
+    ; Итерация 4
+    mov     rax, [rsi + r9 * 8 + 32]
+    mov     rdx, rax
+    ror     rdx, cl
+    and     rdx, r8
+    shr     r11, cl
+    or      r11, rdx
+    mov     [rdi + r9 * 8 + 24], r11
+
+    add     r9, 4
+    cmp     r9, r10
+    jb      .unrolled_loop
+
+.last:
+    shr     rax, cl                         ; Сдвиг самого старшего слова
+    mov     [rdi + r10 * 8], rax
+    lea     rdx, [r10 + 1]                  ; Восстанавливаем rdx = n
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Ядро побитового сдвига AVX2: 4 слова за итерацию.
+; @param      Как у bit_shift_words, n >= BIT_SHIFT_VECTOR_MIN_LEN.
+; @note       Обрабатывает 4 * floor((n - 1) / 4) младших слов; остаток
+;             и старшее слово — скалярный хвост bit_shift_scalar.resume.
+; =============================================================================
+bit_shift_avx2:
+    vmovq   xmm0, rcx                       ; xmm0 = bit_shift
+    mov     eax, 64
+    sub     eax, ecx
+    vmovq   xmm1, rax                       ; xmm1 = 64 - bit_shift
+
+    lea     r10, [rdx - 1]
+    and     r10, -4                         ; r10 = число слов векторной части (>= 4)
+    xor     r9d, r9d
+
+.loop:
+    vmovdqu ymm2, [rsi + r9 * 8]            ; src[i .. i+3]
+    vmovdqu ymm3, [rsi + r9 * 8 + 8]        ; src[i+1 .. i+4]
+    vpsrlq  ymm2, ymm2, xmm0
+    vpsllq  ymm3, ymm3, xmm1
+    vpor    ymm2, ymm2, ymm3
+    vmovdqu [rdi + r9 * 8], ymm2
+    add     r9, 4
+    cmp     r9, r10
+    jb      .loop
+
+    vzeroupper
+    lea     r10, [rdx - 1]                  ; r10 = n - 1
+    mov     rax, [rsi + r9 * 8]             ; Первое слово скалярного хвоста
+%if BIGNUM_CAPACITY <= BIT_SHIFT_UNROLL_MAX_CAPACITY && BIGNUM_CAPACITY < 4
+    jmp     bit_shift_scalar_loop.resume    ; Развертка короче остатка AVX2
+%else
+    jmp     bit_shift_scalar.resume
+%endif
+
+; =============================================================================
+; @internal
+; @brief      Ядро побитового сдвига AVX-512F: 8 слов за итерацию.
+; @param      Как у bit_shift_words, n >= BIT_SHIFT_VECTOR_MIN_LEN.
+; @note       Последний неполный блок и самое старшее слово обрабатываются
+;             масками: k1 — слова src[i..] в пределах n, k2 — их старшие
+;             соседи src[i+1..] в пределах n. Скалярный хвост не нужен.
+; @note       Если dst и src выровнены на 64 байта (слоты bignum_shift_right_pool,
+;             сдвиг без word_shift), блоки, у которых есть все 8 соседей, идут
+;             без масок: vmovdqa64 для src[i..] и dst, запись — ровно одна строка
+;             кэша. Маски считаются только для последнего блока.
+; =============================================================================
+bit_shift_avx512:
+    vmovq   xmm0, rcx                       ; xmm0 = bit_shift
+    mov     eax, 64
+    sub     eax, ecx
+    vmovq   xmm1, rax                       ; xmm1 = 64 - bit_shift
+    xor     r9d, r9d
+    mov     eax, edi
+    or      eax, esi
+    test    al, 63
+    jnz     .loop                           ; Не выровнены: все блоки с масками
+    lea     r10, [rdx - 1]                  ; r10 = n - 1: полный блок при i + 8 <= n - 1
+    cmp     r10, 8
+    jb      .loop
+
+.aligned_loop:
+    db 0x62, 0xb1, 0xfd, 0x48, 0x6f, 0x14, 0xce ; vmovdqa64 zmm2, [rsi + r9 * 8]
+    db 0x62, 0xb1, 0xfe, 0x48, 0x6f, 0x9c, 0xce, 0x08, 0x00, 0x00, 0x00 ; vmovdqu64 zmm3, [rsi + r9 * 8 + 8]
+    db 0x62, 0xf1, 0xed, 0x48, 0xd3, 0xd0   ; vpsrlq  zmm2, zmm2, xmm0
+    db 0x62, 0xf1, 0xe5, 0x48, 0xf3, 0xd9   ; vpsllq  zmm3, zmm3, xmm1
+    db 0x62, 0xf1, 0xed, 0x48, 0xeb, 0xd3   ; vporq   zmm2, zmm2, zmm3
+    db 0x62, 0xb1, 0xfd, 0x48, 0x7f, 0x14, 0xcf ; vmovdqa64 [rdi + r9 * 8], zmm2
+    add     r9, 8
+    lea     r11, [r9 + 8]
+    cmp     r11, r10
+    jbe     .aligned_loop                   ; Остается 1..8 слов — блок с масками
+
+.loop:
+    mov     r10, rdx
+    sub     r10, r9                         ; r10 = осталось слов
+    mov     r11d, 9
+    cmp     r10, r11
+    cmovb   r11d, r10d                      ; r11 = min(осталось, 9)
+    mov     eax, -1
+    bzhi    eax, eax, r11d
+    db 0xc5, 0xf8, 0x92, 0xc8               ; kmovw   k1, eax
+    shr     eax, 1
+    db 0xc5, 0xf8, 0x92, 0xd0               ; kmovw   k2, eax
+    db 0x62, 0xb1, 0xfe, 0xc9, 0x6f, 0x14, 0xce ; vmovdqu64 zmm2{k1}{z}, [rsi + r9 * 8]
+    db 0x62, 0xb1, 0xfe, 0xca, 0x6f, 0x9c, 0xce, 0x08, 0x00, 0x00, 0x00 ; vmovdqu64 zmm3{k2}{z}, [rsi + r9 * 8 + 8]
+    db 0x62, 0xf1, 0xed, 0x48, 0xd3, 0xd0   ; vpsrlq  zmm2, zmm2, xmm0
+    db 0x62, 0xf1, 0xe5, 0x48, 0xf3, 0xd9   ; vpsllq  zmm3, zmm3, xmm1
+    db 0x62, 0xf1, 0xed, 0x48, 0xeb, 0xd3   ; vporq   zmm2, zmm2, zmm3
+    db 0x62, 0xb1, 0xfe, 0x49, 0x7f, 0x14, 0xcf ; vmovdqu64 [rdi + r9 * 8]{k1}, zmm2
+    add     r9, 8
+    cmp     r9, rdx
+    jb      .loop
+
+    vzeroupper
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Ядро побитового сдвига AVX-512 VBMI2: 8 слов за итерацию.
+; @param      Как у bit_shift_words, n >= BIT_SHIFT_VECTOR_MIN_LEN.
+; @note       Структура как у bit_shift_avx512 (включая блоки без масок для
+;             выровненных dst и src), но сдвиг с переносом выполняется одной
+;             инструкцией vpshrdvq (funnel shift).
+; =============================================================================
+bit_shift_avx512_vbmi2:
+    db 0x62, 0xf2, 0xfd, 0x48, 0x7c, 0xc1   ; vpbroadcastq zmm0, rcx
+    xor     r9d, r9d
+    mov     eax, edi
+    or      eax, esi
+    test    al, 63
+    jnz     .loop
+    lea     r10, [rdx - 1]
+    cmp     r10, 8
+    jb      .loop
+
+.aligned_loop:
+    db 0x62, 0xb1, 0xfd, 0x48, 0x6f, 0x14, 0xce ; vmovdqa64 zmm2, [rsi + r9 * 8]
+    db 0x62, 0xb1, 0xfe, 0x48, 0x6f, 0x9c, 0xce, 0x08, 0x00, 0x00, 0x00 ; vmovdqu64 zmm3, [rsi + r9 * 8 + 8]
+    db 0x62, 0xf2, 0xe5, 0x48, 0x73, 0xd0   ; vpshrdvq zmm2, zmm3, zmm0
+    db 0x62, 0xb1, 0xfd, 0x48, 0x7f, 0x14, 0xcf ; vmovdqa64 [rdi + r9 * 8], zmm2
+    add     r9, 8
+    lea     r11, [r9 + 8]
+    cmp     r11, r10
+    jbe     .aligned_loop
+
+.loop:
+    mov     r10, rdx
+    sub     r10, r9                         ; r10 = осталось слов
+    mov     r11d, 9
+    cmp     r10, r11
+    cmovb   r11d, r10d                      ; r11 = min(осталось, 9)
+    mov     eax, -1
+    bzhi    eax, eax, r11d
+    db 0xc5, 0xf8, 0x92, 0xc8               ; kmovw   k1, eax
+    shr     eax, 1
+    db 0xc5, 0xf8, 0x92, 0xd0               ; kmovw   k2, eax
+    db 0x62, 0xb1, 0xfe, 0xc9, 0x6f, 0x14, 0xce ; vmovdqu64 zmm2{k1}{z}, [rsi + r9 * 8]
+    db 0x62, 0xb1, 0xfe, 0xca, 0x6f, 0x9c, 0xce, 0x08, 0x00, 0x00, 0x00 ; vmovdqu64 zmm3{k2}{z}, [rsi + r9 * 8 + 8]
+    db 0x62, 0xf2, 0xe5, 0x48, 0x73, 0xd0   ; vpshrdvq zmm2, zmm3, zmm0
+    db 0x62, 0xb1, 0xfe, 0x49, 0x7f, 0x14, 0xcf ; vmovdqu64 [rdi + r9 * 8]{k1}, zmm2
+    add     r9, 8
+    cmp     r9, rdx
+    jb      .loop
+
+    vzeroupper
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Скалярное ядро строки SoA: dst[j] = a[j] >> bs | b[j] << (64 - bs).
+; @param      rdi: uint64_t* dst - Строка результата (может совпадать с a).
+; @param      rsi: const uint64_t* a - Строка i + word_shift.
+; @param      r10: const uint64_t* b - Строка i + word_shift + 1.
+; @param      rdx: size_t count - Число чисел в строке (>= 1).
+; @param      cl:  bit_shift (1..63); r8 - маска старших бит (0 — без соседа).
+; @note       Векторные ядра дополнительно принимают xmm0 = bit_shift и
+;             xmm1 = 64 - bit_shift (64 — без соседа).
+;             rdi, rsi, rdx, rcx, r8, r10, xmm0, xmm1 сохраняются; портятся
+;             rax, r9, r11, xmm2, xmm3 (и k1).
+; =============================================================================
+soa_row_scalar:
+    xor     r9d, r9d
+.loop:
+    mov     rax, [r10 + r9 * 8]
+    ror     rax, cl
+    and     rax, r8                         ; Младшие bit_shift бит соседа — наверх
+    mov     r11, [rsi + r9 * 8]
+    shr     r11, cl
+    or      r11, rax
+    mov     [rdi + r9 * 8], r11
+    inc     r9
+    cmp     r9, rdx
+    jb      .loop
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Ядро строки SoA на AVX2: 4 числа за итерацию, хвост — скалярный.
+; @param      Как у soa_row_scalar.
+; =============================================================================
+soa_row_avx2:
+    xor     r9d, r9d
+    mov     r11, rdx
+    and     r11, -4                         ; r11 = число слов векторной части
+    jz      .tail
+.loop:
+    vmovdqu ymm2, [rsi + r9 * 8]
+    vmovdqu ymm3, [r10 + r9 * 8]
+    vpsrlq  ymm2, ymm2, xmm0
+    vpsllq  ymm3, ymm3, xmm1
+    vpor    ymm2, ymm2, ymm3
+    vmovdqu [rdi + r9 * 8], ymm2
+    add     r9, 4
+    cmp     r9, r11
+    jb      .loop
+.tail:
+    cmp     r9, rdx
+    jae     .done
+    mov     rax, [r10 + r9 * 8]
+    ror     rax, cl
+    and     rax, r8
+    mov     r11, [rsi + r9 * 8]
+    shr     r11, cl
+    or      r11, rax
+    mov     [rdi + r9 * 8], r11
+    inc     r9
+    jmp     .tail
+.done:
+    ret
+
+; =============================================================================
+; @internal
+; @brief      Ядро строки SoA на AVX-512F: 8 чисел за итерацию, хвост — маской k1.
+; @param      Как у soa_row_scalar.
+; =============================================================================
+soa_row_avx512:
+    xor     r9d, r9d
+.loop:
+    mov     rax, rdx
+    sub     rax, r9                         ; rax = осталось чисел
+    mov     r11d, 8
+    cmp     rax, r11
+    cmovb   r11d, eax                       ; r11 = min(осталось, 8)
+    mov     eax, -1
+    bzhi    eax, eax, r11d
+    db 0xc5, 0xf8, 0x92, 0xc8               ; kmovw   k1, eax
+    db 0x62, 0xb1, 0xfe, 0xc9, 0x6f, 0x14, 0xce ; vmovdqu64 zmm2{k1}{z}, [rsi + r9 * 8]
+    db 0x62, 0x91, 0xfe, 0xc9, 0x6f, 0x1c, 0xca ; vmovdqu64 zmm3{k1}{z}, [r10 + r9 * 8]
+    db 0x62, 0xf1, 0xed, 0x48, 0xd3, 0xd0   ; vpsrlq  zmm2, zmm2, xmm0
+    db 0x62, 0xf1, 0xe5, 0x48, 0xf3, 0xd9   ; vpsllq  zmm3, zmm3, xmm1
+    db 0x62, 0xf1, 0xed, 0x48, 0xeb, 0xd3   ; vporq   zmm2, zmm2, zmm3
+    db 0x62, 0xb1, 0xfe, 0x49, 0x7f, 0x14, 0xcf ; vmovdqu64 [rdi + r9 * 8]{k1}, zmm2
+    add     r9, 8
+    cmp     r9, rdx
+    jb      .loop
+    ret
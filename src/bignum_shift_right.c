@@ -0,0 +1,1099 @@
+/**
+ * @file    bignum_shift_right.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Переносимая реализация логического сдвига bignum_t вправо на C.
+ *
+ * @details
+ *   Собирается вместо bignum_shift_right.asm при `make USE_ASM=no` (и
+ *   автоматически, если asm-исходника нет) и экспортирует тот же набор
+ *   функций с теми же кодами возврата, побочными эффектами и внутренней
+ *   точкой входа bignum_shift_right_segment. Каждая функция повторяет
+ *   ветвления соответствующей процедуры asm (имена вспомогательных
+ *   функций совпадают с метками asm), поэтому оба варианта проходят одни
+ *   и те же тесты, включая сверку с GMP. Без yasm библиотека собирается
+ *   на других архитектурах и под `SAN=thread`.
+ *
+ *   Ядра побитового сдвига (dst[i] = src[i] >> s | src[i + 1] << (64 - s)):
+ *   - bit_shift_scalar — сдвиги 64-битных половин с переносом соседа в
+ *     регистре; компиляторы превращают его в shr/shl/or (не в shrd, от
+ *     которого asm отказался в rev. 15).
+ *   - x86-64 (GCC/Clang): AVX2, AVX-512F и AVX-512 VBMI2 на интринсиках с
+ *     `__attribute__((target))` — собираются при любом -march, ядро
+ *     выбирается при первом сдвиге по __builtin_cpu_supports (CPU и ОС),
+ *     как bit_shift_detect в asm. Потоковое ядро — SSE2 (movntdq/movnti).
+ *   - AArch64: NEON (ushl с отрицательным сдвигом вправо), 4 слова за итерацию.
+ *   Перенос и обнуление слов — memmove/memset libc.
+ *
+ *   bignum_shift_right_ct не содержит ветвлений по секретам (маски вместо
+ *   cmov), но постоянство времени зависит от компилятора: проверяется тем
+ *   же `make test_dudect USE_ASM=no`.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальная версия (по bignum_shift_right.asm rev. 35).
+ *   - rev. 2 (14.10.2026): bignum_shift_right_export_be (по asm rev. 36).
+ *   - rev. 3 (14.10.2026): bignum_shift_right_by и bignum_shift_right_by_nz (по asm rev. 37).
+ *   - rev. 4 (14.10.2026): bignum_shift_right_nz и bignum_shift_right_to_nz (по asm rev. 38).
+ *   - rev. 5 (14.10.2026): Предвыборка всех строк элемента на BATCH_PREFETCH_AHEAD вперед
+ *                          в пакетных функциях (по asm rev. 39).
+ */
+
+#include "bignum_shift_right.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#  define SHIFT_RIGHT_X86 1
+#  include <immintrin.h>
+#  include <x86intrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#  define SHIFT_RIGHT_NEON 1
+#  include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define PREFETCH(p)            __builtin_prefetch((p))
+#  define PRECONDITION_FAILED()  __builtin_trap()   /* ud2 на x86-64, как в asm */
+#else
+#  define PREFETCH(p)            ((void)(p))
+#  define PRECONDITION_FAILED()  abort()
+#endif
+
+/**
+ * Минимальное число слов результата, с которого побитовый сдвиг передается
+ * векторному ядру (как BIT_SHIFT_VECTOR_MIN_LEN в asm).
+ */
+#define BIT_SHIFT_VECTOR_MIN_LEN 8
+/** Дистанция предвыборки источника в потоковом ядре, байт. */
+#define BIT_SHIFT_PREFETCH_DIST  1024
+/** На сколько элементов вперед пакетные функции предзагружают число (как в asm). */
+#define BATCH_PREFETCH_AHEAD     2
+
+const uint64_t bignum_shift_right_capacity = BIGNUM_CAPACITY;
+
+/**
+ * @internal
+ * @brief dst[i] = (src[i] >> s) | (src[i + 1] << (64 - s)), где src[n] = hi.
+ * @note  Используется bignum_shift_right_parallel.c; n >= 1, s = 0..63.
+ */
+void bignum_shift_right_segment(uint64_t* dst, const uint64_t* src, size_t n,
+                                unsigned bit_shift, uint64_t hi);
+
+/**
+ * Ядро побитового сдвига: dst[i] = src[i] >> s | src[i + 1] << (64 - s) для
+ * i < n - 1, dst[n - 1] = src[n - 1] >> s. n >= 1, s = 1..63, dst <= src или
+ * без перекрытия (слово читается до записи слова ниже него).
+ */
+typedef void (*bit_kernel_t)(uint64_t* dst, const uint64_t* src, size_t n, unsigned s);
+
+/** Ядро строки SoA: dst[j] = lo[j] >> s | hi[j] << (64 - s), j < count. */
+typedef void (*soa_row_t)(uint64_t* dst, const uint64_t* lo, const uint64_t* hi, size_t count, unsigned s);
+
+/** Идентификатор выбранного ядра (0 — еще не выбрано). */
+static atomic_int bit_shift_kernel_id;
+/** Порог bit_shift_stream, слов (SIZE_MAX — выключен). */
+static atomic_size_t bit_shift_stream_min = BIGNUM_SHIFT_RIGHT_STREAM_OFF;
+
+/* --- Скалярные ядра --- */
+
+static void bit_shift_scalar(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    uint64_t lo = src[0];
+    for (size_t i = 0; i + 1 < n; ++i) {
+        uint64_t hi = src[i + 1];               // Сосед читается один раз и переносится
+        dst[i] = (lo >> s) | (hi << (64 - s));
+        lo = hi;
+    }
+    dst[n - 1] = lo >> s;
+}
+
+static void soa_row_scalar(uint64_t* dst, const uint64_t* lo, const uint64_t* hi, size_t count, unsigned s) {
+    for (size_t j = 0; j < count; ++j) dst[j] = (lo[j] >> s) | (hi[j] << (64 - s));
+}
+
+/* --- Векторные ядра x86-64 --- */
+
+#ifdef SHIFT_RIGHT_X86
+
+__attribute__((target("avx2")))
+static void bit_shift_avx2(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    const __m128i vs = _mm_cvtsi32_si128((int)s);
+    const __m128i vl = _mm_cvtsi32_si128((int)(64 - s));
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(src + i + 1));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(_mm256_srl_epi64(lo, vs), _mm256_sll_epi64(hi, vl)));
+    }
+    bit_shift_scalar(dst + i, src + i, n - i, s);
+}
+
+__attribute__((target("avx512f")))
+static void bit_shift_avx512(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    const __m128i vs = _mm_cvtsi32_si128((int)s);
+    const __m128i vl = _mm_cvtsi32_si128((int)(64 - s));
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m512i lo = _mm512_loadu_si512((const void*)(src + i));
+        __m512i hi = _mm512_loadu_si512((const void*)(src + i + 1));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_or_si512(_mm512_srl_epi64(lo, vs), _mm512_sll_epi64(hi, vl)));
+    }
+    bit_shift_scalar(dst + i, src + i, n - i, s);
+}
+
+__attribute__((target("avx512f,avx512vbmi2")))
+static void bit_shift_avx512_vbmi2(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    const __m512i vs = _mm512_set1_epi64((long long)s);
+    size_t i = 0;
+    for (; i + 8 < n; i += 8) {
+        __m512i lo = _mm512_loadu_si512((const void*)(src + i));
+        __m512i hi = _mm512_loadu_si512((const void*)(src + i + 1));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_shrdv_epi64(lo, hi, vs)); // vpshrdvq
+    }
+    bit_shift_scalar(dst + i, src + i, n - i, s);
+}
+
+__attribute__((target("avx2")))
+static void soa_row_avx2(uint64_t* dst, const uint64_t* lo, const uint64_t* hi, size_t count, unsigned s) {
+    const __m128i vs = _mm_cvtsi32_si128((int)s);
+    const __m128i vl = _mm_cvtsi32_si128((int)(64 - s));
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(lo + j));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(hi + j));
+        _mm256_storeu_si256((__m256i*)(dst + j), _mm256_or_si256(_mm256_srl_epi64(a, vs), _mm256_sll_epi64(b, vl)));
+    }
+    soa_row_scalar(dst + j, lo + j, hi + j, count - j, s);
+}
+
+__attribute__((target("avx512f")))
+static void soa_row_avx512(uint64_t* dst, const uint64_t* lo, const uint64_t* hi, size_t count, unsigned s) {
+    const __m128i vs = _mm_cvtsi32_si128((int)s);
+    const __m128i vl = _mm_cvtsi32_si128((int)(64 - s));
+    size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m512i a = _mm512_loadu_si512((const void*)(lo + j));
+        __m512i b = _mm512_loadu_si512((const void*)(hi + j));
+        _mm512_storeu_si512((void*)(dst + j), _mm512_or_si512(_mm512_srl_epi64(a, vs), _mm512_sll_epi64(b, vl)));
+    }
+    soa_row_scalar(dst + j, lo + j, hi + j, count - j, s);
+}
+
+/**
+ * Потоковое ядро для внешних буферов: записи movnti до выравнивания dst на
+ * 16 байт, затем movntdq, предвыборка источника prefetchnta, sfence в конце.
+ */
+static void bit_shift_stream(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    const __m128i vs = _mm_cvtsi32_si128((int)s);
+    const __m128i vl = _mm_cvtsi32_si128((int)(64 - s));
+    size_t i = 0;
+    for (; i + 1 < n && ((uintptr_t)(dst + i) & 15); ++i) {
+        _mm_stream_si64((long long*)(dst + i), (long long)((src[i] >> s) | (src[i + 1] << (64 - s))));
+    }
+    for (; i + 2 < n; i += 2) {
+        _mm_prefetch((const char*)(src + i) + BIT_SHIFT_PREFETCH_DIST, _MM_HINT_NTA);
+        __m128i lo = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(src + i + 1));
+        _mm_stream_si128((__m128i*)(dst + i), _mm_or_si128(_mm_srl_epi64(lo, vs), _mm_sll_epi64(hi, vl)));
+    }
+    for (; i + 1 < n; ++i) {
+        _mm_stream_si64((long long*)(dst + i), (long long)((src[i] >> s) | (src[i + 1] << (64 - s))));
+    }
+    _mm_stream_si64((long long*)(dst + n - 1), (long long)(src[n - 1] >> s));
+    _mm_sfence();
+}
+
+#endif /* SHIFT_RIGHT_X86 */
+
+/* --- Векторные ядра AArch64 --- */
+
+#ifdef SHIFT_RIGHT_NEON
+
+static void bit_shift_neon(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    const int64x2_t vr = vdupq_n_s64(-(int64_t)s);      // ushl с отрицательным сдвигом — сдвиг вправо
+    const int64x2_t vl = vdupq_n_s64(64 - (int64_t)s);
+    size_t i = 0;
+    for (; i + 4 < n; i += 4) {
+        uint64x2_t lo0 = vld1q_u64(src + i);
+        uint64x2_t hi0 = vld1q_u64(src + i + 1);
+        uint64x2_t lo1 = vld1q_u64(src + i + 2);
+        uint64x2_t hi1 = vld1q_u64(src + i + 3);
+        vst1q_u64(dst + i, vorrq_u64(vshlq_u64(lo0, vr), vshlq_u64(hi0, vl)));
+        vst1q_u64(dst + i + 2, vorrq_u64(vshlq_u64(lo1, vr), vshlq_u64(hi1, vl)));
+    }
+    bit_shift_scalar(dst + i, src + i, n - i, s);
+}
+
+static void soa_row_neon(uint64_t* dst, const uint64_t* lo, const uint64_t* hi, size_t count, unsigned s) {
+    const int64x2_t vr = vdupq_n_s64(-(int64_t)s);
+    const int64x2_t vl = vdupq_n_s64(64 - (int64_t)s);
+    size_t j = 0;
+    for (; j + 2 <= count; j += 2) {
+        vst1q_u64(dst + j, vorrq_u64(vshlq_u64(vld1q_u64(lo + j), vr), vshlq_u64(vld1q_u64(hi + j), vl)));
+    }
+    soa_row_scalar(dst + j, lo + j, hi + j, count - j, s);
+}
+
+#endif /* SHIFT_RIGHT_NEON */
+
+/* --- Выбор ядра --- */
+
+/** Ядра по идентификатору bignum_shift_right_kernel_t (NULL — нет в этой сборке). */
+static const bit_kernel_t bit_kernels[BIGNUM_SHIFT_RIGHT_KERNEL_NEON + 1] = {
+    [BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR]       = bit_shift_scalar,
+#ifdef SHIFT_RIGHT_X86
+    [BIGNUM_SHIFT_RIGHT_KERNEL_AVX2]         = bit_shift_avx2,
+    [BIGNUM_SHIFT_RIGHT_KERNEL_AVX512]       = bit_shift_avx512,
+    [BIGNUM_SHIFT_RIGHT_KERNEL_AVX512_VBMI2] = bit_shift_avx512_vbmi2,
+#endif
+#ifdef SHIFT_RIGHT_NEON
+    [BIGNUM_SHIFT_RIGHT_KERNEL_NEON]         = bit_shift_neon,
+#endif
+};
+
+/**
+ * @brief  Определяет ядра, которые поддерживают CPU и ОС.
+ * @return Битовая маска: бит N установлен, если поддерживается ядро N.
+ */
+static unsigned bit_shift_detect(void) {
+    unsigned mask = 1u << BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR;
+#ifdef SHIFT_RIGHT_X86
+    // __builtin_cpu_supports учитывает и XCR0: ОС сохраняет состояние ymm/zmm
+    if (__builtin_cpu_supports("avx2")) {
+        mask |= 1u << BIGNUM_SHIFT_RIGHT_KERNEL_AVX2;
+        if (__builtin_cpu_supports("avx512f")) {
+            mask |= 1u << BIGNUM_SHIFT_RIGHT_KERNEL_AVX512;
+            if (__builtin_cpu_supports("avx512vbmi2")) mask |= 1u << BIGNUM_SHIFT_RIGHT_KERNEL_AVX512_VBMI2;
+        }
+    }
+#endif
+#ifdef SHIFT_RIGHT_NEON
+    mask |= 1u << BIGNUM_SHIFT_RIGHT_KERNEL_NEON;   // NEON обязателен в AArch64
+#endif
+    return mask;
+}
+
+/** Старший поддерживаемый идентификатор ядра. */
+static int bit_shift_best(unsigned mask) {
+    int id = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR;
+    for (int k = id; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON; ++k) {
+        if (mask & (1u << k)) id = k;
+    }
+    return id;
+}
+
+/** Активное ядро; при первом вызове выбирает лучшее для CPU. */
+static int bit_shift_kernel(void) {
+    int id = atomic_load_explicit(&bit_shift_kernel_id, memory_order_relaxed);
+    if (id == 0) {
+        id = bit_shift_best(bit_shift_detect());
+        atomic_store_explicit(&bit_shift_kernel_id, id, memory_order_relaxed);
+    }
+    return id;
+}
+
+/** Побитовый сдвиг n слов: короткие — скалярно, остальные — выбранным ядром. */
+static void bit_shift_words(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+    if (n < BIT_SHIFT_VECTOR_MIN_LEN) {
+        bit_shift_scalar(dst, src, n, s);
+    } else {
+        bit_kernels[bit_shift_kernel()](dst, src, n, s);
+    }
+}
+
+/** Побитовый сдвиг во внешнем буфере: с порога bit_shift_stream_min — потоковым ядром. */
+static void bit_shift_words_large(uint64_t* dst, const uint64_t* src, size_t n, unsigned s) {
+#ifdef SHIFT_RIGHT_X86
+    if (n >= atomic_load_explicit(&bit_shift_stream_min, memory_order_relaxed)) {
+        bit_shift_stream(dst, src, n, s);
+        return;
+    }
+#endif
+    bit_shift_words(dst, src, n, s);
+}
+
+/** Перенос n слов вниз (dst <= src, перекрытие допустимо). */
+static inline void word_move(uint64_t* dst, const uint64_t* src, size_t n) {
+    memmove(dst, src, n * sizeof(uint64_t));
+}
+
+/** Обнуление n слов. */
+static inline void word_zero(uint64_t* dst, size_t n) {
+    memset(dst, 0, n * sizeof(uint64_t));
+}
+
+/* --- Общий путь bignum_shift_right --- */
+
+/**
+ * @brief  Сдвиг с уже разобранной величиной (bignum_shift_right.decoded в asm).
+ * @param  len  Исходная длина (может быть 0 только у unchecked).
+ * @param  ws   word_shift.
+ * @param  bs   bit_shift.
+ */
+static bignum_shift_right_status_t shift_decoded(bignum_t* restrict num, size_t len, size_t ws, unsigned bs) {
+    uint64_t* w = num->words;
+    if (ws >= len) {
+        word_zero(w, len);
+        num->len = 0;
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+    size_t n = len - ws;
+    if (bs) {
+        bit_shift_words(w, w + ws, n, bs);
+    } else {
+        word_move(w, w + ws, n);
+    }
+    word_zero(w + n, ws);
+    // Сдвиг < 64 бит уменьшает длину нормализованного числа не больше чем на 1 слово
+    if (w[n - 1] == 0) --n;
+    num->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/** Сдвиг по num != NULL (bignum_shift_right.entry в asm). */
+static bignum_shift_right_status_t shift_entry(bignum_t* restrict num, size_t shift_amount) {
+    size_t len = num->len;
+    if (len == 0 || shift_amount == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    return shift_decoded(num, len, shift_amount / 64, (unsigned)(shift_amount % 64));
+}
+
+/** Сдвиг без обнуления слов за новым len (bignum_shift_right_nz.entry в asm). */
+static bignum_shift_right_status_t shift_entry_nz(bignum_t* restrict num, size_t shift_amount) {
+    size_t len = num->len;
+    if (len == 0 || shift_amount == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    uint64_t* w = num->words;
+    if (ws >= len) {
+        num->len = 0;                               // bignum_shift_right.zero_len: слова не очищаются
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+    size_t n = len - ws;
+    if (bs) {
+        bit_shift_words(w, w + ws, n, bs);
+    } else {
+        word_move(w, w + ws, n);
+    }
+    if (w[n - 1] == 0) --n;
+    num->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+#ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT
+
+/** Счетчики потока (bignum_shift_right_stats.c). */
+void bignum_shift_right_stats_record(size_t len, size_t shift_amount, uint64_t cycles);
+
+bignum_shift_right_status_t bignum_shift_right(bignum_t* restrict num, size_t shift_amount) {
+    size_t len = num ? num->len : SIZE_MAX;
+    uint64_t cycles = 0;
+#if defined(BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES) && defined(SHIFT_RIGHT_X86)
+    unsigned aux;
+    _mm_lfence();
+    uint64_t start = __rdtsc();
+#endif
+    bignum_shift_right_status_t status = num ? shift_entry(num, shift_amount) : BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+#if defined(BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES) && defined(SHIFT_RIGHT_X86)
+    cycles = __rdtscp(&aux) - start;                // rdtscp ждет завершения сдвига
+#endif
+    bignum_shift_right_stats_record(len, shift_amount, cycles);
+    return status;
+}
+
+#else
+
+bignum_shift_right_status_t bignum_shift_right(bignum_t* restrict num, size_t shift_amount) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    return shift_entry(num, shift_amount);
+}
+
+#endif /* BIGNUM_SHIFT_RIGHT_INSTRUMENT */
+
+/* bignum_shift_right_unchecked может быть макросом (BIGNUM_SHIFT_RIGHT_DEBUG) */
+void (bignum_shift_right_unchecked)(bignum_t* restrict num, size_t shift_amount) {
+#ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    if (!num || num->len > BIGNUM_CAPACITY || (num->len != 0 && num->words[num->len - 1] == 0)) {
+        PRECONDITION_FAILED();
+    }
+#endif
+    shift_decoded(num, num->len, shift_amount / 64, (unsigned)(shift_amount % 64));
+}
+
+bignum_shift_right_status_t bignum_shift_right_bits_only(bignum_t* restrict num, size_t bits) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+#ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    if (bits - 1 > 62) PRECONDITION_FAILED();
+#endif
+    size_t n = num->len;
+    if (n == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    bit_shift_words(num->words, num->words, n, (unsigned)bits);
+    if (num->words[n - 1] == 0) --n;
+    num->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_words_only(bignum_t* restrict num, size_t shift_amount) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+#ifdef BIGNUM_SHIFT_RIGHT_DEBUG
+    if (shift_amount % 64 != 0) PRECONDITION_FAILED();
+#endif
+    size_t len = num->len;
+    if (len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    return shift_decoded(num, len, shift_amount / 64, 0);
+}
+
+bignum_shift_right_status_t bignum_shift_right_by(bignum_t* num, const bignum_t* amount) {
+    if (!num || !amount) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t alen = amount->len;
+    if (alen == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (alen == 1) return shift_entry(num, amount->words[0]);
+    size_t len = num->len;                          // Насыщение: amount >= 2^64
+    if (len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    word_zero(num->words, len);
+    num->len = 0;
+    return BIGNUM_SHIFT_RIGHT_ZEROED;
+}
+
+bignum_shift_right_status_t bignum_shift_right_by_nz(bignum_t* num, const bignum_t* amount) {
+    if (!num || !amount) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t alen = amount->len;
+    if (alen == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (alen == 1) return shift_entry_nz(num, amount->words[0]);
+    if (num->len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    num->len = 0;                                   // Насыщение: amount >= 2^64, слова не очищаются
+    return BIGNUM_SHIFT_RIGHT_ZEROED;
+}
+
+bignum_shift_right_status_t bignum_shift_right_nz(bignum_t* restrict num, size_t shift_amount) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    return shift_entry_nz(num, shift_amount);
+}
+
+/* --- Арифметический сдвиг и сдвиг со знаком --- */
+
+/** sar(x, s) без реализационно-определенного сдвига отрицательного int64_t. */
+static inline uint64_t sar64(uint64_t x, unsigned s) {
+    uint64_t sign = 0 - (x >> 63);
+    return (x >> s) | ((sign << (63 - s)) << 1);    // При s = 0 второе слагаемое — 0
+}
+
+bignum_shift_right_status_t bignum_shift_right_arith(bignum_t* restrict num, size_t shift_amount) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = num->len;
+    if (len == 0 || shift_amount == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    uint64_t* w = num->words;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+
+    if (ws >= len) {
+        // Все значащие биты ушли: результат 0 или -1
+        uint64_t sign = 0 - (w[len - 1] >> 63);
+        word_zero(w, len);
+        w[0] = sign;
+        num->len = (size_t)(sign & 1);
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+
+    size_t n = len - ws;
+    if (bs) {
+        uint64_t top = w[len - 1];
+        bit_shift_words(w, w + ws, n, bs);          // Слова как при логическом сдвиге
+        w[n - 1] = sar64(top, bs);
+    } else {
+        word_move(w, w + ws, n);
+    }
+    word_zero(w + n, ws);
+
+    // Нормализация O(1): старшее слово отбрасывается, если оно — только знак
+    uint64_t sign = 0 - (w[n - 1] >> 63);
+    if (w[n - 1] == sign) {
+        if (n == 1) {
+            if (sign == 0) n = 0;                   // -1 остается {~0, len = 1}
+        } else if (((w[n - 2] ^ sign) >> 63) == 0) {
+            w[n - 1] = 0;
+            --n;
+        }
+    }
+    num->len = n;
+    return n <= 1 && w[0] == sign ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/**
+ * @brief  Логический сдвиг влево (num <<= k, k > 0) с контролем переполнения емкости.
+ * @return SUCCESS, ERROR_NULL_ARG или ERROR_OVERFLOW (число не изменено).
+ * @note   Слова обрабатываются сверху вниз, поэтому сдвиг на месте безопасен.
+ */
+static bignum_shift_right_status_t shift_left(bignum_t* restrict num, size_t k) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = num->len;
+    if (len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;    // 0 << k = 0
+    uint64_t* w = num->words;
+    size_t ws = k / 64;
+    unsigned bs = (unsigned)(k % 64);
+    size_t new_len = len + ws;
+    if (new_len > BIGNUM_CAPACITY) return BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+
+    uint64_t spill = (w[len - 1] >> 1) >> (63 - bs);   // Выдвинутые биты старшего слова (0 при bs = 0)
+    if (spill) {
+        if (new_len == BIGNUM_CAPACITY) return BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+        w[new_len++] = spill;
+    }
+    for (size_t i = len - 1; i > 0; --i) {
+        w[i + ws] = (w[i] << bs) | ((w[i - 1] >> 1) >> (63 - bs));
+    }
+    w[ws] = w[0] << bs;
+    word_zero(w, ws);
+    num->len = new_len;
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_signed(bignum_t* restrict num, ptrdiff_t s) {
+    if (s >= 0) return bignum_shift_right(num, (size_t)s);
+    return shift_left(num, 0 - (size_t)s);          // Модуль, в т. ч. 2^63 для PTRDIFF_MIN
+}
+
+/* --- Сдвиг за постоянное время --- */
+
+/** 1, если x != 0, иначе 0 (без ветвлений). */
+static inline uint64_t ct_nonzero(uint64_t x) {
+    return (x | (0 - x)) >> 63;
+}
+
+/** 1, если a < b, иначе 0 (без ветвлений). */
+static inline uint64_t ct_less(uint64_t a, uint64_t b) {
+    return (a ^ ((a ^ b) | ((a - b) ^ b))) >> 63;
+}
+
+bignum_shift_right_status_t bignum_shift_right_ct(bignum_t* num, size_t shift_amount) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    uint64_t* w = num->words;
+    uint64_t len = num->len;
+    uint64_t had_bits = ct_nonzero(len) & ct_nonzero(shift_amount);
+    uint64_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    len &= 0 - ct_less(ws, BIGNUM_CAPACITY);        // word_shift >= CAPACITY: результат 0
+
+    // 1. words[i] = 0 для i >= len
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) w[i] &= 0 - ct_less(i, len);
+
+    // 2. Сдвиг по битам; (x << 1) << (63 - s) при s = 0 дает 0, ветка не нужна
+    for (size_t i = 0; i + 1 < BIGNUM_CAPACITY; ++i) {
+        w[i] = (w[i] >> bs) | ((w[i + 1] << 1) << (63 - bs));
+    }
+    w[BIGNUM_CAPACITY - 1] >>= bs;
+
+    // 3. Сдвиг по словам: ступени d = 1, 2, 4 ... < CAPACITY
+    for (size_t d = 1; d < BIGNUM_CAPACITY; d *= 2) {
+        uint64_t take = 0 - ct_nonzero(ws & d);
+        for (size_t i = 0; i + d < BIGNUM_CAPACITY; ++i) w[i] = (w[i] & ~take) | (w[i + d] & take);
+        for (size_t i = BIGNUM_CAPACITY - d; i < BIGNUM_CAPACITY; ++i) w[i] &= ~take;
+    }
+
+    // 4. len = старшее ненулевое слово + 1
+    uint64_t new_len = 0;
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) {
+        uint64_t nz = 0 - ct_nonzero(w[i]);
+        new_len = (new_len & ~nz) | ((i + 1) & nz);
+    }
+    num->len = (size_t)new_len;
+    return (bignum_shift_right_status_t)(had_bits & (1 - ct_nonzero(new_len)));
+}
+
+/* --- Сдвиг вне места и во внешних буферах --- */
+
+bignum_shift_right_status_t bignum_shift_right_to(bignum_t* dst, const bignum_t* src, size_t shift_amount) {
+    if (!dst || !src) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (dst == src) return shift_entry(dst, shift_amount);
+    size_t len = src->len;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (ws >= len) {
+        // Все слова уходят (в т. ч. len == 0)
+        word_zero(dst->words, BIGNUM_CAPACITY);
+        dst->len = 0;
+        return len != 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+    size_t n = len - ws;
+    if (bs) {
+        bit_shift_words(dst->words, src->words + ws, n, bs);
+    } else {
+        word_move(dst->words, src->words + ws, n);
+    }
+    word_zero(dst->words + n, BIGNUM_CAPACITY - n);
+    if (dst->words[n - 1] == 0) --n;
+    dst->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_to_nz(bignum_t* dst, const bignum_t* src, size_t shift_amount) {
+    if (!dst || !src) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (dst == src) return shift_entry_nz(dst, shift_amount);
+    size_t len = src->len;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (ws >= len) {
+        dst->len = 0;                               // Только len: слова не очищаются
+        return len != 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+    size_t n = len - ws;
+    if (bs) {
+        bit_shift_words(dst->words, src->words + ws, n, bs);
+    } else {
+        word_move(dst->words, src->words + ws, n);
+    }
+    if (dst->words[n - 1] == 0) --n;
+    dst->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_view(bignum_view_t* restrict view, size_t shift_amount) {
+    if (!view) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = view->len;
+    if (len == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;    // Пустое число: words может быть NULL
+    uint64_t* w = view->words;
+    if (!w) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (shift_amount == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (ws >= len) {
+        word_zero(w, len);
+        view->len = 0;
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+    size_t n = len - ws;
+    if (bs) {
+        bit_shift_words_large(w, w + ws, n, bs);
+    } else {
+        word_move(w, w + ws, n);
+    }
+    word_zero(w + n, ws);                           // Слова [len, cap) не трогаются
+    if (w[n - 1] == 0) --n;
+    view->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+void bignum_shift_right_segment(uint64_t* dst, const uint64_t* src, size_t n,
+                                unsigned bit_shift, uint64_t hi) {
+    if (bit_shift == 0) {
+        word_move(dst, src, n);
+        return;
+    }
+    bit_shift_words_large(dst, src, n, bit_shift);
+    dst[n - 1] |= hi << (64 - bit_shift);           // Биты соседа в старшее слово отрезка
+}
+
+bignum_shift_right_status_t bignum_shift_right_extract_bits(bignum_t* dst, const bignum_t* src,
+                                                            size_t lo, size_t width) {
+    if (!dst || !src) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = src->len;
+    size_t ws = lo / 64;
+    unsigned bs = (unsigned)(lo % 64);
+    size_t m = width / 64 + (width % 64 != 0);      // Слов в окне
+    size_t e = 0;
+    if (ws < len) {
+        size_t avail = len - ws;
+        e = m < avail ? m : avail;
+        if (e != 0) {
+            if (bs) {
+                // На слово больше, если оно есть: старшее слово окна получает его биты
+                bit_shift_words(dst->words, src->words + ws, e + (e < avail), bs);
+            } else {
+                word_move(dst->words, src->words + ws, e);
+            }
+            // Неполное старшее слово маскируется, только если окно не выходит за len
+            if (width % 64 != 0 && e > width / 64) dst->words[e - 1] &= ~(~0ULL << (width % 64));
+        }
+    }
+    word_zero(dst->words + e, BIGNUM_CAPACITY - e);  // В т. ч. лишнее слово ядра
+    // Окно может начинаться с нулевых слов, поэтому цикл
+    while (e != 0 && dst->words[e - 1] == 0) --e;
+    dst->len = e;
+    return e == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/** Слово результата из пары соседних слов (s == 0: hi не участвует). */
+static inline uint64_t shift_pair(uint64_t lo, uint64_t hi, unsigned s) {
+    return (lo >> s) | ((hi << 1) << (63 - s));
+}
+
+/** Записывает x в 8 байт p, старший байт первым (bswap + mov, movbe при -mmovbe). */
+static inline void store_be64(uint8_t* p, uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    x = __builtin_bswap64(x);
+    memcpy(p, &x, sizeof(x));
+#else
+    for (int i = 7; i >= 0; --i) {
+        p[i] = (uint8_t)x;
+        x >>= 8;
+    }
+#endif
+}
+
+/** Номер старшего единичного бита ненулевого слова. */
+static inline unsigned bsr64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(x);
+#else
+    unsigned n = 0;
+    while (x >>= 1) ++n;
+    return n;
+#endif
+}
+
+bignum_shift_right_status_t bignum_shift_right_export_be(const bignum_t* src, size_t shift_amount,
+                                                         uint8_t* out, size_t out_len) {
+    if (!src || (!out && out_len != 0)) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = src->len;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    size_t pos = out_len;                           // Незаписанные байты out[0 .. pos)
+    if (ws < len) {
+        const uint64_t* w = src->words + ws;
+        size_t m = len - ws;
+        size_t n = m;                               // Слов результата
+        uint64_t top = w[m - 1] >> bs;              // У старшего слова нет соседа
+        if (top == 0 && --n != 0) top = shift_pair(w[n - 1], w[n], bs);
+        if (n != 0) {
+            // Значащие байты считаются до записи: при переполнении out не изменяется
+            if ((n - 1) * 8 + bsr64(top) / 8 + 1 > out_len) return BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t word = shift_pair(w[i], i + 1 < m ? w[i + 1] : 0, bs);
+                if (pos >= 8) {
+                    pos -= 8;
+                    store_be64(out + pos, word);
+                } else {
+                    // Старшее слово в неполные pos байт: его значащие байты помещаются
+                    while (pos != 0) {
+                        out[--pos] = (uint8_t)word;
+                        word >>= 8;
+                    }
+                }
+            }
+            if (pos != 0) memset(out, 0, pos);
+            return BIGNUM_SHIFT_RIGHT_SUCCESS;
+        }
+    }
+    if (pos != 0) memset(out, 0, pos);
+    return len != 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/* --- Сдвиг с выпавшими битами, ctz и округление --- */
+
+bignum_shift_right_status_t bignum_shift_right_rem(bignum_t* restrict num, size_t shift_amount,
+                                                   bignum_t* restrict rem) {
+    if (!num || !rem) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    size_t m = ws + (bs != 0);
+    if (m > num->len) m = num->len;
+    if (m != 0) {
+        word_move(rem->words, num->words, m);
+        if (ws < m) rem->words[m - 1] &= ~(~0ULL << bs);    // Неполное слово words[word_shift]
+    }
+    // Младшие слова могут быть нулевыми, поэтому цикл
+    while (m != 0 && rem->words[m - 1] == 0) --m;
+    rem->len = m;
+    word_zero(rem->words + m, BIGNUM_CAPACITY - m);
+    return shift_entry(num, shift_amount);
+}
+
+bignum_shift_right_status_t bignum_shift_right_sticky(bignum_t* restrict num, size_t shift_amount,
+                                                      uint64_t* restrict dropped) {
+    if (!num || !dropped) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    const uint64_t* w = num->words;
+    size_t len = num->len;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    uint64_t top = 0;                               // Старшие 64 выпавших бита
+    uint64_t low = 0;                               // OR более младших выпавших бит
+    if (ws == 0) {
+        if (bs != 0 && len != 0) top = w[0] << (64 - bs);
+    } else if (ws > len) {
+        low = len;                                  // Все биты числа младше 64 старших выпавших
+    } else {
+        uint64_t lo = w[ws - 1];
+        uint64_t hi = ws < len ? w[ws] : 0;
+        if (bs != 0) {
+            low = lo << (64 - bs);
+            top = (lo >> bs) | (hi << (64 - bs));
+        } else {
+            top = lo;
+        }
+        for (size_t i = 0; i + 1 < ws; ++i) low |= w[i];
+    }
+    *dropped = top | (low != 0);
+    return shift_entry(num, shift_amount);
+}
+
+/** Число младших нулевых бит ненулевого слова. */
+static inline unsigned ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+bignum_shift_right_status_t bignum_shift_right_ctz(bignum_t* restrict num, size_t* restrict shifted_out) {
+    if (!num || !shifted_out) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = num->len;
+    size_t ws = 0;
+    while (ws < len && num->words[ws] == 0) ++ws;
+    if (ws == len) {
+        *shifted_out = 0;
+        word_zero(num->words, len);
+        num->len = 0;
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+    unsigned bs = ctz64(num->words[ws]);
+    *shifted_out = ws * 64 + bs;
+    if (*shifted_out == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;  // Нечетное число не переписывается
+    return shift_decoded(num, len, ws, bs);
+}
+
+bignum_shift_right_status_t bignum_shift_right_round(bignum_t* restrict num, size_t shift_amount,
+                                                     bignum_shift_right_round_t mode) {
+    if (!num) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if ((unsigned)mode > BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN) return BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED;
+    uint64_t dropped;
+    bignum_shift_right_status_t status = bignum_shift_right_sticky(num, shift_amount, &dropped);
+    int increment;
+    switch (mode) {
+    case BIGNUM_SHIFT_RIGHT_ROUND_CEIL:
+        increment = dropped != 0;
+        break;
+    case BIGNUM_SHIFT_RIGHT_ROUND_HALF_UP:
+        increment = (int)(dropped >> 63);
+        break;
+    case BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN:
+        // Больше половины или ровно половина при нечетном результате
+        increment = (dropped >> 63) && ((dropped << 1) != 0 || (num->words[0] & 1));
+        break;
+    default:
+        increment = 0;
+        break;
+    }
+    if (!increment) return status;
+    // num += 1 с переносом; результат не больше исходного числа
+    size_t i = 0;
+    while (++num->words[i] == 0) ++i;
+    if (i + 1 > num->len) num->len = i + 1;         // 0 + 1 или перенос в новое слово
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/* --- Пакетные функции --- */
+
+/**
+ * Предзагружает все строки кэша числа (слова и len), как PREFETCH_BIGNUM в
+ * asm: каждые 64 байта и последний байт — число в массиве не выровнено на строку.
+ */
+static inline void prefetch_bignum(const bignum_t* num) {
+    const char* p = (const char*)num;
+    for (size_t off = 0; off < sizeof(bignum_t); off += 64) PREFETCH(p + off);
+    PREFETCH(p + sizeof(bignum_t) - 1);
+}
+
+bignum_shift_right_status_t bignum_shift_right_batch(bignum_t* restrict nums,
+                                                     const size_t* restrict shifts,
+                                                     size_t count,
+                                                     bignum_shift_right_status_t* restrict statuses) {
+    if (count == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (!nums || !shifts) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (count > 1) prefetch_bignum(&nums[1]);       // Элемент 1; дальше — в цикле
+    for (size_t i = 0; i < count; ++i) {
+        if (i + BATCH_PREFETCH_AHEAD < count) prefetch_bignum(&nums[i + BATCH_PREFETCH_AHEAD]);
+        bignum_shift_right_status_t status = shift_entry(&nums[i], shifts[i]);
+        if (statuses) statuses[i] = status;
+    }
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_batch_uniform(bignum_t* restrict nums,
+                                                             size_t shift_amount,
+                                                             size_t count,
+                                                             bignum_shift_right_status_t* restrict statuses) {
+    if (count == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (!nums) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (shift_amount == 0) {
+        // Числа не меняются, все статусы SUCCESS
+        if (statuses) {
+            for (size_t i = 0; i < count; ++i) statuses[i] = BIGNUM_SHIFT_RIGHT_SUCCESS;
+        }
+        return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+    // Разбор сдвига один раз на весь пакет
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (count > 1) prefetch_bignum(&nums[1]);
+    for (size_t i = 0; i < count; ++i) {
+        if (i + BATCH_PREFETCH_AHEAD < count) prefetch_bignum(&nums[i + BATCH_PREFETCH_AHEAD]);
+        size_t len = nums[i].len;
+        bignum_shift_right_status_t status =
+            len == 0 ? BIGNUM_SHIFT_RIGHT_SUCCESS : shift_decoded(&nums[i], len, ws, bs);
+        if (statuses) statuses[i] = status;
+    }
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_batch_ptr(bignum_t* const* restrict nums,
+                                                         size_t shift_amount,
+                                                         size_t count,
+                                                         bignum_shift_right_status_t* restrict statuses) {
+    if (count == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    if (!nums) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (count > 1 && nums[1]) prefetch_bignum(nums[1]);
+    for (size_t i = 0; i < count; ++i) {
+        bignum_t* num = nums[i];
+        if (i + BATCH_PREFETCH_AHEAD < count && nums[i + BATCH_PREFETCH_AHEAD]) {
+            prefetch_bignum(nums[i + BATCH_PREFETCH_AHEAD]);  // Число элемента i + AHEAD
+        }
+        bignum_shift_right_status_t status;
+        if (!num) {
+            status = BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+        } else if (num->len == 0 || shift_amount == 0) {
+            status = BIGNUM_SHIFT_RIGHT_SUCCESS;
+        } else {
+            status = shift_decoded(num, num->len, ws, bs);
+        }
+        if (statuses) statuses[i] = status;
+    }
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/* --- Пакеты SoA --- */
+
+bignum_shift_right_status_t bignum_shift_right_soa(bignum_soa_t* soa, size_t shift_amount) {
+    if (!soa || !soa->words) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t count = soa->count;
+    size_t len = soa->len;
+    if (count == 0 || len == 0 || shift_amount == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    uint64_t* w = soa->words;
+    size_t ws = shift_amount / 64;
+    unsigned bs = (unsigned)(shift_amount % 64);
+    if (ws >= len) {
+        // Сдвиг не меньше len слов: весь пакет обнуляется
+        word_zero(w, len * count);
+        soa->len = 0;
+        return BIGNUM_SHIFT_RIGHT_ZEROED;
+    }
+
+    size_t n = len - ws;                            // Строк результата
+    const uint64_t* src = w + ws * count;
+    if (bs == 0) {
+        word_move(w, src, n * count);
+    } else {
+        soa_row_t row = soa_row_scalar;
+        int kernel = bit_shift_kernel();
+#ifdef SHIFT_RIGHT_X86
+        if (kernel >= BIGNUM_SHIFT_RIGHT_KERNEL_AVX512) {
+            row = soa_row_avx512;                   // VBMI2 — как AVX-512F
+        } else if (kernel == BIGNUM_SHIFT_RIGHT_KERNEL_AVX2) {
+            row = soa_row_avx2;
+        }
+#endif
+#ifdef SHIFT_RIGHT_NEON
+        if (kernel == BIGNUM_SHIFT_RIGHT_KERNEL_NEON) row = soa_row_neon;
+#endif
+        (void)kernel;
+        // Строки снизу вверх: строка i пишется после чтения строк i + ws и i + ws + 1
+        for (size_t i = 0; i + 1 < n; ++i) {
+            row(w + i * count, src + i * count, src + (i + 1) * count, count, bs);
+        }
+        uint64_t* last = w + (n - 1) * count;       // Старшая строка: соседа нет
+        const uint64_t* last_src = src + (n - 1) * count;
+        for (size_t j = 0; j < count; ++j) last[j] = last_src[j] >> bs;
+    }
+    word_zero(w + n * count, ws * count);
+
+    // len уменьшается, пока старшая строка нулевая
+    while (n != 0) {
+        const uint64_t* top = w + (n - 1) * count;
+        size_t j = 0;
+        while (j < count && top[j] == 0) ++j;
+        if (j < count) break;
+        --n;
+    }
+    soa->len = n;
+    return n == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_soa_pack(bignum_soa_t* restrict soa,
+                                                        const bignum_t* restrict nums, size_t count) {
+    if (!soa) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    if (count == 0) {
+        soa->count = 0;
+        soa->len = 0;
+        return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+    if (!nums || !soa->words) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t len = 0;
+    for (size_t j = 0; j < count; ++j) {
+        if (nums[j].len > len) len = nums[j].len;
+    }
+    soa->count = count;
+    soa->len = len;
+    // Числа читаются последовательно, столбец j пишется с шагом count слов
+    for (size_t j = 0; j < count; ++j) {
+        uint64_t* col = soa->words + j;
+        size_t i = 0;
+        for (; i < nums[j].len; ++i) col[i * count] = nums[j].words[i];
+        for (; i < len; ++i) col[i * count] = 0;
+    }
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+bignum_shift_right_status_t bignum_shift_right_soa_unpack(bignum_t* restrict nums,
+                                                          const bignum_soa_t* restrict soa) {
+    if (!nums || !soa) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    size_t count = soa->count;
+    if (count == 0) return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    size_t len = soa->len;
+    if (len > BIGNUM_CAPACITY) return BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+    if (!soa->words) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    for (size_t j = 0; j < count; ++j) {
+        const uint64_t* col = soa->words + j;
+        size_t norm = 0;                            // Нормализованная длина числа j
+        for (size_t i = 0; i < len; ++i) {
+            uint64_t word = col[i * count];
+            nums[j].words[i] = word;
+            if (word != 0) norm = i + 1;
+        }
+        word_zero(nums[j].words + len, BIGNUM_CAPACITY - len);
+        nums[j].len = norm;
+    }
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+/* --- Выбор ядра и порог потоковых записей --- */
+
+bignum_shift_right_kernel_t bignum_shift_right_get_kernel(void) {
+    return (bignum_shift_right_kernel_t)bit_shift_kernel();
+}
+
+bignum_shift_right_status_t bignum_shift_right_set_kernel(bignum_shift_right_kernel_t kernel) {
+    unsigned mask = bit_shift_detect();
+    int id;
+    if (kernel == BIGNUM_SHIFT_RIGHT_KERNEL_AUTO) {
+        id = bit_shift_best(mask);
+    } else if ((unsigned)kernel <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && (mask & (1u << kernel))) {
+        id = (int)kernel;
+    } else {
+        return BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED;
+    }
+    atomic_store_explicit(&bit_shift_kernel_id, id, memory_order_relaxed);
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+size_t bignum_shift_right_set_stream_threshold(size_t min_words) {
+    return atomic_exchange_explicit(&bit_shift_stream_min, min_words, memory_order_relaxed);
+}
@@ -0,0 +1,290 @@
+/**
+ * @file    bignum_shift_right_async.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Асинхронные пакеты сдвигов: очередь заданий с пулом потоков.
+ *
+ * @details
+ *   `bignum_shift_right_submit` делит пакет на отрезки по
+ *   `BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK` чисел и раскладывает их по очередям
+ *   потоков пула по кругу. Каждый поток берет отрезки из своей очереди
+ *   (с конца), а когда она пуста — крадет из начала чужих, поэтому
+ *   неравномерные пакеты выравниваются без центральной очереди. Отрезок
+ *   выполняется пакетным ядром (`bignum_shift_right_batch` или
+ *   `_batch_uniform`); поток, завершивший последний отрезок задания,
+ *   вызывает обратный вызов.
+ *
+ *   Пакеты до `BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX` чисел выполняются сразу
+ *   в вызывающем потоке: пробуждение потока пула дороже самого сдвига.
+ *   Если очередь потока переполнена, отрезок тоже выполняет вызывающий поток.
+ *
+ *   Потоки пула создаются при первом асинхронном задании (по одному на CPU,
+ *   не больше BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS) и живут до конца
+ *   процесса, как и пул bignum_shift_right_view_parallel.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальная версия.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bignum_shift_right.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/** Емкость очереди одного потока, отрезков (степень двойки). */
+#define ASYNC_DEQUE_SIZE 256u
+
+/** Задание: копия пакета и счетчик невыполненных отрезков. */
+typedef struct {
+    bignum_shift_right_batch_t    batch;
+    bignum_shift_right_complete_t complete;
+    void*                         user;
+    atomic_size_t                 remaining;  /**< Отрезков в работе + 1 на время submit. */
+    uint64_t                      submit_ns;
+} async_job_t;
+
+/** Отрезок задания: числа [begin, end). */
+typedef struct {
+    async_job_t* job;
+    size_t       begin, end;
+} task_t;
+
+/** Очередь потока: владелец берет с bottom, остальные крадут с top. */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t          top, bottom;   /**< Отрезки [top, bottom) по модулю ASYNC_DEQUE_SIZE. */
+    task_t          tasks[ASYNC_DEQUE_SIZE];
+} deque_t;
+
+static struct {
+    pthread_once_t  once;
+    pthread_mutex_t lock;        /**< Сон потоков и jobs_in_flight. */
+    pthread_cond_t  work;        /**< Появились отрезки. */
+    pthread_cond_t  idle;        /**< Асинхронных заданий не осталось. */
+    atomic_size_t   queued;      /**< Отрезков во всех очередях. */
+    size_t          jobs_in_flight;
+    atomic_uint     next_deque;  /**< Очередь для следующего отрезка (по кругу). */
+    atomic_uint     nworkers;    /**< Создано потоков (пишет только async_init). */
+    deque_t         deques[BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS];
+} queue = {
+    .once = PTHREAD_ONCE_INIT, .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER, .idle = PTHREAD_COND_INITIALIZER
+};
+
+/** Счетчики bignum_shift_right_async_stats_get. */
+static struct {
+    atomic_uint_fast64_t submitted, completed_inline, completed_async;
+    atomic_uint_fast64_t chunks, chunks_stolen, chunks_caller;
+    atomic_uint_fast64_t latency_ns_total, latency_ns_max;
+} stats;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void count(atomic_uint_fast64_t* counter, uint64_t n) {
+    atomic_fetch_add_explicit(counter, n, memory_order_relaxed);
+}
+
+/** Сдвигает числа [begin, end) пакета. */
+static void run_range(const bignum_shift_right_batch_t* b, size_t begin, size_t end) {
+    bignum_shift_right_status_t* st = b->statuses ? b->statuses + begin : NULL;
+    if (b->shifts) {
+        bignum_shift_right_batch(b->nums + begin, b->shifts + begin, end - begin, st);
+    } else {
+        bignum_shift_right_batch_uniform(b->nums + begin, b->shift_amount, end - begin, st);
+    }
+}
+
+/** Снимает одну ссылку с задания; последняя завершает его. */
+static void job_release(async_job_t* job) {
+    if (atomic_fetch_sub_explicit(&job->remaining, 1, memory_order_acq_rel) != 1) return;
+    const uint64_t latency = now_ns() - job->submit_ns;
+    if (job->complete) job->complete(&job->batch, job->user);
+    count(&stats.completed_async, 1);
+    count(&stats.latency_ns_total, latency);
+    uint_fast64_t max = atomic_load_explicit(&stats.latency_ns_max, memory_order_relaxed);
+    while (latency > max && !atomic_compare_exchange_weak_explicit(&stats.latency_ns_max, &max, latency,
+                                                                   memory_order_relaxed, memory_order_relaxed)) {
+    }
+    free(job);
+
+    pthread_mutex_lock(&queue.lock);
+    if (--queue.jobs_in_flight == 0) pthread_cond_broadcast(&queue.idle);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+static int deque_push(deque_t* d, const task_t* t) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom - d->top < ASYNC_DEQUE_SIZE) {
+        d->tasks[d->bottom++ % ASYNC_DEQUE_SIZE] = *t;
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+/** Берет отрезок: свой — с конца (from_top = 0), чужой — из начала. */
+static int deque_take(deque_t* d, task_t* t, int from_top) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->top != d->bottom) {
+        *t = from_top ? d->tasks[d->top++ % ASYNC_DEQUE_SIZE] : d->tasks[--d->bottom % ASYNC_DEQUE_SIZE];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    if (ok) atomic_fetch_sub_explicit(&queue.queued, 1, memory_order_relaxed);
+    return ok;
+}
+
+static void async_init(void);
+
+static void* async_worker(void* arg) {
+    const unsigned self = (unsigned)(uintptr_t)arg;
+    pthread_once(&queue.once, async_init);   // Ждет, пока async_init создаст все потоки
+    const unsigned nworkers = atomic_load(&queue.nworkers);
+    for (;;) {
+        task_t t;
+        int found = deque_take(&queue.deques[self], &t, 0);
+        for (unsigned i = 1; !found && i < nworkers; ++i) {
+            found = deque_take(&queue.deques[(self + i) % nworkers], &t, 1);
+            if (found) count(&stats.chunks_stolen, 1);
+        }
+        if (found) {
+            run_range(&t.job->batch, t.begin, t.end);
+            count(&stats.chunks, 1);
+            job_release(t.job);
+            continue;
+        }
+        pthread_mutex_lock(&queue.lock);
+        while (atomic_load_explicit(&queue.queued, memory_order_relaxed) == 0) {
+            pthread_cond_wait(&queue.work, &queue.lock);
+        }
+        pthread_mutex_unlock(&queue.lock);
+    }
+    return NULL;
+}
+
+static void async_init(void) {
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned want = cpus > 0 ? (unsigned)cpus : 1;
+    if (want > BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS) want = BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS;
+    for (unsigned i = 0; i < want; ++i) pthread_mutex_init(&queue.deques[i].lock, NULL);
+
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0) return;
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    // Потоки читают nworkers после выхода из async_init (pthread_once): число окончательное
+    for (unsigned i = 0; i < want; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, async_worker, (void*)(uintptr_t)i) != 0) break;
+        atomic_store(&queue.nworkers, i + 1);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+/** Будит потоки пула после добавления отрезков. */
+static void wake_workers(void) {
+    pthread_mutex_lock(&queue.lock);
+    pthread_cond_broadcast(&queue.work);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+/** Выполняет пакет целиком в вызывающем потоке. */
+static void run_inline(const bignum_shift_right_batch_t* batch, bignum_shift_right_complete_t complete, void* user) {
+    if (batch->count != 0) run_range(batch, 0, batch->count);
+    count(&stats.completed_inline, 1);
+    if (complete) complete(batch, user);
+}
+
+bignum_shift_right_status_t bignum_shift_right_submit(const bignum_shift_right_batch_t* batch,
+                                                      bignum_shift_right_complete_t complete, void* user) {
+    if (batch == NULL || (batch->count != 0 && (batch->nums == NULL))) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    count(&stats.submitted, 1);
+    if (batch->count <= BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX) {
+        run_inline(batch, complete, user);
+        return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+
+    pthread_once(&queue.once, async_init);
+    const unsigned nworkers = atomic_load(&queue.nworkers);
+    async_job_t* job = nworkers ? malloc(sizeof(*job)) : NULL;
+    if (job == NULL) {
+        run_inline(batch, complete, user);
+        return BIGNUM_SHIFT_RIGHT_SUCCESS;
+    }
+    job->batch = *batch;
+    job->complete = complete;
+    job->user = user;
+    job->submit_ns = now_ns();
+    const size_t nchunks = (batch->count + BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK - 1) / BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK;
+    atomic_init(&job->remaining, nchunks + 1);
+
+    pthread_mutex_lock(&queue.lock);
+    queue.jobs_in_flight++;
+    pthread_mutex_unlock(&queue.lock);
+
+    size_t pushed = 0, woken = 0;
+    for (size_t begin = 0; begin < batch->count; begin += BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK) {
+        task_t t = {job, begin, batch->count - begin < BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK
+                                    ? batch->count : begin + BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK};
+        unsigned d = atomic_fetch_add_explicit(&queue.next_deque, 1, memory_order_relaxed) % nworkers;
+        // Отрезок учитывается в queued до того, как его можно украсть
+        atomic_fetch_add_explicit(&queue.queued, 1, memory_order_relaxed);
+        if (deque_push(&queue.deques[d], &t)) {
+            pushed++;
+            continue;
+        }
+        atomic_fetch_sub_explicit(&queue.queued, 1, memory_order_relaxed);
+        if (woken < pushed) {
+            wake_workers();   // Пул начинает уже добавленные отрезки, пока вызывающий поток занят
+            woken = pushed;
+        }
+        run_range(&job->batch, t.begin, t.end);   // Очередь полна: отрезок выполняет вызывающий поток
+        count(&stats.chunks_caller, 1);
+        job_release(job);
+    }
+    if (woken < pushed) wake_workers();
+    job_release(job);
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+void bignum_shift_right_async_wait(void) {
+    pthread_mutex_lock(&queue.lock);
+    while (queue.jobs_in_flight != 0) pthread_cond_wait(&queue.idle, &queue.lock);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+bignum_shift_right_status_t bignum_shift_right_async_stats_get(bignum_shift_right_async_stats_t* out) {
+    if (out == NULL) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    out->submitted        = atomic_load_explicit(&stats.submitted, memory_order_relaxed);
+    out->completed_inline = atomic_load_explicit(&stats.completed_inline, memory_order_relaxed);
+    out->completed_async  = atomic_load_explicit(&stats.completed_async, memory_order_relaxed);
+    out->chunks           = atomic_load_explicit(&stats.chunks, memory_order_relaxed);
+    out->chunks_stolen    = atomic_load_explicit(&stats.chunks_stolen, memory_order_relaxed);
+    out->chunks_caller    = atomic_load_explicit(&stats.chunks_caller, memory_order_relaxed);
+    out->latency_ns_total = atomic_load_explicit(&stats.latency_ns_total, memory_order_relaxed);
+    out->latency_ns_max   = atomic_load_explicit(&stats.latency_ns_max, memory_order_relaxed);
+    out->workers          = atomic_load(&queue.nworkers);
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+void bignum_shift_right_async_stats_reset(void) {
+    atomic_uint_fast64_t* const all[] = {
+        &stats.submitted, &stats.completed_inline, &stats.completed_async, &stats.chunks,
+        &stats.chunks_stolen, &stats.chunks_caller, &stats.latency_ns_total, &stats.latency_ns_max
+    };
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+        atomic_store_explicit(all[i], 0, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,287 @@
+/**
+ * @file    bignum_shift_right_parallel.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Многопоточный сдвиг вправо чисел во внешних буферах (bignum_view_t).
+ *
+ * @details
+ *   Результат делится на отрезки слов `[a, b)`, каждый отрезок сдвигается
+ *   своим потоком через `bignum_shift_right_segment` (те же ядра и выбор по
+ *   CPU, что и у `bignum_shift_right_view`). Слову результата `i` нужны
+ *   только исходные слова `i + word_shift` и `i + word_shift + 1`, поэтому
+ *   отрезки независимы, кроме перекрытия при сдвиге на месте:
+ *
+ *   - `word_shift < new_len` и `word_shift <= PARALLEL_STAGE_MAX_WORDS`:
+ *     отрезок читает не более `word_shift + 1` слов из области записи
+ *     соседнего отрезка. Эти граничные слова копируются в буфер отрезка
+ *     (фаза STAGE) до того, как кто-либо начнет писать (фаза SHIFT_STAGED).
+ *   - иначе — раунды по `word_shift` слов: раунд `r` пишет
+ *     `[r * ws, (r + 1) * ws)` и читает только `[(r + 1) * ws, (r + 2) * ws]`,
+ *     то есть слова, которые перезапишут лишь следующие раунды. При
+ *     `word_shift >= new_len` раунд один.
+ *
+ *   Потоки пула создаются при первом вызове и живут до конца процесса.
+ *   Между фазами вызывающий поток ждет завершения всех отрезков (барьер на
+ *   pthread_cond). Пул обслуживает один вызов за раз: параллельный вызов из
+ *   другого потока выполняется однопоточным `bignum_shift_right_view`.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальная версия.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bignum_shift_right.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Наибольший word_shift, при котором перекрытие снимается копированием границ. */
+#define PARALLEL_STAGE_MAX_WORDS  32768u
+/** Минимальный отрезок одного потока, слов: меньше — побеждают накладные расходы. */
+#define PARALLEL_MIN_CHUNK_WORDS  4096u
+/** Границы отрезков кратны строке кэша (8 слов): потоки не делят строки. */
+#define PARALLEL_CHUNK_ALIGN_WORDS 8u
+
+/**
+ * @internal
+ * @brief dst[i] = (src[i] >> s) | (src[i + 1] << (64 - s)), где src[n] = hi.
+ * @note  Реализована в bignum_shift_right.asm (или .c); n >= 1, s = 0..63,
+ *        src >= dst или без перекрытия.
+ */
+void bignum_shift_right_segment(uint64_t* dst, const uint64_t* src, size_t n,
+                                unsigned bit_shift, uint64_t hi);
+
+typedef enum {
+    PHASE_STAGE,        /**< Копирование граничных слов в буферы отрезков. */
+    PHASE_SHIFT_STAGED, /**< Сдвиг: своя область из памяти, граница из буфера. */
+    PHASE_SHIFT,        /**< Сдвиг раунда: читаемые слова не пишет никто. */
+    PHASE_ZERO          /**< Обнуление освободившихся слов. */
+} phase_t;
+
+/** Описание текущей фазы; поля lo, hi, phase меняются между фазами. */
+typedef struct {
+    uint64_t* words;
+    size_t    len;       /**< Исходная длина. */
+    size_t    n;         /**< Длина после сдвига по словам. */
+    size_t    ws;        /**< word_shift. */
+    unsigned  bs;        /**< bit_shift. */
+    phase_t   phase;
+    size_t    lo, hi;    /**< Слова фазы [lo, hi), делятся на nchunks отрезков. */
+    unsigned  nchunks;
+    uint64_t* stage;     /**< nchunks буферов по ws + 1 слов. */
+} job_t;
+
+typedef struct {
+    unsigned      id;    /**< Номер отрезка (0 — вызывающий поток). */
+    unsigned long seen;  /**< Последнее выполненное поколение. */
+} worker_t;
+
+static struct {
+    pthread_mutex_t busy;         /**< Захвачен на весь параллельный вызов. */
+    pthread_mutex_t lock;         /**< Защищает поля ниже. */
+    pthread_cond_t  start;
+    pthread_cond_t  done;
+    unsigned long   generation;   /**< Номер фазы; рост будит потоки. */
+    unsigned        participants; /**< Отрезков в текущей фазе. */
+    unsigned        pending;      /**< Отрезков, еще не выполненных потоками пула. */
+    const job_t*    job;
+    unsigned        nworkers;     /**< Создано потоков: номера 1..nworkers. */
+    worker_t        workers[BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS];
+    uint64_t*       stage;        /**< Буфер граничных слов (только растет). */
+    size_t          stage_words;
+} pool = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    0, 0, 0, NULL, 0, {{0, 0}}, NULL, 0
+};
+
+static size_t min_size(size_t a, size_t b) { return a < b ? a : b; }
+static size_t max_size(size_t a, size_t b) { return a > b ? a : b; }
+
+/** Границы отрезка c текущей фазы; отрезок может оказаться пустым. */
+static void chunk_bounds(const job_t* job, unsigned c, size_t* a, size_t* b) {
+    const size_t span = job->hi - job->lo;
+    size_t step = (span + job->nchunks - 1) / job->nchunks;
+    step = (step + PARALLEL_CHUNK_ALIGN_WORDS - 1) & ~(size_t)(PARALLEL_CHUNK_ALIGN_WORDS - 1);
+    *a = job->lo + min_size((size_t)c * step, span);
+    *b = job->lo + min_size((size_t)c * step + step, span);
+}
+
+/** Выполняет отрезок c текущей фазы. */
+static void run_chunk(const job_t* job, unsigned c) {
+    size_t a, b;
+    chunk_bounds(job, c, &a, &b);
+    if (a >= b) return;
+
+    uint64_t* const w = job->words;
+    const size_t ws = job->ws;
+    uint64_t* const st = job->stage + (size_t)c * (ws + 1);
+    /* Слова [s0, s1) отрезок читает из области записи соседей. */
+    const size_t s0 = max_size(b, a + ws);
+    const size_t s1 = min_size(b + ws + 1, job->len);
+
+    switch (job->phase) {
+    case PHASE_STAGE:
+        if (s0 < s1) memcpy(st, w + s0, (s1 - s0) * sizeof(uint64_t));
+        break;
+    case PHASE_SHIFT_STAGED: {
+        /* Сначала голова (читает только свою область), затем хвост из буфера. */
+        const size_t head = s0 - ws - a;
+        if (head != 0) {
+            bignum_shift_right_segment(w + a, w + a + ws, head, job->bs, s0 < job->len ? st[0] : 0);
+        }
+        if (a + head < b) {
+            const size_t top = b + ws;
+            bignum_shift_right_segment(w + a + head, st, b - a - head, job->bs,
+                                       top < job->len ? st[top - s0] : 0);
+        }
+        break;
+    }
+    case PHASE_SHIFT:
+        bignum_shift_right_segment(w + a, w + a + ws, b - a, job->bs,
+                                   b + ws < job->len ? w[b + ws] : 0);
+        break;
+    case PHASE_ZERO:
+        memset(w + a, 0, (b - a) * sizeof(uint64_t));
+        break;
+    }
+}
+
+static void* pool_worker(void* arg) {
+    worker_t* self = arg;
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (pool.generation == self->seen) pthread_cond_wait(&pool.start, &pool.lock);
+        self->seen = pool.generation;
+        if (self->id >= pool.participants) continue;
+        const job_t* job = pool.job;
+        pthread_mutex_unlock(&pool.lock);
+        run_chunk(job, self->id);
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+    }
+    return NULL;
+}
+
+/**
+ * Досоздает потоки пула под nchunks отрезков (вызывается под pool.busy).
+ * @return Число отрезков, которое пул может обслужить (не больше nchunks).
+ */
+static unsigned pool_reserve(unsigned nchunks) {
+    pthread_attr_t attr;
+    if (pool.nworkers + 1 >= nchunks) return nchunks;
+    if (pthread_attr_init(&attr) != 0) return pool.nworkers + 1;
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_mutex_lock(&pool.lock);
+    while (pool.nworkers + 1 < nchunks) {
+        worker_t* wk = &pool.workers[pool.nworkers + 1];
+        pthread_t thread;
+        wk->id = pool.nworkers + 1;
+        wk->seen = pool.generation;
+        if (pthread_create(&thread, &attr, pool_worker, wk) != 0) break;
+        pool.nworkers++;
+    }
+    pthread_mutex_unlock(&pool.lock);
+    pthread_attr_destroy(&attr);
+    return min_size(nchunks, pool.nworkers + 1);
+}
+
+/** Буфер граничных слов на words слов (вызывается под pool.busy). */
+static uint64_t* pool_stage(size_t words) {
+    if (pool.stage_words < words) {
+        uint64_t* stage = malloc(words * sizeof(uint64_t));
+        if (stage == NULL) return NULL;
+        free(pool.stage);
+        pool.stage = stage;
+        pool.stage_words = words;
+    }
+    return pool.stage;
+}
+
+/** Выполняет фазу: отрезок 0 — в вызывающем потоке, остальные — в пуле. */
+static void pool_run(job_t* job, phase_t phase, size_t lo, size_t hi) {
+    job->phase = phase;
+    job->lo = lo;
+    job->hi = hi;
+    pthread_mutex_lock(&pool.lock);
+    pool.job = job;
+    pool.participants = job->nchunks;
+    pool.pending = job->nchunks - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    run_chunk(job, 0);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.pending != 0) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+}
+
+/** Число отрезков для n слов результата и запрошенного числа потоков. */
+static unsigned parallel_chunks(size_t n, unsigned nthreads) {
+    if (nthreads == 0) {
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (unsigned)min_size((size_t)cpus, BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS) : 1;
+    }
+    if (nthreads > BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS) nthreads = BIGNUM_SHIFT_RIGHT_PARALLEL_MAX_THREADS;
+    if (n < BIGNUM_SHIFT_RIGHT_PARALLEL_MIN_WORDS) return 1;
+    return (unsigned)min_size(nthreads, n / PARALLEL_MIN_CHUNK_WORDS);
+}
+
+bignum_shift_right_status_t bignum_shift_right_view_parallel(bignum_view_t* view, size_t shift_amount,
+                                                            unsigned nthreads) {
+    if (view == NULL || view->len == 0 || view->words == NULL || shift_amount == 0) {
+        return bignum_shift_right_view(view, shift_amount);
+    }
+    const size_t len = view->len;
+    const size_t ws = shift_amount / 64;
+    if (ws >= len) return bignum_shift_right_view(view, shift_amount);
+
+    job_t job = {0};
+    job.words = view->words;
+    job.len = len;
+    job.n = len - ws;
+    job.ws = ws;
+    job.bs = (unsigned)(shift_amount % 64);
+    job.nchunks = parallel_chunks(job.n, nthreads);
+    if (job.nchunks <= 1 || pthread_mutex_trylock(&pool.busy) != 0) {
+        return bignum_shift_right_view(view, shift_amount);
+    }
+
+    job.nchunks = pool_reserve(job.nchunks);
+    const int staged = ws < job.n && ws <= PARALLEL_STAGE_MAX_WORDS;
+    if (staged && job.nchunks > 1) {
+        job.stage = pool_stage((size_t)job.nchunks * (ws + 1));
+    }
+    if (job.nchunks <= 1 || (staged && job.stage == NULL)) {
+        pthread_mutex_unlock(&pool.busy);
+        return bignum_shift_right_view(view, shift_amount);
+    }
+
+    if (staged) {
+        pool_run(&job, PHASE_STAGE, 0, job.n);
+        pool_run(&job, PHASE_SHIFT_STAGED, 0, job.n);
+    } else {
+        for (size_t lo = 0; lo < job.n; lo += ws) {
+            pool_run(&job, PHASE_SHIFT, lo, min_size(lo + ws, job.n));
+        }
+    }
+    if (ws >= BIGNUM_SHIFT_RIGHT_PARALLEL_MIN_WORDS) {
+        pool_run(&job, PHASE_ZERO, job.n, len);
+    } else {
+        memset(job.words + job.n, 0, ws * sizeof(uint64_t));
+    }
+    pthread_mutex_unlock(&pool.busy);
+
+    /* Нормализация O(1), как в bignum_shift_right_view. */
+    size_t new_len = job.n;
+    if (job.words[new_len - 1] == 0) new_len--;
+    view->len = new_len;
+    return new_len == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    bignum_shift_right_stats.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Статистика вызовов bignum_shift_right в инструментированной сборке.
+ *
+ * @details
+ *   При `-DBIGNUM_SHIFT_RIGHT_INSTRUMENT` публичный вход bignum_shift_right
+ *   (bignum_shift_right.asm) после сдвига вызывает
+ *   `bignum_shift_right_stats_record` с исходными `len`, `shift_amount` и
+ *   тактами. Путь определяется здесь по тем же условиям и в том же порядке,
+ *   что и ветвления ядра, поэтому не добавляет кода в сам сдвиг.
+ *
+ *   Счетчики thread-local: запись без атомарных операций и без разделения
+ *   строк кэша между потоками. Без INSTRUMENT остаются только
+ *   bignum_shift_right_stats_get/reset, сообщающие об отсутствии статистики.
+ *
+ *   bignum_shift_right_stats_profile (в любой сборке) превращает собранную
+ *   статистику в порядок проверок bignum_shift_right_dispatch.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальная версия.
+ *   - rev. 2 (14.10.2026): bignum_shift_right_stats_profile.
+ */
+
+#include "bignum_shift_right.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT
+
+/** Статистика вызывающего потока. */
+static _Thread_local bignum_shift_right_stats_t thread_stats;
+
+/**
+ * @internal
+ * @brief Учитывает один вызов bignum_shift_right.
+ * @param len           Исходная длина числа; SIZE_MAX, если `num == NULL`.
+ * @param shift_amount  Сдвиг, переданный в bignum_shift_right.
+ * @param cycles        Такты TSC сдвига (0 без BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES).
+ * @note  Вызывается из bignum_shift_right.asm.
+ */
+void bignum_shift_right_stats_record(size_t len, size_t shift_amount, uint64_t cycles);
+
+void bignum_shift_right_stats_record(size_t len, size_t shift_amount, uint64_t cycles) {
+    bignum_shift_right_path_t path;
+    if (len == SIZE_MAX) {
+        path = BIGNUM_SHIFT_RIGHT_PATH_NULL_ARG;
+    } else {
+        size_t ws = shift_amount / 64;
+        if (len == 0 || shift_amount == 0) {
+            path = BIGNUM_SHIFT_RIGHT_PATH_SUCCESS_ZERO;
+        } else if (ws >= len) {
+            path = BIGNUM_SHIFT_RIGHT_PATH_ZERO_OUT;
+        } else if (shift_amount % 64 == 0) {
+            path = BIGNUM_SHIFT_RIGHT_PATH_WORD;
+        } else if (ws == 0) {
+            path = BIGNUM_SHIFT_RIGHT_PATH_BIT;
+        } else {
+            path = BIGNUM_SHIFT_RIGHT_PATH_COMBINED;
+        }
+        /* len > BIGNUM_CAPACITY нарушает контракт bignum_t; учитывается в последней ячейке. */
+        thread_stats.len_hist[len < BIGNUM_CAPACITY ? len : BIGNUM_CAPACITY]++;
+    }
+    thread_stats.calls[path]++;
+    thread_stats.cycles[path] += cycles;
+}
+
+bignum_shift_right_status_t bignum_shift_right_stats_get(bignum_shift_right_stats_t* stats) {
+    if (stats == NULL) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    *stats = thread_stats;
+    return BIGNUM_SHIFT_RIGHT_SUCCESS;
+}
+
+void bignum_shift_right_stats_reset(void) {
+    memset(&thread_stats, 0, sizeof(thread_stats));
+}
+
+#else /* !BIGNUM_SHIFT_RIGHT_INSTRUMENT */
+
+bignum_shift_right_status_t bignum_shift_right_stats_get(bignum_shift_right_stats_t* stats) {
+    if (stats == NULL) return BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+    memset(stats, 0, sizeof(*stats));
+    return BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED;
+}
+
+void bignum_shift_right_stats_reset(void) {
+}
+
+#endif /* BIGNUM_SHIFT_RIGHT_INSTRUMENT */
+
+size_t bignum_shift_right_stats_profile(const bignum_shift_right_stats_t* stats, char* buf, size_t size) {
+    if (stats == NULL) return 0;
+    uint64_t bit = stats->calls[BIGNUM_SHIFT_RIGHT_PATH_BIT];
+    uint64_t word = stats->calls[BIGNUM_SHIFT_RIGHT_PATH_WORD];
+    uint64_t other = stats->calls[BIGNUM_SHIFT_RIGHT_PATH_COMBINED] + stats->calls[BIGNUM_SHIFT_RIGHT_PATH_ZERO_OUT];
+
+    /* Классы по убыванию вызовов; при равенстве BIT первым. Не чаще прочих — не проверяются. */
+    const char* order[2];
+    size_t n = 0;
+    int word_first = word > bit;
+    if ((word_first ? word : bit) > other) order[n++] = word_first ? "X(WORD)" : "X(BIT)";
+    if ((word_first ? bit : word) > other) order[n++] = word_first ? "X(BIT)" : "X(WORD)";
+
+    return (size_t)snprintf(buf, size,
+                            "/* bignum_shift_right profile: BIT %llu, WORD %llu, other %llu calls */\n"
+                            "#define BIGNUM_SHIFT_RIGHT_PROFILE_ORDER(X)%s%s%s%s\n",
+                            (unsigned long long)bit, (unsigned long long)word, (unsigned long long)other,
+                            n > 0 ? " " : "", n > 0 ? order[0] : "", n > 1 ? " " : "", n > 1 ? order[1] : "");
+}
@@ -23,6 +23,31 @@
  *   - rev. 8 (11.08.2025): Код тестов предоставлен пользователем. Добавлена
  *                         исчерпывающая документация. Восстановлена полная
  *                         и честная история ревизий.
+ *   - rev. 9 (14.10.2026): Добавлены тесты пакетного API.
+ *   - rev. 10 (14.10.2026): Добавлены тесты выбора векторных ядер.
+ *   - rev. 11 (14.10.2026): Добавлены тесты bignum_shift_right_to.
+ *   - rev. 12 (14.10.2026): Добавлена проверка емкости библиотеки и тест
+ *                          всех длин для развернутого скалярного ядра.
+ *   - rev. 13 (14.10.2026): Добавлен тест встраиваемых функций и макроса BIGNUM_SHIFT_RIGHT.
+ *   - rev. 14 (14.10.2026): Добавлены тесты bignum_shift_right_rem и bignum_shift_right_sticky.
+ *   - rev. 15 (14.10.2026): Добавлен тест арифметического сдвига.
+ *   - rev. 16 (14.10.2026): Добавлен тест режимов округления.
+ *   - rev. 17 (14.10.2026): Добавлен тест извлечения битового окна.
+ *   - rev. 18 (14.10.2026): Добавлены тесты сдвига со знаком (влево и переполнение).
+ *   - rev. 19 (14.10.2026): Добавлен тест сдвига длинных чисел через bignum_view_t.
+ *   - rev. 20 (14.10.2026): Добавлен тест потоковых записей (порог и выравнивание).
+ *   - rev. 21 (14.10.2026): Добавлен тест сдвига за постоянное время.
+ *   - rev. 22 (14.10.2026): Добавлен тест отложенного сдвига bignum_lazy_t.
+ *   - rev. 23 (14.10.2026): Добавлен тест сдвига на младшие нули bignum_shift_right_ctz.
+ *   - rev. 24 (14.10.2026): Добавлен тест пакетного формата SoA для всех ядер.
+ *   - rev. 25 (14.10.2026): Добавлен тест bignum_shift_right_unchecked.
+ *   - rev. 26 (14.10.2026): Добавлен тест статистики инструментированной сборки.
+ *   - rev. 27 (14.10.2026): Добавлены тесты входов по классу сдвига и профиля диспетчера.
+ *   - rev. 28 (14.10.2026): Добавлены тесты пула bignum_pool_t и bignum_shift_right_batch_ptr.
+ *   - rev. 29 (14.10.2026): Перебор ядер включает NEON (реализация на C, AArch64).
+ *   - rev. 30 (14.10.2026): Добавлен тест сериализации bignum_shift_right_export_be.
+ *   - rev. 31 (14.10.2026): Добавлен тест сдвига на величину bignum_t (_by, _by_nz).
+ *   - rev. 32 (14.10.2026): Добавлен тест режима «грязного хвоста» (_nz, clear_tail).
  */
 
 #include "bignum_shift_right.h"
@@ -212,8 +237,1217 @@ int test_normalization_after_shift() {
     return bignum_are_equal(&num, &expected);
 }
 
+/**
+ * @brief      Тест: пакетный сдвиг с индивидуальными величинами совпадает с поэлементным.
+ * @pre        nums = {{0xD, len=1}, {1, 2, 3, len=3}, {1, len=1}, {len=0}}, shifts = {2, 66, 1, 10}
+ * @post       nums = {{0x3}, {0xC000000000000000}, {len=0}, {len=0}},
+ *             statuses = {SUCCESS, SUCCESS, ZEROED, SUCCESS}
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_batch_per_element_shifts() {
+    bignum_t nums[4] = {
+        {.words = {0xD}, .len = 1},
+        {.words = {1, 2, 3}, .len = 3},
+        {.words = {1}, .len = 1},
+        {.len = 0},
+    };
+    const size_t shifts[4] = {2, 66, 1, 10};
+    bignum_t expected[4];
+    bignum_shift_right_status_t expected_statuses[4];
+    bignum_shift_right_status_t statuses[4];
+    for (int i = 0; i < 4; ++i) {
+        expected[i] = nums[i];
+        expected_statuses[i] = bignum_shift_right(&expected[i], shifts[i]);
+    }
+    if (bignum_shift_right_batch(nums, shifts, 4, statuses) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    for (int i = 0; i < 4; ++i) {
+        if (statuses[i] != expected_statuses[i]) {
+            fprintf(stderr, "FAIL: status[%d] mismatch. Expected %d, got %d\n", i, expected_statuses[i], statuses[i]);
+            return 0;
+        }
+        if (!bignum_are_equal(&nums[i], &expected[i])) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief      Тест: пакетный сдвиг на одну величину (слова + биты) без массива статусов.
+ * @pre        nums = {{0xFF, 0xEE, 0xDD, len=3}, {0xFF, len=1}, {len=0}}, shift = 66
+ * @post       nums = {{0x40...3B, 0x37, len=2}, {len=0}, {len=0}}
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_batch_uniform_shift() {
+    bignum_t nums[3] = {
+        {.words = {0xFF, 0xEE, 0xDD}, .len = 3},
+        {.words = {0xFF}, .len = 1},
+        {.len = 0},
+    };
+    bignum_t expected[3];
+    memset(expected, 0, sizeof(expected));
+    expected[0].words[0] = 0x400000000000003BULL;
+    expected[0].words[1] = 0x37ULL;
+    expected[0].len      = 2;
+    if (bignum_shift_right_batch_uniform(nums, 66, 3, NULL) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    for (int i = 0; i < 3; ++i) {
+        if (!bignum_are_equal(&nums[i], &expected[i])) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief      Тест: пакетные функции проверяют NULL и пустой пакет.
+ * @pre        nums = NULL / shifts = NULL при count = 1; count = 0 при NULL
+ * @post       ERROR_NULL_ARG при count > 0, SUCCESS при count = 0, статусы для shift = 0 равны SUCCESS
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_batch_null_and_empty() {
+    bignum_t num = {.words = {123}, .len = 1};
+    bignum_t expected = {.words = {123}, .len = 1};
+    size_t shift = 1;
+    bignum_shift_right_status_t statuses[1] = {BIGNUM_SHIFT_RIGHT_ZEROED};
+    if (bignum_shift_right_batch(NULL, &shift, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_batch(&num, NULL, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_batch_uniform(NULL, 1, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_batch(NULL, NULL, 0, NULL) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (bignum_shift_right_batch_uniform(NULL, 1, 0, NULL) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (bignum_shift_right_batch_uniform(&num, 0, 1, statuses) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (statuses[0] != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    return bignum_are_equal(&num, &expected);
+}
+
+/**
+ * @brief      Тест: выбор ядра — неизвестное ядро отклоняется, скалярное доступно всегда.
+ * @pre        kernel = 99, затем SCALAR, затем AUTO
+ * @post       ERROR_UNSUPPORTED без смены ядра; SUCCESS и get_kernel() == SCALAR; SUCCESS
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_set_kernel_validation() {
+    if (bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)99) != BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED) return 0;
+    if (bignum_shift_right_get_kernel() != BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR) return 0;
+    if (bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    return bignum_shift_right_get_kernel() != BIGNUM_SHIFT_RIGHT_KERNEL_AUTO;
+}
+
+/**
+ * @brief      Тест: все поддерживаемые ядра дают тот же результат, что и скалярное.
+ * @pre        num = {i * 0x9E37..., len} для len = 1..CAPACITY, shift = {1, 13, 63, 64 + 5, 64 * 3 + 33}
+ * @post       Для каждого ядра num совпадает с результатом скалярного ядра
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_all_kernels_match_scalar() {
+    static const size_t shifts[] = {1, 13, 63, 64 + 5, 64 * 3 + 33};
+    int ok = 1;
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_AVX2; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; ++k) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) {
+            printf("Kernel %d is not supported on this CPU, skipped\n", k);
+            continue;
+        }
+        for (size_t len = 1; len <= BIGNUM_CAPACITY && ok; ++len) {
+            for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]) && ok; ++j) {
+                bignum_t num, expected;
+                memset(&num, 0, sizeof(num));
+                for (size_t i = 0; i < len; ++i) num.words[i] = (i + 1) * 0x9E3779B97F4A7C15ULL;
+                num.len = len;
+                expected = num;
+                bignum_shift_right(&num, shifts[j]);
+                bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR);
+                bignum_shift_right(&expected, shifts[j]);
+                bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k);
+                if (!bignum_are_equal(&num, &expected)) {
+                    fprintf(stderr, "FAIL: kernel %d, len %zu, shift %zu\n", k, len, shifts[j]);
+                    ok = 0;
+                }
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    return ok;
+}
+
+/**
+ * @brief      Тест: сдвиг без копирования в неинициализированный dst.
+ * @pre        src = {0xF0, 0x1, 0xAB, len=3}, dst заполнен мусором, shift = 64 + 4
+ * @post       dst = {0xB000000000000000, 0xA, len=2} с нулевым хвостом, src не изменен, status = SUCCESS
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_to_out_of_place() {
+    bignum_t src = {.words = {0xF0, 0x1, 0xAB}, .len = 3};
+    bignum_t src_copy = src;
+    bignum_t dst;
+    bignum_t expected = {.words = {0xB000000000000000ULL, 0xA}, .len = 2};
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_to(&dst, &src, 64 + 4) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&dst, &expected)) return 0;
+    if (memcmp(&src, &src_copy, sizeof(src)) != 0) { fprintf(stderr, "FAIL: src was modified\n"); return 0; }
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_to(&dst, &src, 64 * 3) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    bignum_t zero = {.len = 0};
+    if (!bignum_are_equal(&dst, &zero)) return 0;
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_to(&dst, &src, 0) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    return bignum_are_equal(&dst, &src_copy);
+}
+
+/**
+ * @brief      Тест: bignum_shift_right_to с dst == src и NULL-аргументами.
+ * @pre        num = {0x0, 0x8, len=2}, shift = 3; затем dst или src = NULL
+ * @post       num = {0x0, 0x1, len=2}, status = SUCCESS; ERROR_NULL_ARG для NULL
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_to_aliased_and_null() {
+    bignum_t num = {.words = {0x0, 0x8}, .len = 2};
+    bignum_t expected = {.words = {0x0, 0x1}, .len = 2};
+    if (bignum_shift_right_to(&num, &num, 3) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&num, &expected)) return 0;
+    if (bignum_shift_right_to(NULL, &num, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_to(&num, NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return bignum_are_equal(&num, &expected);
+}
+
+/**
+ * @brief      Тест: библиотека собрана с той же BIGNUM_CAPACITY, что и тесты.
+ * @pre        Библиотека и тесты собраны одной командой make
+ * @post       bignum_shift_right_capacity == BIGNUM_CAPACITY
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_library_capacity_matches_header() {
+    if (!bignum_shift_right_capacity_matches()) {
+        fprintf(stderr, "FAIL: library capacity %lu, header capacity %d\n",
+                (unsigned long)bignum_shift_right_capacity, (int)BIGNUM_CAPACITY);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief      Тест: скалярное ядро на всех длинах и всех точках входа.
+ * @pre        num = {старший бит + i, len} для len = 1..CAPACITY, shift = 1..63 и 64 + 17
+ * @post       words[i] = (w[i] >> s) | (w[i + 1] << (64 - s)), хвост обнулен
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_scalar_kernel_every_length() {
+    int ok = 1;
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR);
+    for (size_t len = 1; len <= BIGNUM_CAPACITY && ok; ++len) {
+        for (size_t shift = 1; shift <= 64 + 17 && ok; shift += (shift < 63 ? 1 : 18)) {
+            bignum_t num, expected;
+            memset(&num, 0, sizeof(num));
+            memset(&expected, 0, sizeof(expected));
+            for (size_t i = 0; i < len; ++i) num.words[i] = 0x8000000000000000ULL | (i * 0x0123456789ABCDEFULL);
+            num.len = len;
+            size_t ws = shift / 64, bs = shift % 64;
+            for (size_t i = 0; i + ws < len; ++i) {
+                uint64_t lo = num.words[i + ws];
+                uint64_t hi = (i + ws + 1 < len) ? num.words[i + ws + 1] : 0;
+                expected.words[i] = bs ? (lo >> bs) | (hi << (64 - bs)) : lo;
+            }
+            expected.len = len > ws ? len - ws : 0;
+            while (expected.len > 0 && expected.words[expected.len - 1] == 0) expected.len--;
+            bignum_shift_right(&num, shift);
+            if (!bignum_are_equal(&num, &expected)) {
+                fprintf(stderr, "FAIL: len %zu, shift %zu\n", len, shift);
+                ok = 0;
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    return ok;
+}
+
+/**
+ * @brief      Тест: встраиваемые функции и BIGNUM_SHIFT_RIGHT совпадают с bignum_shift_right.
+ * @pre        num = {..., старшее слово 1 или 0x8000...}, len = 0..CAPACITY; различные сдвиги
+ * @post       Одинаковые числа и статусы (включая ZEROED и ERROR_NULL_ARG)
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_inline_helpers_match_asm() {
+    static const size_t bit_shifts[] = {0, 1, 5, 63, 64, 65};
+    static const size_t word_shifts[] = {0, 1, 3, BIGNUM_CAPACITY - 1, BIGNUM_CAPACITY};
+    size_t variable = 7;
+    if (bignum_shift_right_1(NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_words(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        for (int top = 0; top < 2; ++top) {
+            bignum_t base;
+            memset(&base, 0, sizeof(base));
+            for (size_t i = 0; i < len; ++i) base.words[i] = (i + 1) * 0x9E3779B97F4A7C15ULL;
+            if (len > 0) base.words[len - 1] = top ? 0x8000000000000000ULL : 1;
+            base.len = len;
+            for (size_t j = 0; j < sizeof(bit_shifts) / sizeof(bit_shifts[0]); ++j) {
+                bignum_t a = base, b = base;
+                bignum_shift_right_status_t sa = bignum_shift_right_bits(&a, bit_shifts[j]);
+                bignum_shift_right_status_t sb = bignum_shift_right(&b, bit_shifts[j]);
+                if (sa != sb || !bignum_are_equal(&a, &b)) {
+                    fprintf(stderr, "FAIL: bits, len %zu, shift %zu\n", len, bit_shifts[j]);
+                    return 0;
+                }
+            }
+            for (size_t j = 0; j < sizeof(word_shifts) / sizeof(word_shifts[0]); ++j) {
+                bignum_t a = base, b = base;
+                bignum_shift_right_status_t sa = bignum_shift_right_words(&a, word_shifts[j]);
+                bignum_shift_right_status_t sb = bignum_shift_right(&b, word_shifts[j] * 64);
+                if (sa != sb || !bignum_are_equal(&a, &b)) {
+                    fprintf(stderr, "FAIL: words, len %zu, k %zu\n", len, word_shifts[j]);
+                    return 0;
+                }
+            }
+            bignum_t a1 = base, b1 = base, a2 = base, b2 = base, a3 = base, b3 = base;
+            if (BIGNUM_SHIFT_RIGHT(&a1, 1) != bignum_shift_right(&b1, 1) || !bignum_are_equal(&a1, &b1)) return 0;
+            if (BIGNUM_SHIFT_RIGHT(&a2, 128) != bignum_shift_right(&b2, 128) || !bignum_are_equal(&a2, &b2)) return 0;
+            if (BIGNUM_SHIFT_RIGHT(&a3, variable) != bignum_shift_right(&b3, variable) || !bignum_are_equal(&a3, &b3)) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief      Тест: сдвиг с остатком в неинициализированный rem.
+ * @pre        num = {0x1234, 0xFFFF0000000000AB, 0x5, len=3}, rem заполнен мусором, shift = 64 + 8
+ * @post       num = {0x05FFFF0000000000, len=1}, rem = {0x1234, 0xAB, len=2}, status = SUCCESS;
+ *             нулевые младшие слова остатка нормализуются, при сдвиге за len rem = num
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_rem() {
+    bignum_t num = {.words = {0x1234, 0xFFFF0000000000ABULL, 0x5}, .len = 3};
+    bignum_t rem;
+    bignum_t expected = {.words = {0x05FFFF0000000000ULL}, .len = 1};
+    bignum_t expected_rem = {.words = {0x1234, 0xAB}, .len = 2};
+    memset(&rem, 0xA5, sizeof(rem));
+    if (bignum_shift_right_rem(&num, 64 + 8, &rem) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&num, &expected) || !bignum_are_equal(&rem, &expected_rem)) return 0;
+
+    bignum_t num2 = {.words = {0x0, 0x100}, .len = 2};
+    bignum_t expected2 = {.words = {0x1}, .len = 1};
+    bignum_t zero = {.len = 0};
+    memset(&rem, 0xA5, sizeof(rem));
+    if (bignum_shift_right_rem(&num2, 64 + 8, &rem) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&num2, &expected2) || !bignum_are_equal(&rem, &zero)) return 0;
+
+    bignum_t num3 = {.words = {0x7, 0x0, 0x9}, .len = 3};
+    bignum_t copy3 = num3;
+    memset(&rem, 0xA5, sizeof(rem));
+    if (bignum_shift_right_rem(&num3, 64 * BIGNUM_CAPACITY * 2, &rem) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (!bignum_are_equal(&num3, &zero) || !bignum_are_equal(&rem, &copy3)) return 0;
+
+    if (bignum_shift_right_rem(NULL, 1, &rem) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_rem(&num, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return bignum_are_equal(&num, &expected);
+}
+
+/**
+ * @brief      Тест: старшие выпавшие биты и sticky-бит.
+ * @pre        Сдвиги с точным результатом, ровно половиной, больше половины и за пределы len
+ * @post       dropped = 0, 1 << 63, (1 << 63) | 1 и 1 соответственно; num сдвинут как bignum_shift_right
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_sticky() {
+    uint64_t dropped = 0xDEAD;
+    bignum_t a = {.words = {0x6}, .len = 1};
+    bignum_t expected_a = {.words = {0x1}, .len = 1};
+    if (bignum_shift_right_sticky(&a, 2, &dropped) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (dropped != 0x8000000000000000ULL || !bignum_are_equal(&a, &expected_a)) return 0;
+
+    bignum_t b = {.words = {0x1, 0x8000000000000000ULL, 0x1}, .len = 3};
+    bignum_t expected_b = {.words = {0x1}, .len = 1};
+    if (bignum_shift_right_sticky(&b, 128, &dropped) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (dropped != 0x8000000000000001ULL || !bignum_are_equal(&b, &expected_b)) return 0;
+
+    bignum_t c = {.words = {0x0, 0x0, 0x50}, .len = 3};
+    bignum_t expected_c = {.words = {0x5}, .len = 1};
+    if (bignum_shift_right_sticky(&c, 128 + 4, &dropped) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (dropped != 0 || !bignum_are_equal(&c, &expected_c)) return 0;
+
+    bignum_t d = {.words = {0x1}, .len = 1};
+    bignum_t zero = {.len = 0};
+    if (bignum_shift_right_sticky(&d, 200, &dropped) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (dropped != 1 || !bignum_are_equal(&d, &zero)) return 0;
+
+    if (bignum_shift_right_sticky(NULL, 1, &dropped) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_sticky(&a, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return bignum_are_equal(&a, &expected_a);
+}
+
+/**
+ * @brief      Тест: арифметический сдвиг отрицательных и положительных чисел.
+ * @pre        Числа в минимальном дополнительном коде; сдвиги с отбрасыванием знакового
+ *             слова, без него, за пределы len и сдвиг -1
+ * @post       floor(num / 2^k) в минимальном представлении; ZEROED, если остался только знак
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_arith() {
+    bignum_t a = {.words = {0x0, 0x8000000000000000ULL}, .len = 2};
+    bignum_t expected_a = {.words = {0x0, 0xF800000000000000ULL}, .len = 2};
+    if (bignum_shift_right_arith(&a, 4) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&a, &expected_a)) return 0;
+
+    bignum_t b = {.words = {0x0, 0xFFFFFFFFFFFFFF80ULL}, .len = 2};   /* -128 * 2^64 */
+    bignum_t expected_b = {.words = {0x8000000000000000ULL}, .len = 1}; /* -2^63 */
+    if (bignum_shift_right_arith(&b, 8) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&b, &expected_b)) return 0;
+
+    bignum_t c = {.words = {0xFFFFFFFFFFFFFFFFULL, 0x1}, .len = 2};
+    bignum_t expected_c = {.words = {0xFFFFFFFFFFFFFFFFULL, 0x0}, .len = 2}; /* Знаковое слово 0 нужно */
+    if (bignum_shift_right_arith(&c, 1) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&c, &expected_c)) return 0;
+
+    bignum_t d = {.words = {0x5, 0x0, 0xFFFFFFFFFFFFFFFEULL}, .len = 3};   /* -2 * 2^128 + 5 */
+    bignum_t expected_d = {.words = {0xFFFFFFFFFFFFFFFEULL}, .len = 1};
+    if (bignum_shift_right_arith(&d, 128) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&d, &expected_d)) return 0;
+
+    bignum_t minus_one = {.words = {0xFFFFFFFFFFFFFFFFULL}, .len = 1};
+    bignum_t e = {.words = {0x1, 0x2, 0x8000000000000000ULL}, .len = 3};
+    if (bignum_shift_right_arith(&e, 64 * 3) != BIGNUM_SHIFT_RIGHT_ZEROED || !bignum_are_equal(&e, &minus_one)) return 0;
+    if (bignum_shift_right_arith(&e, 5) != BIGNUM_SHIFT_RIGHT_ZEROED || !bignum_are_equal(&e, &minus_one)) return 0;
+
+    bignum_t zero = {.len = 0};
+    bignum_t f = {.words = {0x7, 0x7FFFFFFFFFFFFFFFULL}, .len = 2};
+    if (bignum_shift_right_arith(&f, 127) != BIGNUM_SHIFT_RIGHT_ZEROED || !bignum_are_equal(&f, &zero)) return 0;
+
+    bignum_t g = {.words = {0x10}, .len = 1};
+    bignum_t expected_g = g;
+    if (bignum_shift_right_arith(&g, 0) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&g, &expected_g)) return 0;
+    return bignum_shift_right_arith(NULL, 1) == BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+}
+
+/**
+ * @brief      Тест: все режимы округления на точном сдвиге, половине, больше и меньше половины.
+ * @pre        num = 0x5 и 0x6 (>> 1), 0x7 (>> 2), 0x9 (>> 3), {~0, ~0, len=2} (>> 1), 0x1 (>> 200)
+ * @post       Результаты TRUNC/CEIL/HALF_UP/HALF_EVEN по таблице, перенос расширяет len,
+ *             неизвестный режим — ERROR_UNSUPPORTED
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_round_modes() {
+    static const struct { uint64_t value; size_t shift; uint64_t expected[4]; } cases[] = {
+        /*                           TRUNC CEIL HALF_UP HALF_EVEN */
+        { 0x5, 1, { 2, 3, 3, 2 } },  /* 2.5   */
+        { 0x7, 1, { 3, 4, 4, 4 } },  /* 3.5   */
+        { 0x6, 1, { 3, 3, 3, 3 } },  /* 3     */
+        { 0x7, 2, { 1, 2, 2, 2 } },  /* 1.75  */
+        { 0x9, 3, { 1, 2, 1, 1 } },  /* 1.125 */
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        for (int mode = BIGNUM_SHIFT_RIGHT_ROUND_TRUNC; mode <= BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN; ++mode) {
+            bignum_t num = {.words = {cases[i].value}, .len = 1};
+            bignum_t expected = {.words = {cases[i].expected[mode]}, .len = 1};
+            if (bignum_shift_right_round(&num, cases[i].shift, (bignum_shift_right_round_t)mode) != BIGNUM_SHIFT_RIGHT_SUCCESS ||
+                !bignum_are_equal(&num, &expected)) {
+                fprintf(stderr, "FAIL: case %zu, mode %d\n", i, mode);
+                return 0;
+            }
+        }
+    }
+    bignum_t carry = {.words = {~0ULL, ~0ULL}, .len = 2};
+    bignum_t expected_carry = {.words = {0x0, 0x8000000000000000ULL}, .len = 2};
+    if (bignum_shift_right_round(&carry, 1, BIGNUM_SHIFT_RIGHT_ROUND_CEIL) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&carry, &expected_carry)) return 0;
+
+    bignum_t half = {.words = {0x0, 0x1}, .len = 2};
+    bignum_t one = {.words = {0x1}, .len = 1};
+    if (bignum_shift_right_round(&half, 65, BIGNUM_SHIFT_RIGHT_ROUND_HALF_UP) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&half, &one)) return 0;
+
+    bignum_t tiny = {.words = {0x1}, .len = 1};
+    bignum_t zero = {.len = 0};
+    if (bignum_shift_right_round(&tiny, 200, BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (!bignum_are_equal(&tiny, &zero)) return 0;
+    tiny = one;
+    if (bignum_shift_right_round(&tiny, 200, BIGNUM_SHIFT_RIGHT_ROUND_CEIL) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&tiny, &one)) return 0;
+
+    if (bignum_shift_right_round(&tiny, 1, (bignum_shift_right_round_t)4) != BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED) return 0;
+    if (!bignum_are_equal(&tiny, &one)) return 0;
+    return bignum_shift_right_round(NULL, 1, BIGNUM_SHIFT_RIGHT_ROUND_CEIL) == BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+}
+
+/**
+ * @brief      Тест: извлечение битового окна в bignum_t и в uint64_t.
+ * @pre        src = {0x1122334455667788, 0x99AABBCCDDEEFF00, 0x0123456789ABCDEF, len=3};
+ *             окна внутри слова, через границу слов, за пределами len, нулевое и пустое
+ * @post       dst совпадает со сдвигом и маской, src не изменен, хвост dst обнулен
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_extract_bits() {
+    bignum_t src = {.words = {0x1122334455667788ULL, 0x99AABBCCDDEEFF00ULL, 0x0123456789ABCDEFULL}, .len = 3};
+    bignum_t src_copy = src;
+    bignum_t dst;
+
+    memset(&dst, 0xA5, sizeof(dst));
+    bignum_t expected_a = {.words = {0xF001122334455667ULL, 0xF99AABBCCDDEEFULL}, .len = 2};
+    if (bignum_shift_right_extract_bits(&dst, &src, 12, 120) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&dst, &expected_a)) return 0;
+
+    memset(&dst, 0xA5, sizeof(dst));
+    bignum_t expected_b = {.words = {0x0123456789ABCDEFULL}, .len = 1};
+    if (bignum_shift_right_extract_bits(&dst, &src, 128, 1000) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&dst, &expected_b)) return 0;
+
+    bignum_t zero = {.len = 0};
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_extract_bits(&dst, &src, 64, 8) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (!bignum_are_equal(&dst, &zero)) return 0;
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_extract_bits(&dst, &src, 3 * 64, 64) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (!bignum_are_equal(&dst, &zero)) return 0;
+    memset(&dst, 0xA5, sizeof(dst));
+    if (bignum_shift_right_extract_bits(&dst, &src, 5, 0) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (!bignum_are_equal(&dst, &zero)) return 0;
+    if (memcmp(&src, &src_copy, sizeof(src)) != 0) { fprintf(stderr, "FAIL: src was modified\n"); return 0; }
+
+    if (bignum_shift_right_extract_u64(&src, 60, 8) != 0x01) return 0;
+    if (bignum_shift_right_extract_u64(&src, 12, 64) != 0xF001122334455667ULL) return 0;
+    if (bignum_shift_right_extract_u64(&src, 184, 64) != 0x01) return 0;
+    if (bignum_shift_right_extract_u64(&src, 192, 64) != 0) return 0;
+    if (bignum_shift_right_extract_u64(NULL, 0, 64) != 0) return 0;
+
+    if (bignum_shift_right_extract_bits(NULL, &src, 0, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_extract_bits(&dst, NULL, 0, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
+/**
+ * @brief      Тест: сдвиг со знаком влево, с новым старшим словом и через слова.
+ * @pre        num = {0x8000000000000001, 0x1, len=2}, s = -4 и -(64 + 4); num = {0xF << 60}, s = -4
+ * @post       {0x10, 0x18, len=2}, {0x0, 0x10, 0x18, len=3}, {0x0, 0xF, len=2}; s > 0 — как bignum_shift_right
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_signed_shift_left() {
+    bignum_t a = {.words = {0x8000000000000001ULL, 0x1}, .len = 2};
+    bignum_t b = a;
+    bignum_t expected_a = {.words = {0x10, 0x18}, .len = 2};
+    bignum_t expected_b = {.words = {0x0, 0x10, 0x18}, .len = 3};
+    if (bignum_shift_right_signed(&a, -4) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&a, &expected_a)) return 0;
+    if (bignum_shift_right_signed(&b, -(64 + 4)) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&b, &expected_b)) return 0;
+
+    bignum_t c = {.words = {0xF000000000000000ULL}, .len = 1};
+    bignum_t expected_c = {.words = {0x0, 0xF}, .len = 2};
+    if (bignum_shift_right_signed(&c, -4) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&c, &expected_c)) return 0;
+
+    bignum_t d = {.words = {0x0, 0xF}, .len = 2};
+    bignum_t expected_d = {.words = {0xF000000000000000ULL}, .len = 1};
+    if (bignum_shift_right_signed(&d, 4) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&d, &expected_d)) return 0;
+
+    bignum_t zero = {.len = 0};
+    bignum_t e = zero;
+    if (bignum_shift_right_signed(&e, -1000000) != BIGNUM_SHIFT_RIGHT_SUCCESS || !bignum_are_equal(&e, &zero)) return 0;
+    return bignum_shift_right_signed(NULL, -1) == BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG;
+}
+
+/**
+ * @brief      Тест: переполнение емкости при сдвиге влево.
+ * @pre        num = {0x1, len=1}; s = -(64 * (CAPACITY - 1) + 63), -(64 * CAPACITY), PTRDIFF_MIN;
+ *             num со старшим битом в words[CAPACITY - 1], s = -1
+ * @post       Бит 64 * CAPACITY - 1 установлен; ERROR_OVERFLOW без изменения числа
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_signed_shift_left_overflow() {
+    bignum_t a = {.words = {0x1}, .len = 1};
+    bignum_t expected_a;
+    memset(&expected_a, 0, sizeof(expected_a));
+    expected_a.words[BIGNUM_CAPACITY - 1] = 0x8000000000000000ULL;
+    expected_a.len = BIGNUM_CAPACITY;
+    if (bignum_shift_right_signed(&a, -(ptrdiff_t)(64 * (BIGNUM_CAPACITY - 1) + 63)) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (!bignum_are_equal(&a, &expected_a)) return 0;
+    if (bignum_shift_right_signed(&a, -1) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW || !bignum_are_equal(&a, &expected_a)) return 0;
+
+    bignum_t b = {.words = {0x1}, .len = 1};
+    bignum_t b_copy = b;
+    if (bignum_shift_right_signed(&b, -(ptrdiff_t)(64 * BIGNUM_CAPACITY)) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+    if (bignum_shift_right_signed(&b, PTRDIFF_MIN) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+    return bignum_are_equal(&b, &b_copy);
+}
+
+/**
+ * @brief      Тест: сдвиг числа длиннее BIGNUM_CAPACITY через bignum_view_t всеми ядрами.
+ * @pre        view = {буфер из 4 * CAPACITY + 37 слов, len = cap - 1}; слово за len — метка;
+ *             сдвиги 0, 1, 63, 64, 64 * CAPACITY + 5 и за пределы len
+ * @post       Слова совпадают с эталоном, освободившиеся слова обнулены, метка не тронута
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_view_shift_long_numbers() {
+    enum { CAP = 4 * BIGNUM_CAPACITY + 37 };
+    static uint64_t buf[CAP], ref[CAP];
+    static const size_t shifts[] = {0, 1, 63, 64, 64 * BIGNUM_CAPACITY + 5, 64 * (CAP - 2) + 7, 64 * CAP};
+    int ok = 1;
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; ++k) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) continue;
+        for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]) && ok; ++j) {
+            size_t len = CAP - 1, shift = shifts[j];
+            for (size_t i = 0; i < len; ++i) buf[i] = 0x8000000000000000ULL | (i * 0x9E3779B97F4A7C15ULL);
+            buf[len] = 0x5E5E5E5E5E5E5E5EULL;
+            size_t ws = shift / 64, bs = shift % 64, exp_len = len > ws ? len - ws : 0;
+            for (size_t i = 0; i < exp_len; ++i) {
+                uint64_t lo = buf[i + ws], hi = (i + ws + 1 < len) ? buf[i + ws + 1] : 0;
+                ref[i] = bs ? (lo >> bs) | (hi << (64 - bs)) : lo;
+            }
+            while (exp_len > 0 && ref[exp_len - 1] == 0) exp_len--;
+            bignum_view_t view = {.words = buf, .len = len, .cap = CAP};
+            bignum_shift_right_status_t st = bignum_shift_right_view(&view, shift);
+            bignum_shift_right_status_t exp_st = (exp_len == 0 && shift != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+            int words_ok = memcmp(buf, ref, exp_len * sizeof(uint64_t)) == 0;
+            for (size_t i = exp_len; i < len; ++i) words_ok &= buf[i] == 0;
+            if (st != exp_st || view.len != exp_len || !words_ok || buf[len] != 0x5E5E5E5E5E5E5E5EULL) {
+                fprintf(stderr, "FAIL: kernel %d, shift %zu, len %zu (expected %zu)\n", k, shift, view.len, exp_len);
+                ok = 0;
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    bignum_view_t empty = {.words = NULL, .len = 0, .cap = 0};
+    bignum_view_t broken = {.words = NULL, .len = 1, .cap = 1};
+    if (bignum_shift_right_view(&empty, 5) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (bignum_shift_right_view(&broken, 5) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_view(NULL, 5) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return ok;
+}
+
+/**
+ * @brief Потоковое ядро: порог снижен до 2 слов, буфер сдвинут на 0 и 1 слово
+ *        (выровненный и невыровненный на 16 байт dst), длины 2..40 слов.
+ */
+int test_view_stream_store() {
+    enum { CAP = 48 };
+    static uint64_t buf[CAP + 1], ref[CAP];
+    static const size_t shifts[] = {1, 63, 64 + 1, 64 * 3 + 17};
+    size_t prev = bignum_shift_right_set_stream_threshold(2);
+    if (prev != BIGNUM_SHIFT_RIGHT_STREAM_OFF) return 0;
+    int ok = 1;
+    for (size_t off = 0; off < 2 && ok; ++off) {
+        uint64_t* words = buf + off;
+        for (size_t len = 2; len <= 40 && ok; ++len) {
+            for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]) && ok; ++j) {
+                size_t shift = shifts[j], ws = shift / 64, bs = shift % 64;
+                if (ws >= len) continue;
+                for (size_t i = 0; i < len; ++i) words[i] = 0x8000000000000001ULL ^ (i * 0x9E3779B97F4A7C15ULL);
+                words[len] = 0x5E5E5E5E5E5E5E5EULL;
+                size_t exp_len = len - ws;
+                for (size_t i = 0; i < exp_len; ++i) {
+                    uint64_t lo = words[i + ws], hi = (i + ws + 1 < len) ? words[i + ws + 1] : 0;
+                    ref[i] = (lo >> bs) | (hi << (64 - bs));
+                }
+                while (exp_len > 0 && ref[exp_len - 1] == 0) exp_len--;
+                bignum_view_t view = {.words = words, .len = len, .cap = len + 1};
+                bignum_shift_right_view(&view, shift);
+                int words_ok = memcmp(words, ref, exp_len * sizeof(uint64_t)) == 0;
+                for (size_t i = exp_len; i < len; ++i) words_ok &= words[i] == 0;
+                if (view.len != exp_len || !words_ok || words[len] != 0x5E5E5E5E5E5E5E5EULL) {
+                    fprintf(stderr, "FAIL: offset %zu, len %zu, shift %zu\n", off, len, shift);
+                    ok = 0;
+                }
+            }
+        }
+    }
+    if (bignum_shift_right_set_stream_threshold(BIGNUM_SHIFT_RIGHT_STREAM_RECOMMENDED_WORDS) != 2) ok = 0;
+    if (bignum_shift_right_set_stream_threshold(BIGNUM_SHIFT_RIGHT_STREAM_OFF) != BIGNUM_SHIFT_RIGHT_STREAM_RECOMMENDED_WORDS) ok = 0;
+    return ok;
+}
+
+/**
+ * @brief bignum_shift_right_ct совпадает с bignum_shift_right для всех сдвигов
+ *        0 .. CAPACITY * 64 + 65 и нескольких длин, включая пустое число.
+ */
+int test_shift_ct_matches_shift_right() {
+    static const size_t lens[] = {0, 1, 2, BIGNUM_CAPACITY / 2 + 1, BIGNUM_CAPACITY};
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        bignum_t src = {0};
+        src.len = lens[l] > BIGNUM_CAPACITY ? BIGNUM_CAPACITY : lens[l];
+        for (size_t i = 0; i < src.len; ++i) src.words[i] = 0x0123456789ABCDEFULL * (i + 3) | 1;
+        if (src.len) src.words[src.len - 1] |= 1ULL << 63;
+        for (size_t shift = 0; shift <= BIGNUM_CAPACITY * 64 + 65; ++shift) {
+            bignum_t a = src, b = src;
+            bignum_shift_right_status_t st_a = bignum_shift_right(&a, shift);
+            bignum_shift_right_status_t st_b = bignum_shift_right_ct(&b, shift);
+            if (st_a != st_b || a.len != b.len || memcmp(a.words, b.words, sizeof(a.words)) != 0) {
+                fprintf(stderr, "FAIL: len %zu, shift %zu: status %d/%d, len %zu/%zu\n",
+                        (size_t)src.len, shift, st_a, st_b, (size_t)a.len, (size_t)b.len);
+                return 0;
+            }
+        }
+    }
+    bignum_t big = {{1}, 1};
+    if (bignum_shift_right_ct(&big, SIZE_MAX) != BIGNUM_SHIFT_RIGHT_ZEROED || big.len != 0) return 0;
+    if (bignum_shift_right_ct(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
+/**
+ * @brief bignum_lazy_t: цепочка отложенных сдвигов не трогает слова,
+ *        get_word и материализация совпадают с последовательными сдвигами.
+ */
+int test_lazy_shift_chain() {
+    static const size_t chains[][3] = {
+        {3, 61, 7}, {0, 0, 0}, {64, 64, 1}, {1, 63, 64 * (BIGNUM_CAPACITY - 2)},
+        {SIZE_MAX, 1, 5}, {17, 64 * BIGNUM_CAPACITY, 0}, {127, 0, 129},
+    };
+    bignum_t src = {0};
+    src.len = BIGNUM_CAPACITY;
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) src.words[i] = 0xF0E1D2C3B4A59687ULL * (i + 1) | 1;
+    src.words[BIGNUM_CAPACITY - 1] |= 1ULL << 63;
+    for (size_t c = 0; c < sizeof(chains) / sizeof(chains[0]); ++c) {
+        bignum_t eager = src;
+        bignum_lazy_t lz = {src, 0};
+        for (size_t k = 0; k < 3; ++k) {
+            bignum_shift_right(&eager, chains[c][k]);
+            if (bignum_lazy_shift_right(&lz, chains[c][k]) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+        }
+        if (memcmp(src.words, lz.num.words, sizeof(src.words)) != 0) return 0;  /* Слова не тронуты. */
+        for (size_t i = 0; i < BIGNUM_CAPACITY + 2; ++i) {
+            uint64_t expected = i < BIGNUM_CAPACITY ? eager.words[i] : 0;
+            if (bignum_lazy_get_word(&lz, i) != expected) {
+                fprintf(stderr, "FAIL: chain %zu, word %zu\n", c, i);
+                return 0;
+            }
+        }
+        bignum_shift_right_status_t st_lazy = bignum_lazy_materialize(&lz);
+        int shifted = chains[c][0] || chains[c][1] || chains[c][2];
+        if (lz.pending != 0 || lz.num.len != eager.len ||
+            memcmp(lz.num.words, eager.words, sizeof(eager.words)) != 0) return 0;
+        /* Цепочка после обнуления возвращает SUCCESS, единый сдвиг — ZEROED. */
+        if (shifted && st_lazy != (eager.len == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS)) return 0;
+        if (bignum_lazy_materialize(&lz) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;  /* Повторно — без работы. */
+    }
+    if (bignum_lazy_shift_right(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_lazy_materialize(NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_lazy_get_word(NULL, 0) != 0) return 0;
+    return 1;
+}
+
+/**
+ * @brief bignum_shift_right_ctz для всех длин и ctz (по границам слов),
+ *        нуля (в том числе ненормализованного) и NULL-аргументов.
+ */
+int test_shift_ctz() {
+    for (size_t len = 1; len <= BIGNUM_CAPACITY; ++len) {
+        for (size_t k = 0; k < len * 64; k += (k < 130 ? 1 : 37)) {
+            bignum_t num = {0}, expected;
+            num.len = len;
+            num.words[len - 1] = 0x8000000000000000ULL | 0x5A5A5A5A5A5A5A5AULL;
+            if (len > 1) num.words[len - 2] = 0xDEADBEEFCAFEBABEULL;
+            /* Младшие k бит обнуляются, бит k устанавливается: ctz == k. */
+            for (size_t i = 0; i < k / 64; ++i) num.words[i] = 0;
+            num.words[k / 64] &= ~0ULL << (k % 64);
+            num.words[k / 64] |= 1ULL << (k % 64);
+            expected = num;
+            bignum_shift_right(&expected, k);
+            size_t shifted = 12345;
+            if (bignum_shift_right_ctz(&num, &shifted) != BIGNUM_SHIFT_RIGHT_SUCCESS || shifted != k ||
+                num.len != expected.len || memcmp(num.words, expected.words, sizeof(num.words)) != 0 ||
+                (num.words[0] & 1) == 0) {
+                fprintf(stderr, "FAIL: len %zu, ctz %zu, got %zu\n", len, k, shifted);
+                return 0;
+            }
+        }
+    }
+    bignum_t zero = {0};
+    size_t shifted = 7;
+    if (bignum_shift_right_ctz(&zero, &shifted) != BIGNUM_SHIFT_RIGHT_ZEROED || shifted != 0 || zero.len != 0) return 0;
+    zero.len = 2;  /* Ненормализованный ноль: обнуляется с len = 0. */
+    if (bignum_shift_right_ctz(&zero, &shifted) != BIGNUM_SHIFT_RIGHT_ZEROED || zero.len != 0) return 0;
+    if (bignum_shift_right_ctz(NULL, &shifted) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_ctz(&zero, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
+/**
+ * @brief bignum_shift_right_soa для каждого ядра: pack, сдвиг и unpack совпадают
+ *        с bignum_shift_right_batch_uniform; count не кратен ширине вектора,
+ *        часть чисел короче пакета.
+ */
+int test_soa_matches_batch() {
+    static const size_t counts[] = {1, 3, 4, 7, 8, 13, 33};
+    static const size_t shifts[] = {0, 1, 37, 63, 64, 64 + 9, 64 * (BIGNUM_CAPACITY - 1) + 1,
+                                    64 * BIGNUM_CAPACITY};
+    static bignum_t nums[33], expected[33], got[33];
+    static uint64_t words[33 * BIGNUM_CAPACITY];
+    int ok = 1;
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; ++k) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) {
+            printf("Kernel %d is not supported on this CPU, skipped\n", k);
+            continue;
+        }
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]) && ok; ++c) {
+            size_t count = counts[c];
+            for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]) && ok; ++j) {
+                for (size_t n = 0; n < count; ++n) {
+                    memset(&nums[n], 0, sizeof(nums[n]));
+                    nums[n].len = (n % 3 == 2) ? BIGNUM_CAPACITY / 2 + 1 : BIGNUM_CAPACITY;
+                    for (size_t i = 0; i < nums[n].len; ++i) nums[n].words[i] = (n * 131 + i + 1) * 0x9E3779B97F4A7C15ULL;
+                    nums[n].words[nums[n].len - 1] |= 1ULL << (n % 64);
+                    expected[n] = nums[n];
+                }
+                bignum_shift_right_batch_uniform(expected, shifts[j], count, NULL);
+                bignum_soa_t soa = {words, 0, 0};
+                if (bignum_shift_right_soa_pack(&soa, nums, count) != BIGNUM_SHIFT_RIGHT_SUCCESS ||
+                    soa.count != count || soa.len != BIGNUM_CAPACITY) { ok = 0; break; }
+                bignum_shift_right_status_t st = bignum_shift_right_soa(&soa, shifts[j]);
+                memset(got, 0xA5, sizeof(got));
+                if (bignum_shift_right_soa_unpack(got, &soa) != BIGNUM_SHIFT_RIGHT_SUCCESS) { ok = 0; break; }
+                size_t max_len = 0;
+                for (size_t n = 0; n < count; ++n) {
+                    if (expected[n].len > max_len) max_len = expected[n].len;
+                    if (!bignum_are_equal(&got[n], &expected[n]) ||
+                        memcmp(got[n].words, expected[n].words, sizeof(got[n].words)) != 0) {
+                        fprintf(stderr, "FAIL: kernel %d, count %zu, shift %zu, number %zu\n",
+                                k, count, shifts[j], n);
+                        ok = 0;
+                        break;
+                    }
+                }
+                int zeroed = shifts[j] != 0 && max_len == 0;
+                if (ok && (soa.len != max_len || st != (zeroed ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS))) {
+                    fprintf(stderr, "FAIL: kernel %d, count %zu, shift %zu: len %zu/%zu, status %d\n",
+                            k, count, shifts[j], soa.len, max_len, st);
+                    ok = 0;
+                }
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+
+    bignum_soa_t soa = {words, 1, BIGNUM_CAPACITY + 1};
+    if (bignum_shift_right_soa_unpack(got, &soa) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+    bignum_soa_t null_words = {NULL, 1, 1};
+    if (bignum_shift_right_soa(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_soa(&null_words, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_soa_pack(&null_words, nums, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_soa_unpack(got, &null_words) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return ok;
+}
+
+/**
+ * @brief bignum_shift_right_unchecked совпадает с bignum_shift_right для всех
+ *        длин и сдвигов 0 .. CAPACITY * 64 + 1, включая len == 0 и shift == 0,
+ *        которые идут общим путем без быстрого выхода.
+ */
+int test_shift_unchecked_matches_shift_right() {
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        bignum_t src = {0};
+        src.len = len;
+        for (size_t i = 0; i < len; ++i) src.words[i] = 0xC3A5C85C97CB3127ULL * (i + 7);
+        if (len) src.words[len - 1] |= 1ULL << 62;
+        for (size_t shift = 0; shift <= BIGNUM_CAPACITY * 64 + 1; shift += (shift < 140 ? 1 : 29)) {
+            bignum_t expected = src, got = src;
+            bignum_shift_right(&expected, shift);
+            bignum_shift_right_unchecked(&got, shift);
+            if (got.len != expected.len || memcmp(got.words, expected.words, sizeof(got.words)) != 0) {
+                fprintf(stderr, "FAIL: len %zu, shift %zu\n", len, shift);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Статистика bignum_shift_right: по одному вызову на каждый путь и
+ *        гистограмма исходных len; reset обнуляет счетчики. Без INSTRUMENT —
+ *        ERROR_UNSUPPORTED и обнуленная структура.
+ */
+int test_shift_stats() {
+    bignum_shift_right_stats_t stats;
+    memset(&stats, 0xA5, sizeof(stats));
+    if (bignum_shift_right_stats_get(NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+#ifndef BIGNUM_SHIFT_RIGHT_INSTRUMENT
+    if (bignum_shift_right_stats_get(&stats) != BIGNUM_SHIFT_RIGHT_ERROR_UNSUPPORTED) return 0;
+    for (size_t i = 0; i < sizeof(stats) / sizeof(uint64_t); ++i) {
+        if (((const uint64_t*)&stats)[i] != 0) return 0;
+    }
+    return 1;
+#else
+    bignum_shift_right_stats_reset();
+    bignum_t num = {0};
+    bignum_shift_right(NULL, 1);                                      /* NULL_ARG */
+    bignum_shift_right(&num, 5);                                      /* SUCCESS_ZERO: len == 0 */
+    num.len = 2; num.words[0] = 0xF0; num.words[1] = 1;
+    bignum_shift_right(&num, 0);                                      /* SUCCESS_ZERO: shift == 0 */
+    bignum_shift_right(&num, 4);                                      /* BIT */
+    num.len = 2; num.words[0] = 0xF0; num.words[1] = 1;
+    bignum_shift_right(&num, 64);                                     /* WORD */
+    num.len = 2; num.words[0] = 0xF0; num.words[1] = 0x10;
+    bignum_shift_right(&num, 65);                                     /* COMBINED */
+    num.len = 2; num.words[0] = 0xF0; num.words[1] = 1;
+    bignum_shift_right(&num, 128);                                    /* ZERO_OUT */
+
+    static const uint64_t expected_calls[BIGNUM_SHIFT_RIGHT_PATH_COUNT] = {1, 2, 1, 1, 1, 1};
+    if (bignum_shift_right_stats_get(&stats) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    for (int p = 0; p < BIGNUM_SHIFT_RIGHT_PATH_COUNT; ++p) {
+        if (stats.calls[p] != expected_calls[p]) {
+            fprintf(stderr, "FAIL: path %d: %llu calls, expected %llu\n", p,
+                    (unsigned long long)stats.calls[p], (unsigned long long)expected_calls[p]);
+            return 0;
+        }
+#ifdef BIGNUM_SHIFT_RIGHT_INSTRUMENT_CYCLES
+        if (stats.cycles[p] == 0) return 0;
+#else
+        if (stats.cycles[p] != 0) return 0;
+#endif
+    }
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        uint64_t expected = len == 0 ? 1 : len == 2 ? 5 : 0;
+        if (stats.len_hist[len] != expected) {
+            fprintf(stderr, "FAIL: len_hist[%zu] = %llu, expected %llu\n", len,
+                    (unsigned long long)stats.len_hist[len], (unsigned long long)expected);
+            return 0;
+        }
+    }
+
+    bignum_shift_right_stats_reset();
+    if (bignum_shift_right_stats_get(&stats) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    for (size_t i = 0; i < sizeof(stats) / sizeof(uint64_t); ++i) {
+        if (((const uint64_t*)&stats)[i] != 0) return 0;
+    }
+    return 1;
+#endif
+}
+
+/**
+ * @brief bignum_shift_right_bits_only (1..63), bignum_shift_right_words_only
+ *        (кратные 64, включая 0 и полный сдвиг) и bignum_shift_right_dispatch
+ *        совпадают с bignum_shift_right по словам, len и статусу для всех длин.
+ */
+int test_class_entry_points_match() {
+    for (size_t len = 0; len <= BIGNUM_CAPACITY; ++len) {
+        bignum_t src = {0};
+        src.len = len;
+        for (size_t i = 0; i < len; ++i) src.words[i] = 0x9E3779B97F4A7C15ULL * (i + 3);
+        if (len) src.words[len - 1] = (src.words[len - 1] >> 20) | 1;
+        for (size_t shift = 0; shift <= BIGNUM_CAPACITY * 64 + 64; ++shift) {
+            bignum_t expected = src, got = src;
+            bignum_shift_right_status_t st_exp = bignum_shift_right(&expected, shift), st;
+            if (shift % 64 == 0 || shift < 64) {
+                st = shift % 64 == 0 ? bignum_shift_right_words_only(&got, shift)
+                                     : bignum_shift_right_bits_only(&got, shift);
+                if (st != st_exp || got.len != expected.len || memcmp(got.words, expected.words, sizeof(got.words)) != 0) {
+                    fprintf(stderr, "FAIL: class entry, len %zu, shift %zu: status %d/%d\n", len, shift, st, st_exp);
+                    return 0;
+                }
+                got = src;
+            }
+            st = bignum_shift_right_dispatch(&got, shift);
+            if (st != st_exp || got.len != expected.len || memcmp(got.words, expected.words, sizeof(got.words)) != 0) {
+                fprintf(stderr, "FAIL: dispatch, len %zu, shift %zu: status %d/%d\n", len, shift, st, st_exp);
+                return 0;
+            }
+        }
+    }
+    if (bignum_shift_right_bits_only(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_words_only(NULL, 64) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_dispatch(NULL, 65) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
+/**
+ * @brief bignum_shift_right_stats_profile: классы по убыванию вызовов, классы
+ *        не чаще прочих сдвигов отбрасываются, длина — как у snprintf.
+ */
+int test_stats_profile_order() {
+    static const struct {
+        uint64_t bit, word, other;
+        const char* order;
+    } cases[] = {
+        {900, 50, 10, "(X) X(BIT) X(WORD)\n"},
+        {50, 900, 10, "(X) X(WORD) X(BIT)\n"},
+        {900, 5, 10, "(X) X(BIT)\n"},
+        {5, 5, 10, "(X)\n"},
+        {7, 7, 0, "(X) X(BIT) X(WORD)\n"},
+    };
+    char buf[256];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        bignum_shift_right_stats_t stats = {0};
+        stats.calls[BIGNUM_SHIFT_RIGHT_PATH_BIT] = cases[i].bit;
+        stats.calls[BIGNUM_SHIFT_RIGHT_PATH_WORD] = cases[i].word;
+        stats.calls[BIGNUM_SHIFT_RIGHT_PATH_COMBINED] = cases[i].other;
+        stats.calls[BIGNUM_SHIFT_RIGHT_PATH_SUCCESS_ZERO] = 1000;  /* Не влияет на порядок. */
+        size_t n = bignum_shift_right_stats_profile(&stats, buf, sizeof(buf));
+        const char* define = strstr(buf, "#define BIGNUM_SHIFT_RIGHT_PROFILE_ORDER");
+        if (n != strlen(buf) || !define || strcmp(define + strlen("#define BIGNUM_SHIFT_RIGHT_PROFILE_ORDER"), cases[i].order) != 0) {
+            fprintf(stderr, "FAIL: profile case %zu: %s", i, buf);
+            return 0;
+        }
+        if (bignum_shift_right_stats_profile(&stats, NULL, 0) != n) return 0;
+    }
+    return bignum_shift_right_stats_profile(NULL, buf, sizeof(buf)) == 0;
+}
+
+/**
+ * @brief      Тест: слоты пула выровнены, не пересекаются, выдаются нулевыми,
+ *             освобожденный слот выдается снова; при исчерпании — NULL.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_pool_alloc_free() {
+    enum { SLOTS = 5 };
+    if (bignum_pool_create(0) != NULL) return 0;
+    if (bignum_pool_alloc(NULL) != NULL) return 0;
+    bignum_pool_destroy(NULL);
+    bignum_pool_t* pool = bignum_pool_create(SLOTS);
+    if (!pool) return 0;
+    bignum_t* nums[SLOTS];
+    int ok = 1;
+    for (int i = 0; i < SLOTS && ok; ++i) {
+        nums[i] = bignum_pool_alloc(pool);
+        if (!nums[i] || (uintptr_t)nums[i] % BIGNUM_POOL_ALIGN != 0 || nums[i]->len != 0) ok = 0;
+        for (int j = 0; j < i && ok; ++j) {
+            uintptr_t d = (uintptr_t)nums[i] > (uintptr_t)nums[j] ? (uintptr_t)nums[i] - (uintptr_t)nums[j]
+                                                                   : (uintptr_t)nums[j] - (uintptr_t)nums[i];
+            if (d < BIGNUM_POOL_SLOT_SIZE) ok = 0;
+        }
+        if (ok) memset(nums[i]->words, 0xA5, sizeof(nums[i]->words));
+        if (ok) nums[i]->len = BIGNUM_CAPACITY;
+    }
+    if (ok && bignum_pool_alloc(pool) != NULL) ok = 0;
+    if (ok) {
+        bignum_pool_free(pool, NULL);
+        bignum_pool_free(pool, nums[2]);
+        bignum_t* again = bignum_pool_alloc(pool);
+        bignum_t zero = {0};
+        if (again != nums[2] || memcmp(again, &zero, sizeof(zero)) != 0) ok = 0;
+    }
+    bignum_pool_destroy(pool);
+    return ok;
+}
+
+/**
+ * @brief      Тест: bignum_shift_right_batch_ptr и bignum_shift_right_to над
+ *             слотами пула (выровненные dst и src) на каждом ядре совпадают
+ *             со скалярным bignum_shift_right; NULL-элемент — ERROR_NULL_ARG.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_pool_batch_ptr_all_kernels() {
+    enum { COUNT = 4 };
+    static const size_t shifts[] = {0, 1, 13, 63, 64, 64 + 5, 64 * 3 + 33, BIGNUM_CAPACITY * 64};
+    bignum_pool_t* pool = bignum_pool_create(COUNT + 1);
+    if (!pool) return 0;
+    bignum_t* nums[COUNT + 1];
+    for (int i = 0; i <= COUNT; ++i) nums[i] = bignum_pool_alloc(pool);
+    bignum_t* dst = nums[COUNT];
+    nums[COUNT] = NULL;    // Последний элемент пакета — NULL
+    int ok = 1;
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; ++k) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) {
+            printf("Kernel %d is not supported on this CPU, skipped\n", k);
+            continue;
+        }
+        for (size_t len = 1; len <= BIGNUM_CAPACITY && ok; ++len) {
+            for (size_t j = 0; j < sizeof(shifts) / sizeof(shifts[0]) && ok; ++j) {
+                bignum_t expected[COUNT];
+                bignum_shift_right_status_t st_exp[COUNT], st[COUNT + 1];
+                for (int e = 0; e < COUNT; ++e) {
+                    size_t n = len > (size_t)e ? len - e : 1;
+                    memset(nums[e], 0, sizeof(bignum_t));
+                    for (size_t i = 0; i < n; ++i) nums[e]->words[i] = (i + 1 + e) * 0x9E3779B97F4A7C15ULL;
+                    nums[e]->len = n;
+                    expected[e] = *nums[e];
+                }
+                bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR);
+                for (int e = 0; e < COUNT; ++e) st_exp[e] = bignum_shift_right(&expected[e], shifts[j]);
+                bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k);
+
+                // Сдвиг без копирования между слотами: dst и src выровнены
+                bignum_shift_right_status_t st_to = bignum_shift_right_to(dst, nums[0], shifts[j]);
+                if (st_to != st_exp[0] || !bignum_are_equal(dst, &expected[0])) {
+                    fprintf(stderr, "FAIL: shift_to between pool slots, kernel %d, len %zu, shift %zu\n", k, len, shifts[j]);
+                    ok = 0;
+                }
+                if (bignum_shift_right_batch_ptr(nums, shifts[j], COUNT + 1, st) != BIGNUM_SHIFT_RIGHT_SUCCESS) ok = 0;
+                if (st[COUNT] != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) ok = 0;
+                for (int e = 0; e < COUNT && ok; ++e) {
+                    if (st[e] != st_exp[e] || !bignum_are_equal(nums[e], &expected[e])) {
+                        fprintf(stderr, "FAIL: batch_ptr, kernel %d, len %zu, shift %zu, element %d\n", k, len, shifts[j], e);
+                        ok = 0;
+                    }
+                }
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    if (bignum_shift_right_batch_ptr(NULL, 1, 1, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) ok = 0;
+    if (bignum_shift_right_batch_ptr(NULL, 1, 0, NULL) != BIGNUM_SHIFT_RIGHT_SUCCESS) ok = 0;
+    bignum_pool_destroy(pool);
+    return ok;
+}
+
+/**
+ * @brief      Тест: big-endian экспорт src >> k с ведущими нулями, неполным
+ *             старшим словом, ушедшим старшим словом и переполнением буфера.
+ * @pre        src = {0x1122334455667788, 0x99AABBCCDDEEFF00, 0x0123456789ABCDEF, len=3}
+ * @post       Байты совпадают с эталоном, src не изменен; при OVERFLOW out не изменен.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_export_be() {
+    bignum_t src = {.words = {0x1122334455667788ULL, 0x99AABBCCDDEEFF00ULL, 0x0123456789ABCDEFULL}, .len = 3};
+    bignum_t src_copy = src;
+    uint8_t out[32];
+    uint8_t ff[32];
+    memset(ff, 0xA5, sizeof(ff));
+
+    // k = 4: 23 значащих байта
+    static const uint8_t expected_4[24] = {
+        0x00, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF9, 0x9A, 0xAB, 0xBC,
+        0xCD, 0xDE, 0xEF, 0xF0, 0x01, 0x12, 0x23, 0x34, 0x45, 0x56, 0x67, 0x78};
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 4, out, 24) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (memcmp(out, expected_4, 24) != 0 || out[24] != 0xA5) return 0;
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 4, out, 23) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (memcmp(out, expected_4 + 1, 23) != 0 || out[23] != 0xA5) return 0;
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 4, out, 30) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    for (int i = 0; i < 6; ++i) if (out[i] != 0) return 0;
+    if (memcmp(out + 6, expected_4, 24) != 0) return 0;
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 4, out, 22) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+    if (memcmp(out, ff, sizeof(out)) != 0) return 0;
+
+    // k = 72: сдвиг через слово, 15 байт
+    static const uint8_t expected_72[16] = {
+        0x00, 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x99, 0xAA, 0xBB,
+        0xCC, 0xDD, 0xEE, 0xFF};
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 72, out, 15) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (memcmp(out, expected_72 + 1, 15) != 0) return 0;
+    if (bignum_shift_right_export_be(&src, 72, out, 16) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (memcmp(out, expected_72, 16) != 0) return 0;
+    if (bignum_shift_right_export_be(&src, 0, out, 24) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (out[0] != 0x01 || out[7] != 0xEF || out[23] != 0x88) return 0;
+    if (memcmp(&src, &src_copy, sizeof(src)) != 0) { fprintf(stderr, "FAIL: src was modified\n"); return 0; }
+
+    // Старшее слово уходит целиком, его биты переходят в нижнее
+    bignum_t carry = {.words = {0xFFFFFFFFFFFFFFFFULL, 0x1}, .len = 2};
+    static const uint8_t expected_carry[8] = {0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    if (bignum_shift_right_export_be(&carry, 4, out, 8) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (memcmp(out, expected_carry, 8) != 0) return 0;
+    if (bignum_shift_right_export_be(&carry, 4, out, 7) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+
+    // Нулевой результат: буфер заполняется нулями
+    bignum_t one = {.words = {0x1}, .len = 1};
+    bignum_t zero = {.len = 0};
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&src, 3 * 64, out, 13) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    for (int i = 0; i < 13; ++i) if (out[i] != 0) return 0;
+    if (out[13] != 0xA5) return 0;
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&one, 1, out, 9) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    for (int i = 0; i < 9; ++i) if (out[i] != 0) return 0;
+    memset(out, 0xA5, sizeof(out));
+    if (bignum_shift_right_export_be(&zero, 0, out, 3) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (out[0] != 0 || out[1] != 0 || out[2] != 0 || out[3] != 0xA5) return 0;
+
+    if (bignum_shift_right_export_be(NULL, 0, out, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_export_be(&src, 0, NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_export_be(&zero, 0, NULL, 0) != BIGNUM_SHIFT_RIGHT_SUCCESS) return 0;
+    if (bignum_shift_right_export_be(&src, 0, NULL, 0) != BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW) return 0;
+    return 1;
+}
+
+/**
+ * @brief      Тест: сдвиг на величину bignum_t; при amount->len > 1 — насыщение,
+ *             у _by_nz насыщение записывает только len = 0.
+ * @pre        num = {0x0123456789ABCDEF, 0xFEDCBA9876543210, 0x1, len=3}
+ * @post       Совпадает с bignum_shift_right на amount->words[0]; при насыщении
+ *             len = 0 и ZEROED, слова _by обнулены, слова _by_nz не тронуты.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_by() {
+    const bignum_t base = {.words = {0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL, 0x1}, .len = 3};
+    const size_t shifts[] = {0, 1, 63, 64, 68, 128, 129, 191, 192, 1000};
+    for (size_t i = 0; i < sizeof(shifts) / sizeof(shifts[0]); ++i) {
+        bignum_t amount = {.words = {shifts[i]}, .len = shifts[i] != 0};
+        bignum_t expected = base, num = base, num_nz = base;
+        bignum_shift_right_status_t status = bignum_shift_right(&expected, shifts[i]);
+        if (bignum_shift_right_by(&num, &amount) != status) return 0;
+        if (memcmp(&num, &expected, sizeof(num)) != 0) return 0;
+        if (bignum_shift_right_by_nz(&num_nz, &amount) != status) return 0;
+        // Слова за len у _by_nz не определены: сравниваются только words[0 .. len)
+        if (num_nz.len != expected.len || memcmp(num_nz.words, expected.words, expected.len * sizeof(uint64_t)) != 0) return 0;
+    }
+
+    // amount >= 2^64: O(1) насыщение без сведения к size_t
+    bignum_t huge = {.words = {0, 1}, .len = 2};
+    bignum_t zero = {.len = 0};
+    bignum_t num = base;
+    if (bignum_shift_right_by(&num, &huge) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (memcmp(&num, &zero, sizeof(num)) != 0) return 0;
+    num = base;
+    if (bignum_shift_right_by_nz(&num, &huge) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (num.len != 0 || memcmp(num.words, base.words, sizeof(num.words)) != 0) return 0;
+    num = base;
+    bignum_t amount = {.words = {192}, .len = 1};
+    if (bignum_shift_right_by_nz(&num, &amount) != BIGNUM_SHIFT_RIGHT_ZEROED) return 0;
+    if (num.len != 0 || num.words[2] != 0x1) return 0;
+    if (bignum_shift_right_by(&zero, &huge) != BIGNUM_SHIFT_RIGHT_SUCCESS || zero.len != 0) return 0;
+    if (bignum_shift_right_by_nz(&zero, &huge) != BIGNUM_SHIFT_RIGHT_SUCCESS || zero.len != 0) return 0;
+
+    // amount == num: величина читается до сдвига (5 >> 5 == 0)
+    bignum_t self = {.words = {5}, .len = 1};
+    if (bignum_shift_right_by(&self, &self) != BIGNUM_SHIFT_RIGHT_ZEROED || self.len != 0) return 0;
+
+    if (bignum_shift_right_by(NULL, &huge) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_by(&num, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_by_nz(NULL, &huge) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_by_nz(&num, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
+/** Сравнивает только words[0 .. len): слова за len у входов _nz не определены. */
+static int bignum_equal_to_len(const bignum_t* a, const bignum_t* b) {
+    return a->len == b->len && memcmp(a->words, b->words, a->len * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * @brief      Тест: входы _nz не трогают слова за новым len, результат до len
+ *             совпадает с bignum_shift_right; clear_tail восстанавливает нулевой хвост.
+ * @pre        num = {0x0123456789ABCDEF, 0xFEDCBA9876543210, 0x1, len=3}, хвост 0xA5
+ * @post       words[0 .. len) и коды как у bignum_shift_right; words[len ..) не изменены.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+int test_shift_nz() {
+    const bignum_t base = {.words = {0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL, 0x1}, .len = 3};
+    const size_t shifts[] = {0, 1, 4, 63, 64, 68, 128, 129, 191, 192, 1000};
+    for (size_t i = 0; i < sizeof(shifts) / sizeof(shifts[0]); ++i) {
+        bignum_t expected = base;
+        bignum_shift_right_status_t status = bignum_shift_right(&expected, shifts[i]);
+
+        bignum_t num;
+        memset(&num, 0xA5, sizeof(num));
+        memcpy(num.words, base.words, base.len * sizeof(uint64_t));
+        num.len = base.len;
+        bignum_t before = num;
+        if (bignum_shift_right_nz(&num, shifts[i]) != status) return 0;
+        if (!bignum_equal_to_len(&num, &expected)) return 0;
+        // Слова выше words[len - word_shift] не переписываются
+        size_t written = shifts[i] / 64 < base.len ? base.len - shifts[i] / 64 : 0;
+        if (memcmp(num.words + written, before.words + written,
+                   (BIGNUM_CAPACITY - written) * sizeof(uint64_t)) != 0) return 0;
+        bignum_shift_right_clear_tail(&num);
+        if (!bignum_are_equal(&num, &expected)) return 0;
+
+        bignum_t dst;
+        memset(&dst, 0xA5, sizeof(dst));
+        if (bignum_shift_right_to_nz(&dst, &base, shifts[i]) != status) return 0;
+        if (!bignum_equal_to_len(&dst, &expected)) return 0;
+        if (written < BIGNUM_CAPACITY && dst.words[BIGNUM_CAPACITY - 1] != 0xA5A5A5A5A5A5A5A5ULL) return 0;
+
+        // Число с грязным хвостом принимают и функции без _nz
+        bignum_t dirty = before;
+        if (bignum_shift_right(&dirty, shifts[i]) != status) return 0;
+        if (!bignum_equal_to_len(&dirty, &expected)) return 0;
+    }
+
+    bignum_t zero;
+    memset(&zero, 0xA5, sizeof(zero));
+    zero.len = 0;
+    bignum_t dst;
+    if (bignum_shift_right_nz(&zero, 5) != BIGNUM_SHIFT_RIGHT_SUCCESS || zero.len != 0) return 0;
+    if (bignum_shift_right_to_nz(&dst, &zero, 5) != BIGNUM_SHIFT_RIGHT_SUCCESS || dst.len != 0) return 0;
+    bignum_shift_right_clear_tail(&zero);
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) if (zero.words[i] != 0) return 0;
+    bignum_shift_right_clear_tail(NULL);
+
+    if (bignum_shift_right_nz(NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_to_nz(NULL, &base, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    if (bignum_shift_right_to_nz(&dst, NULL, 1) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) return 0;
+    return 1;
+}
+
 int main() {
-    printf("Starting deterministic tests for bignum_shift_right 1.0.0 (rev. 10)...\n");
+    printf("Starting deterministic tests for bignum_shift_right 1.0.0 (rev. 32)...\n");
     RUN_TEST(test_shift_by_zero);
     RUN_TEST(test_simple_shift_within_word);
     RUN_TEST(test_shift_with_carry_between_words);
@@ -225,6 +1459,38 @@ int main() {
     RUN_TEST(test_shift_max_len_bignum);
     RUN_TEST(test_shift_exactly_full_length);
     RUN_TEST(test_normalization_after_shift);
+    RUN_TEST(test_batch_per_element_shifts);
+    RUN_TEST(test_batch_uniform_shift);
+    RUN_TEST(test_batch_null_and_empty);
+    RUN_TEST(test_set_kernel_validation);
+    RUN_TEST(test_all_kernels_match_scalar);
+    RUN_TEST(test_shift_to_out_of_place);
+    RUN_TEST(test_shift_to_aliased_and_null);
+    RUN_TEST(test_library_capacity_matches_header);
+    RUN_TEST(test_scalar_kernel_every_length);
+    RUN_TEST(test_inline_helpers_match_asm);
+    RUN_TEST(test_shift_rem);
+    RUN_TEST(test_shift_sticky);
+    RUN_TEST(test_shift_arith);
+    RUN_TEST(test_shift_round_modes);
+    RUN_TEST(test_extract_bits);
+    RUN_TEST(test_signed_shift_left);
+    RUN_TEST(test_signed_shift_left_overflow);
+    RUN_TEST(test_view_shift_long_numbers);
+    RUN_TEST(test_view_stream_store);
+    RUN_TEST(test_shift_ct_matches_shift_right);
+    RUN_TEST(test_lazy_shift_chain);
+    RUN_TEST(test_shift_ctz);
+    RUN_TEST(test_soa_matches_batch);
+    RUN_TEST(test_shift_unchecked_matches_shift_right);
+    RUN_TEST(test_shift_stats);
+    RUN_TEST(test_class_entry_points_match);
+    RUN_TEST(test_stats_profile_order);
+    RUN_TEST(test_pool_alloc_free);
+    RUN_TEST(test_pool_batch_ptr_all_kernels);
+    RUN_TEST(test_export_be);
+    RUN_TEST(test_shift_by);
+    RUN_TEST(test_shift_nz);
     printf("\n----------------------------------------\n");
     printf("Test summary: %d/%d tests passed.\n", tests_passed, tests_total);
     printf("----------------------------------------\n");
@@ -0,0 +1,207 @@
+/**
+ * @file    test_bignum_shift_right_dudect.c
+ * @author  git@bayborodov.com
+ * @version 1.0.0
+ * @date    14.10.2026
+ *
+ * @brief   Тест постоянного времени bignum_shift_right_ct (в стиле dudect).
+ *
+ * @details
+ *   Методика dudect (Reparaz, Balasch, Verbauwhede, "Dude, is my code
+ *   constant time?"): измерения двух классов входов перемешиваются
+ *   случайно, затем времена классов сравниваются t-критерием Уэлча.
+ *   - Класс 0: фиксированное число длины BIGNUM_CAPACITY и фиксированный сдвиг.
+ *   - Класс 1: случайные длина, слова и сдвиг (0 .. CAPACITY * 64 + 63).
+ *   Кроме полной выборки, t считается для выборок, обрезанных по
+ *   перцентилям первой партии (отсекает выбросы от прерываний). Утечка
+ *   фиксируется, если max |t| >= DUDECT_T_THRESHOLD.
+ *
+ *   Для сравнения тем же способом измеряется bignum_shift_right: его время
+ *   зависит от сдвига и длины, и большое t для него ожидаемо (только вывод).
+ *
+ *   Тест статистический и шумный, поэтому не входит в `make test`;
+ *   запуск: `make test_dudect` (желательно на простаивающем ядре).
+ *   Время — TSC на x86-64; на AArch64 — cntvct_el0, на прочих
+ *   архитектурах — clock_gettime(CLOCK_MONOTONIC_RAW). Их разрешение
+ *   грубее TSC, и тест там менее чувствителен.
+ *
+ * @history
+ *   - rev. 1 (14.10.2026): Первоначальная версия.
+ *   - rev. 2 (14.10.2026): Счетчик cntvct_el0 / CLOCK_MONOTONIC_RAW вместо TSC не на x86-64.
+ */
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime в режиме -std=c11 (не x86-64)
+
+#include "bignum_shift_right.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#  include <x86intrin.h>
+#endif
+
+#define DUDECT_BATCHES      20
+#define DUDECT_BATCH_SIZE   50000
+#define DUDECT_CROPS        10          /**< Число порогов обрезки по перцентилям. */
+#define DUDECT_T_THRESHOLD  10.0        /**< dudect: |t| > 10 — утечка с высокой уверенностью. */
+
+/** Накопитель среднего и дисперсии (алгоритм Уэлфорда) для двух классов. */
+typedef struct {
+    double mean[2];
+    double m2[2];
+    double n[2];
+} welch_t;
+
+typedef bignum_shift_right_status_t (*shift_fn_t)(bignum_t*, size_t);
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void welch_push(welch_t* w, int cls, double x) {
+    w->n[cls] += 1.0;
+    double delta = x - w->mean[cls];
+    w->mean[cls] += delta / w->n[cls];
+    w->m2[cls] += delta * (x - w->mean[cls]);
+}
+
+static double welch_value(const welch_t* w) {
+    if (w->n[0] < 2 || w->n[1] < 2) return 0.0;
+    double v0 = w->m2[0] / (w->n[0] - 1), v1 = w->m2[1] / (w->n[1] - 1);
+    double den = sqrt(v0 / w->n[0] + v1 / w->n[1]);
+    return den > 0 ? (w->mean[0] - w->mean[1]) / den : 0.0;
+}
+
+/*
+ * Время вызова: TSC на x86-64 (lfence + rdtsc ... rdtscp + lfence),
+ * cntvct_el0 с isb на AArch64, иначе наносекунды clock_gettime(CLOCK_MONOTONIC_RAW).
+ */
+static inline uint64_t tsc_begin(void) {
+#if defined(__x86_64__)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(t) : : "memory");
+    return t;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t tsc_end(void) {
+#if defined(__x86_64__)
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+    return t;
+#else
+    return tsc_begin();
+#endif
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/** Случайное нормализованное число случайной длины 0 .. BIGNUM_CAPACITY. */
+static void random_bignum(bignum_t* num) {
+    memset(num, 0, sizeof(*num));
+    num->len = (size_t)(rng_next() % (BIGNUM_CAPACITY + 1));
+    for (size_t i = 0; i < num->len; ++i) num->words[i] = rng_next();
+    while (num->len > 0 && num->words[num->len - 1] == 0) num->len--;
+}
+
+/**
+ * @brief   Измеряет fn на двух классах входов.
+ * @return  max |t| по полной выборке и всем обрезкам.
+ */
+static double measure(shift_fn_t fn) {
+    static bignum_t inputs[DUDECT_BATCH_SIZE];
+    static size_t shifts[DUDECT_BATCH_SIZE];
+    static int classes[DUDECT_BATCH_SIZE];
+    static uint64_t ticks[DUDECT_BATCH_SIZE], sorted[DUDECT_BATCH_SIZE];
+    uint64_t crops[DUDECT_CROPS];
+    welch_t tests[DUDECT_CROPS + 1];
+    memset(tests, 0, sizeof(tests));
+
+    bignum_t fixed;
+    memset(&fixed, 0, sizeof(fixed));
+    fixed.len = BIGNUM_CAPACITY;
+    for (size_t i = 0; i < BIGNUM_CAPACITY; ++i) fixed.words[i] = 0x0123456789ABCDEFULL ^ (i * 0x9E3779B97F4A7C15ULL);
+    fixed.words[BIGNUM_CAPACITY - 1] |= 1ULL << 63;
+
+    for (int batch = 0; batch < DUDECT_BATCHES; ++batch) {
+        for (size_t i = 0; i < DUDECT_BATCH_SIZE; ++i) {
+            classes[i] = (int)(rng_next() & 1);
+            if (classes[i] == 0) {
+                inputs[i] = fixed;
+                shifts[i] = 1;
+            } else {
+                random_bignum(&inputs[i]);
+                shifts[i] = (size_t)(rng_next() % (BIGNUM_CAPACITY * 64 + 64));
+            }
+        }
+        for (size_t i = 0; i < DUDECT_BATCH_SIZE; ++i) {
+            uint64_t start = tsc_begin();
+            fn(&inputs[i], shifts[i]);
+            ticks[i] = tsc_end() - start;
+        }
+        if (batch == 0) {
+            /* Пороги обрезки: перцентили 1 - 0.5^(10 * (k + 1) / CROPS), как в dudect. */
+            memcpy(sorted, ticks, sizeof(sorted));
+            qsort(sorted, DUDECT_BATCH_SIZE, sizeof(sorted[0]), cmp_u64);
+            for (int k = 0; k < DUDECT_CROPS; ++k) {
+                double p = 1.0 - pow(0.5, 10.0 * (k + 1) / DUDECT_CROPS);
+                crops[k] = sorted[(size_t)(p * (DUDECT_BATCH_SIZE - 1))];
+            }
+            continue;  /* Первая партия — прогрев и калибровка. */
+        }
+        for (size_t i = 0; i < DUDECT_BATCH_SIZE; ++i) {
+            welch_push(&tests[0], classes[i], (double)ticks[i]);
+            for (int k = 0; k < DUDECT_CROPS; ++k) {
+                if (ticks[i] < crops[k]) welch_push(&tests[k + 1], classes[i], (double)ticks[i]);
+            }
+        }
+    }
+
+    double max_t = 0.0;
+    for (int k = 0; k <= DUDECT_CROPS; ++k) {
+        double t = fabs(welch_value(&tests[k]));
+        if (t > max_t) max_t = t;
+    }
+    return max_t;
+}
+
+int main(void) {
+    printf("Starting dudect timing test for bignum_shift_right_ct (rev. 1)...\n");
+    printf("%d batches x %d measurements, threshold |t| < %.1f\n\n",
+           DUDECT_BATCHES - 1, DUDECT_BATCH_SIZE, DUDECT_T_THRESHOLD);
+
+    double t_ref = measure(bignum_shift_right);
+    printf("bignum_shift_right    (reference, variable time): max |t| = %8.2f\n", t_ref);
+    double t_ct = measure(bignum_shift_right_ct);
+    printf("bignum_shift_right_ct (constant time):            max |t| = %8.2f\n", t_ct);
+
+    int ok = t_ct < DUDECT_T_THRESHOLD;
+    printf("\n----------------------------------------\n");
+    printf("dudect summary: %s\n", ok ? "no timing leak detected" : "TIMING LEAK DETECTED");
+    printf("----------------------------------------\n");
+    return ok ? 0 : 1;
+}
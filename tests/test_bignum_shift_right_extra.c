@@ -30,6 +30,21 @@
  *   - rev. 9 (11.08.2025): Код тестов предоставлен пользователем. Добавлена
  *                         исчерпывающая документация. Восстановлена полная
  *                         и честная история ревизий.
+ *   - rev. 10 (14.10.2026): Добавлен фаззинг пакетного API против GMP.
+ *   - rev. 11 (14.10.2026): Фаззинг против GMP для каждого поддерживаемого ядра.
+ *   - rev. 12 (14.10.2026): Фаззинг bignum_shift_right_to против GMP.
+ *   - rev. 13 (14.10.2026): Фаззинг bignum_shift_right_rem и bignum_shift_right_sticky против GMP.
+ *   - rev. 14 (14.10.2026): Фаззинг арифметического сдвига против mpz_fdiv_q_2exp.
+ *   - rev. 15 (14.10.2026): Фаззинг режимов округления против GMP.
+ *   - rev. 16 (14.10.2026): Фаззинг извлечения битового окна против GMP.
+ *   - rev. 17 (14.10.2026): Фаззинг сдвига со знаком против mpz_mul_2exp / mpz_tdiv_q_2exp.
+ *   - rev. 18 (14.10.2026): Фаззинг bignum_shift_right_view на числах до 8 * BIGNUM_CAPACITY слов.
+ *   - rev. 19 (14.10.2026): Фаззинг сдвига за постоянное время против GMP.
+ *   - rev. 20 (14.10.2026): Фаззинг bignum_shift_right_ctz против mpz_scan1.
+ *   - rev. 21 (14.10.2026): Перебор ядер включает NEON (реализация на C, AArch64).
+ *   - rev. 22 (14.10.2026): Фаззинг bignum_shift_right_export_be против mpz_export.
+ *   - rev. 23 (14.10.2026): Фаззинг bignum_shift_right_by и _by_nz против GMP.
+ *   - rev. 24 (14.10.2026): Фаззинг режима «грязного хвоста» (_nz) против GMP.
  */
 
 #include "bignum_shift_right.h"
@@ -132,6 +147,28 @@ static int bignum_from_gmp(bignum_t *dst, const mpz_t src) {
     return 1;
 }
 
+/**
+ * @internal
+ * @brief Конвертирует mpz_t со знаком → минимальный дополнительный код в bignum_t.
+ * @return 1 при успехе, 0 при переполнении.
+ */
+static int bignum_from_gmp_signed(bignum_t *dst, const mpz_t src) {
+    mpz_t m, t;
+    mpz_inits(m, t, NULL);
+    if (mpz_sgn(src) >= 0) mpz_set(m, src); else { mpz_neg(m, src); mpz_sub_ui(m, m, 1); }
+    size_t bits = mpz_sgn(m) ? mpz_sizeinbase(m, 2) : 0;
+    size_t len = (mpz_sgn(src) == 0) ? 0 : (bits + 1 + 63) / 64; /* +1 — знаковый бит */
+    int ok = len <= BIGNUM_CAPACITY;
+    if (ok) {
+        mpz_set(t, src);
+        if (mpz_sgn(src) < 0) { mpz_ui_pow_ui(m, 2, 64 * len); mpz_add(t, t, m); }
+        ok = bignum_from_gmp(dst, t);
+        dst->len = len;
+    }
+    mpz_clears(m, t, NULL);
+    return ok;
+}
+
 /* === Тесты === */
 
 /**
@@ -292,6 +329,599 @@ static int test_fuzzing_for_correctness_vs_gmp(void) {
     return 1;
 }
 
+/**
+ * @brief      Фаззинг-тест каждого поддерживаемого ядра против GMP.
+ * @details    Для каждого ядра, которое принимает bignum_shift_right_set_kernel,
+ *             повторяет test_fuzzing_for_correctness_vs_gmp.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_fuzzing_all_kernels_vs_gmp(void) {
+    static const char *names[] = {"auto", "scalar", "avx2", "avx512", "avx512_vbmi2", "neon"};
+    int ok = 1;
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; k++) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) {
+            printf("Kernel %s is not supported on this CPU, skipped\n", names[k]);
+            continue;
+        }
+        printf("Kernel %s: ", names[k]);
+        ok = test_fuzzing_for_correctness_vs_gmp();
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест bignum_shift_right_to против GMP для каждого ядра.
+ * @details    dst перед каждым вызовом заполняется мусором: проверяется, что
+ *             результат и хвост до BIGNUM_CAPACITY записаны полностью,
+ *             а src не изменен.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_shift_to_fuzzing_vs_gmp(void) {
+    const int N = 1000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; k++) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) continue;
+        for (int i = 0; i < N && ok; i++) {
+            bignum_t src, src_copy, dst, exp;
+            mpz_urandomm(s, st, maxs);
+            mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+            bignum_from_gmp(&src, gv);
+            src_copy = src;
+            memset(&dst, 0xA5, sizeof(dst));
+
+            mpz_urandomm(s, st, maxs);
+            size_t sh = mpz_get_ui(s);
+            mpz_tdiv_q_2exp(gr, gv, sh);
+            bignum_from_gmp(&exp, gr);
+
+            bignum_shift_right_status_t status = bignum_shift_right_to(&dst, &src, sh);
+            bignum_shift_right_status_t exp_status =
+                (exp.len == 0 && src.len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+            int tail_ok = 1;
+            for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= dst.words[j] == 0;
+            if (!compare_bn(&dst, &exp) || !tail_ok || status != exp_status ||
+                memcmp(&src, &src_copy, sizeof(src)) != 0) {
+                fprintf(stderr, "shift_to fuzz fail: kernel %d, iter %d, shift=%zu, status=%d, tail_ok=%d\n",
+                        k, i, sh, status, tail_ok);
+                print_bn("Got", &dst); print_bn("Exp", &exp);
+                ok = 0;
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("shift_to fuzzing passed %d iterations per kernel\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест сдвига с остатком и sticky-битом против GMP.
+ * @details    rem сверяется с mpz_tdiv_r_2exp, старшие выпавшие биты — с
+ *             (x >> (k - 64)) mod 2^64 (или (x mod 2^k) << (64 - k) при k < 64),
+ *             sticky-бит — с (x mod 2^(k - 64)) != 0.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_rem_sticky_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gq, gr, gt, maxs, s;
+    mpz_inits(gv, gq, gr, gt, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t a, b, rem, exp_q, exp_r;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&a, gv);
+        b = a;
+        memset(&rem, 0xA5, sizeof(rem));
+
+        mpz_urandomm(s, st, maxs);
+        size_t sh = mpz_get_ui(s);
+        mpz_tdiv_q_2exp(gq, gv, sh);
+        mpz_tdiv_r_2exp(gr, gv, sh);
+        bignum_from_gmp(&exp_q, gq);
+        bignum_from_gmp(&exp_r, gr);
+
+        uint64_t exp_dropped;
+        if (sh >= 64) {
+            mpz_tdiv_q_2exp(gt, gv, sh - 64);
+            mpz_tdiv_r_2exp(gt, gt, 64);
+            exp_dropped = mpz_get_ui(gt);
+            mpz_tdiv_r_2exp(gt, gv, sh - 64);
+            exp_dropped |= mpz_cmp_ui(gt, 0) != 0;
+        } else {
+            mpz_tdiv_r_2exp(gt, gv, sh);
+            exp_dropped = sh ? (uint64_t)mpz_get_ui(gt) << (64 - sh) : 0;
+        }
+        bignum_shift_right_status_t exp_status =
+            (exp_q.len == 0 && a.len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+
+        uint64_t dropped = 0;
+        bignum_shift_right_status_t st_rem = bignum_shift_right_rem(&a, sh, &rem);
+        bignum_shift_right_status_t st_sticky = bignum_shift_right_sticky(&b, sh, &dropped);
+        int tail_ok = 1;
+        for (size_t j = exp_r.len; j < BIGNUM_CAPACITY; j++) tail_ok &= rem.words[j] == 0;
+        if (!compare_bn(&a, &exp_q) || !compare_bn(&rem, &exp_r) || !tail_ok || st_rem != exp_status ||
+            !compare_bn(&b, &exp_q) || dropped != exp_dropped || st_sticky != exp_status) {
+            fprintf(stderr, "rem/sticky fuzz fail: iter %d, shift=%zu, dropped=%016" PRIx64 " exp=%016" PRIx64 ", tail_ok=%d\n",
+                    i, sh, dropped, exp_dropped, tail_ok);
+            print_bn("Rem", &rem); print_bn("Exp", &exp_r);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gq, gr, gt, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("rem/sticky fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест bignum_shift_right_view против GMP для каждого ядра.
+ * @details    Числа до 8 * BIGNUM_CAPACITY слов (при емкости 32 — больше RSA-8192)
+ *             во внешнем буфере сверяются с mpz_tdiv_q_2exp.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_view_fuzzing_vs_gmp(void) {
+    enum { VIEW_CAP = 8 * BIGNUM_CAPACITY };
+    const int N = 300;
+    static uint64_t buf[VIEW_CAP];
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, VIEW_CAP*64 + 128);
+    int ok = 1;
+
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; k++) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) continue;
+        for (int i = 0; i < N && ok; i++) {
+            size_t len, exp_len;
+            mpz_urandomm(s, st, maxs);
+            mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (VIEW_CAP*64));
+            memset(buf, 0, sizeof(buf));
+            mpz_export(buf, &len, -1, sizeof(uint64_t), 0, 0, gv);
+
+            mpz_urandomm(s, st, maxs);
+            size_t sh = mpz_get_ui(s);
+            mpz_tdiv_q_2exp(gr, gv, sh);
+
+            bignum_view_t view = {.words = buf, .len = len, .cap = VIEW_CAP};
+            bignum_shift_right_status_t status = bignum_shift_right_view(&view, sh);
+            mpz_import(gv, view.len, -1, sizeof(uint64_t), 0, 0, buf);
+            exp_len = mpz_sgn(gr) ? (mpz_sizeinbase(gr, 2) + 63) / 64 : 0;
+            int zero_ok = 1;
+            for (size_t j = view.len; j < VIEW_CAP; j++) zero_ok &= buf[j] == 0;
+            bignum_shift_right_status_t exp_status =
+                (exp_len == 0 && len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+            if (mpz_cmp(gv, gr) != 0 || view.len != exp_len || !zero_ok || status != exp_status) {
+                fprintf(stderr, "view fuzz fail: kernel %d, iter %d, len=%zu, shift=%zu, got len=%zu exp len=%zu, status=%d\n",
+                        k, i, len, sh, view.len, exp_len, status);
+                ok = 0;
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("view fuzzing passed %d iterations per kernel\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест сдвига со знаком против GMP.
+ * @details    s < 0 сверяется с mpz_mul_2exp (ERROR_OVERFLOW и неизменное число,
+ *             если результат длиннее BIGNUM_CAPACITY * 64 бит), s > 0 — с
+ *             mpz_tdiv_q_2exp.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_signed_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t num, orig, exp;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&num, gv);
+        orig = num;
+
+        mpz_urandomm(s, st, maxs);
+        size_t mag = mpz_get_ui(s);
+        int left = i & 1;
+        bignum_shift_right_status_t exp_status;
+        if (left) {
+            mpz_mul_2exp(gr, gv, mag);
+            if (mpz_sgn(gr) != 0 && mpz_sizeinbase(gr, 2) > BIGNUM_CAPACITY*64) {
+                exp = orig;
+                exp_status = BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+            } else {
+                bignum_from_gmp(&exp, gr);
+                exp_status = BIGNUM_SHIFT_RIGHT_SUCCESS;
+            }
+        } else {
+            mpz_tdiv_q_2exp(gr, gv, mag);
+            bignum_from_gmp(&exp, gr);
+            exp_status = (exp.len == 0 && orig.len != 0 && mag != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+        }
+
+        bignum_shift_right_status_t status = bignum_shift_right_signed(&num, left ? -(ptrdiff_t)mag : (ptrdiff_t)mag);
+        int tail_ok = 1;
+        for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= num.words[j] == 0;
+        if (!compare_bn(&num, &exp) || !tail_ok || status != exp_status) {
+            fprintf(stderr, "signed fuzz fail: iter %d, s=%s%zu, status=%d, tail_ok=%d\n",
+                    i, left ? "-" : "", mag, status, tail_ok);
+            print_bn("Got", &num); print_bn("Exp", &exp);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("signed shift fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест извлечения битового окна против GMP.
+ * @details    Эталон — (x >> lo) mod 2^width. Для width <= 64 дополнительно
+ *             проверяется bignum_shift_right_extract_u64; каждое четвертое
+ *             извлечение выполняется на месте (dst == src).
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_extract_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t src, src_copy, dst, exp;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&src, gv);
+        src_copy = src;
+        memset(&dst, 0xA5, sizeof(dst));
+
+        mpz_urandomm(s, st, maxs);
+        size_t lo = mpz_get_ui(s);
+        mpz_urandomm(s, st, maxs);
+        size_t width = (i & 1) ? mpz_get_ui(s) % 65 : mpz_get_ui(s);
+        mpz_tdiv_q_2exp(gr, gv, lo);
+        mpz_tdiv_r_2exp(gr, gr, width);
+        bignum_from_gmp(&exp, gr);
+
+        int in_place = (i % 4) == 0;
+        bignum_t *out = in_place ? &src : &dst;
+        bignum_shift_right_status_t status = bignum_shift_right_extract_bits(out, &src, lo, width);
+        bignum_shift_right_status_t exp_status = exp.len == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+        int tail_ok = 1;
+        for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= out->words[j] == 0;
+        int u64_ok = width > 64 ||
+                     bignum_shift_right_extract_u64(&src_copy, lo, width) == (exp.len ? exp.words[0] : 0);
+        if (!compare_bn(out, &exp) || !tail_ok || !u64_ok || status != exp_status ||
+            (!in_place && memcmp(&src, &src_copy, sizeof(src)) != 0)) {
+            fprintf(stderr, "extract fuzz fail: iter %d, lo=%zu, width=%zu, in_place=%d, status=%d, tail_ok=%d, u64_ok=%d\n",
+                    i, lo, width, in_place, status, tail_ok, u64_ok);
+            print_bn("Got", out); print_bn("Exp", &exp);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("extract fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест режимов округления против GMP.
+ * @details    Эталон: TRUNC — mpz_tdiv_q_2exp, CEIL — mpz_cdiv_q_2exp,
+ *             HALF_UP / HALF_EVEN — сравнение 2 * (x mod 2^k) с 2^k.
+ *             У каждого третьего числа младшие биты — единицы, чтобы чаще
+ *             проверять половину и перенос при инкременте.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_round_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gq, gr, gh, maxs, s;
+    mpz_inits(gv, gq, gr, gh, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t base, exp;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        if (i % 3 == 0) {
+            for (int b = 0; b < 3; b++) mpz_setbit(gv, b);
+        }
+        bignum_from_gmp(&base, gv);
+
+        mpz_urandomm(s, st, maxs);
+        size_t sh = mpz_get_ui(s) % 200;
+        for (int mode = BIGNUM_SHIFT_RIGHT_ROUND_TRUNC; mode <= BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN && ok; mode++) {
+            if (mode == BIGNUM_SHIFT_RIGHT_ROUND_CEIL) {
+                mpz_cdiv_q_2exp(gq, gv, sh);
+            } else {
+                mpz_tdiv_q_2exp(gq, gv, sh);
+                if (mode != BIGNUM_SHIFT_RIGHT_ROUND_TRUNC && sh > 0) {
+                    mpz_tdiv_r_2exp(gr, gv, sh);
+                    mpz_mul_2exp(gr, gr, 1);
+                    mpz_ui_pow_ui(gh, 2, sh);
+                    int c = mpz_cmp(gr, gh);
+                    if (c > 0 || (c == 0 && (mode == BIGNUM_SHIFT_RIGHT_ROUND_HALF_UP || mpz_odd_p(gq))))
+                        mpz_add_ui(gq, gq, 1);
+                }
+            }
+            bignum_from_gmp(&exp, gq);
+
+            bignum_t num = base;
+            bignum_shift_right_status_t status = bignum_shift_right_round(&num, sh, (bignum_shift_right_round_t)mode);
+            bignum_shift_right_status_t exp_status =
+                (exp.len == 0 && base.len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+            int tail_ok = 1;
+            for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= num.words[j] == 0;
+            if (!compare_bn(&num, &exp) || !tail_ok || status != exp_status) {
+                fprintf(stderr, "round fuzz fail: iter %d, mode %d, shift=%zu, status=%d, tail_ok=%d\n",
+                        i, mode, sh, status, tail_ok);
+                print_bn("Got", &num); print_bn("Exp", &exp);
+                ok = 0;
+            }
+        }
+    }
+    mpz_clears(gv, gq, gr, gh, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("round fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест bignum_shift_right_ct против GMP.
+ * @details    Сдвиги до BIGNUM_CAPACITY * 64 + 128 бит и огромные сдвиги (старшие
+ *             биты size_t), которые ct-вариант не отсекает ветвлением; половина
+ *             чисел — с мусором в словах выше len (должен быть проигнорирован).
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_ct_fuzzing_vs_gmp(void) {
+    const int N = 3000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t num, exp;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, mpz_get_ui(s) % (BIGNUM_CAPACITY*64 + 1));
+        bignum_from_gmp(&num, gv);
+        size_t len = num.len;
+        if (i & 1) {
+            for (size_t j = num.len; j < BIGNUM_CAPACITY; j++) num.words[j] = 0xDEADBEEFDEADBEEFULL * (j + 1);
+        }
+
+        mpz_urandomm(s, st, maxs);
+        size_t sh = mpz_get_ui(s);
+        if (i % 16 == 15) sh |= (size_t)1 << (40 + i % 24);
+        mpz_tdiv_q_2exp(gr, gv, sh);
+        bignum_from_gmp(&exp, gr);
+
+        bignum_shift_right_status_t status = bignum_shift_right_ct(&num, sh);
+        bignum_shift_right_status_t exp_status =
+            (exp.len == 0 && len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+        int tail_ok = 1;
+        for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= num.words[j] == 0;
+        if (!compare_bn(&num, &exp) || !tail_ok || status != exp_status) {
+            fprintf(stderr, "ct fuzz fail: iter %d, len=%zu, shift=%zu, status=%d, tail_ok=%d\n",
+                    i, len, sh, status, tail_ok);
+            print_bn("Got", &num); print_bn("Exp", &exp);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("ct fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест bignum_shift_right_ctz против mpz_scan1.
+ * @details    Случайное число умножается на 2^t (t до BIGNUM_CAPACITY * 64),
+ *             чтобы младшие нули пересекали границы слов; ожидаются
+ *             ctz = mpz_scan1(x, 0) и x >> ctz, для нуля — ZEROED и 0.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_ctz_fuzzing_vs_gmp(void) {
+    const int N = 3000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, s;
+    mpz_inits(gv, gr, s, NULL);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t num, exp;
+        mpz_urandomb(s, st, 32);
+        size_t t = mpz_get_ui(s) % (BIGNUM_CAPACITY*64);
+        mpz_urandomb(gv, st, mpz_get_ui(s) % (BIGNUM_CAPACITY*64 - t + 1));
+        mpz_mul_2exp(gv, gv, t);
+        bignum_from_gmp(&num, gv);
+
+        size_t exp_ctz = mpz_sgn(gv) ? (size_t)mpz_scan1(gv, 0) : 0;
+        mpz_tdiv_q_2exp(gr, gv, exp_ctz);
+        bignum_from_gmp(&exp, gr);
+
+        size_t ctz = SIZE_MAX;
+        bignum_shift_right_status_t status = bignum_shift_right_ctz(&num, &ctz);
+        bignum_shift_right_status_t exp_status =
+            mpz_sgn(gv) ? BIGNUM_SHIFT_RIGHT_SUCCESS : BIGNUM_SHIFT_RIGHT_ZEROED;
+        if (!compare_bn(&num, &exp) || ctz != exp_ctz || status != exp_status) {
+            fprintf(stderr, "ctz fuzz fail: iter %d, ctz=%zu (exp %zu), status=%d\n",
+                    i, ctz, exp_ctz, status);
+            print_bn("Got", &num); print_bn("Exp", &exp);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("ctz fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест арифметического сдвига против mpz_fdiv_q_2exp.
+ * @details    Случайные числа обоих знаков в минимальном дополнительном коде
+ *             сдвигаются через bignum_shift_right_arith для каждого ядра и
+ *             сверяются с floor(x / 2^k), включая минимальность длины.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_arith_fuzzing_vs_gmp(void) {
+    const int N = 1000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int k = BIGNUM_SHIFT_RIGHT_KERNEL_SCALAR; k <= BIGNUM_SHIFT_RIGHT_KERNEL_NEON && ok; k++) {
+        if (bignum_shift_right_set_kernel((bignum_shift_right_kernel_t)k) != BIGNUM_SHIFT_RIGHT_SUCCESS) continue;
+        for (int i = 0; i < N && ok; i++) {
+            bignum_t num, exp;
+            mpz_urandomm(s, st, maxs);
+            mpz_urandomb(gv, st, mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+            if (i & 1) mpz_neg(gv, gv);
+            if (!bignum_from_gmp_signed(&num, gv)) continue;
+
+            mpz_urandomm(s, st, maxs);
+            size_t sh = mpz_get_ui(s);
+            mpz_fdiv_q_2exp(gr, gv, sh);
+            bignum_from_gmp_signed(&exp, gr);
+
+            bignum_shift_right_status_t status = bignum_shift_right_arith(&num, sh);
+            int sign_only = exp.len == 0 || (exp.len == 1 && exp.words[0] == ~0ULL);
+            bignum_shift_right_status_t exp_status =
+                (sign_only && mpz_sgn(gv) != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+            int tail_ok = 1;
+            for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= num.words[j] == 0;
+            if (!compare_bn(&num, &exp) || !tail_ok || status != exp_status) {
+                fprintf(stderr, "arith fuzz fail: kernel %d, iter %d, shift=%zu, status=%d, tail_ok=%d\n",
+                        k, i, sh, status, tail_ok);
+                print_bn("Got", &num); print_bn("Exp", &exp);
+                ok = 0;
+            }
+        }
+    }
+    bignum_shift_right_set_kernel(BIGNUM_SHIFT_RIGHT_KERNEL_AUTO);
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("arith fuzzing passed %d iterations per kernel\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест пакетных функций против эталонной реализации GMP.
+ * @details    Каждый раунд формирует пакет случайных чисел и сдвигов,
+ *             сдвигает его через bignum_shift_right_batch и
+ *             bignum_shift_right_batch_uniform и сверяет каждый элемент с GMP.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_batch_fuzzing_vs_gmp(void) {
+    enum { ROUNDS = 50, BATCH = 37 };
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv[BATCH], gr, maxb, maxs, s;
+    mpz_inits(gr, maxb, maxs, s, NULL);
+    for (int j = 0; j < BATCH; j++) mpz_init(gv[j]);
+    mpz_ui_pow_ui(maxb, 2, BIGNUM_CAPACITY*64);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+
+    static bignum_t nums[BATCH], uni[BATCH];
+    size_t shifts[BATCH];
+    bignum_shift_right_status_t statuses[BATCH], uni_statuses[BATCH];
+    int ok = 1;
+
+    for (int i = 0; i < ROUNDS && ok; i++) {
+        for (int j = 0; j < BATCH; j++) {
+            /* Часть чисел делаем короткими, чтобы покрыть разные len в одном пакете */
+            mpz_urandomm(s, st, maxs);
+            mpz_urandomb(gv[j], st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+            bignum_from_gmp(&nums[j], gv[j]);
+            uni[j] = nums[j];
+            mpz_urandomm(s, st, maxs);
+            shifts[j] = mpz_get_ui(s);
+        }
+        size_t uni_shift = shifts[0];
+
+        bignum_shift_right_batch(nums, shifts, BATCH, statuses);
+        bignum_shift_right_batch_uniform(uni, uni_shift, BATCH, uni_statuses);
+
+        for (int j = 0; j < BATCH && ok; j++) {
+            bignum_t exp;
+            mpz_tdiv_q_2exp(gr, gv[j], shifts[j]);
+            bignum_from_gmp(&exp, gr);
+            if (!compare_bn(&nums[j], &exp) || statuses[j] != (exp.len == 0 && mpz_sgn(gv[j]) != 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS)) {
+                fprintf(stderr, "Batch fuzz fail at round %d, elem %d, shift=%zu, status=%d\n", i, j, shifts[j], statuses[j]);
+                print_bn("Got", &nums[j]); print_bn("Exp", &exp);
+                ok = 0;
+                break;
+            }
+            mpz_tdiv_q_2exp(gr, gv[j], uni_shift);
+            bignum_from_gmp(&exp, gr);
+            if (!compare_bn(&uni[j], &exp)) {
+                fprintf(stderr, "Uniform batch fuzz fail at round %d, elem %d, shift=%zu\n", i, j, uni_shift);
+                print_bn("Got", &uni[j]); print_bn("Exp", &exp);
+                ok = 0;
+            }
+        }
+    }
+    for (int j = 0; j < BATCH; j++) mpz_clear(gv[j]);
+    mpz_clears(gr, maxb, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("Batch fuzzing passed %d rounds of %d elements\n", ROUNDS, BATCH);
+    return ok;
+}
+
 /** @brief Структура для передачи данных в поток. */
 typedef struct {
     bignum_t base;
@@ -311,6 +941,211 @@ static void* thr_func(void *vp) {
     pthread_exit((void*)0);
 }
 
+/**
+ * @brief      Фаззинг-тест big-endian экспорта против GMP.
+ * @details    Эталон — mpz_export (старший байт первым) от x >> k, выровненный
+ *             вправо в буфере out_len байт. out_len случаен вокруг числа
+ *             значащих байт, поэтому часто проверяются неполное старшее слово
+ *             и ERROR_OVERFLOW (out при нем не должен меняться).
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_export_be_fuzzing_vs_gmp(void) {
+    enum { OUT_MAX = BIGNUM_CAPACITY * 8 + 16 };
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t src, src_copy;
+        uint8_t out[OUT_MAX], exp[OUT_MAX];
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&src, gv);
+        src_copy = src;
+
+        mpz_urandomm(s, st, maxs);
+        size_t k = mpz_get_ui(s);
+        mpz_tdiv_q_2exp(gr, gv, k);
+        size_t nbytes = mpz_sgn(gr) ? (mpz_sizeinbase(gr, 2) + 7) / 8 : 0;
+        mpz_urandomm(s, st, maxs);
+        size_t out_len = nbytes + mpz_get_ui(s) % 19;
+        out_len = out_len < 9 ? 0 : out_len - 9;    // От nbytes - 9 до nbytes + 9
+        if (out_len > OUT_MAX) out_len = OUT_MAX;
+
+        bignum_shift_right_status_t exp_status;
+        memset(exp, 0xA5, sizeof(exp));
+        if (nbytes > out_len) {
+            exp_status = BIGNUM_SHIFT_RIGHT_ERROR_OVERFLOW;
+        } else {
+            size_t count = 0;
+            memset(exp, 0, out_len);
+            mpz_export(exp + out_len - nbytes, &count, 1, 1, 1, 0, gr);
+            exp_status = (nbytes == 0 && src.len != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+        }
+        memset(out, 0xA5, sizeof(out));
+        bignum_shift_right_status_t status = bignum_shift_right_export_be(&src, k, out, out_len);
+        if (status != exp_status || memcmp(out, exp, sizeof(out)) != 0 ||
+            memcmp(&src, &src_copy, sizeof(src)) != 0) {
+            fprintf(stderr, "export_be fuzz fail: iter %d, k=%zu, out_len=%zu, nbytes=%zu, status=%d\n",
+                    i, k, out_len, nbytes, status);
+            print_bn("Src", &src);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("export_be fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @brief      Фаззинг-тест сдвига на величину bignum_t против GMP.
+ * @details    Величина сдвига — число из 0, 1 или 2 слов (2 слова — сдвиг
+ *             >= 2^64, насыщение); эталон — mpz_tdiv_q_2exp на ее значение
+ *             или 0. У bignum_shift_right_by дополнительно проверяется
+ *             обнуленный хвост, у bignum_shift_right_by_nz — только слова до len.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_shift_by_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, maxs, s;
+    mpz_inits(gv, gr, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t num, num_nz, amount, exp;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, (i % 7 == 0) ? 0 : 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&num, gv);
+        num_nz = num;
+
+        mpz_urandomm(s, st, maxs);
+        size_t sh = mpz_get_ui(s);
+        if (i % 3 == 0) {
+            make_bn(&amount, (uint64_t[]){sh, (uint64_t)i + 1}, 2);  // >= 2^64
+            mpz_set_ui(gr, 0);
+        } else {
+            make_bn(&amount, (uint64_t[]){sh}, sh != 0);
+            mpz_tdiv_q_2exp(gr, gv, sh);
+        }
+        bignum_from_gmp(&exp, gr);
+        int shifted = amount.len != 0 && num.len != 0;
+        bignum_shift_right_status_t exp_status =
+            (exp.len == 0 && shifted) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+
+        bignum_shift_right_status_t status = bignum_shift_right_by(&num, &amount);
+        bignum_shift_right_status_t status_nz = bignum_shift_right_by_nz(&num_nz, &amount);
+        int tail_ok = 1;
+        for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= num.words[j] == 0;
+        if (!compare_bn(&num, &exp) || !compare_bn(&num_nz, &exp) || !tail_ok ||
+            status != exp_status || status_nz != exp_status) {
+            fprintf(stderr, "shift_by fuzz fail: iter %d, amount.len=%zu, shift=%zu, status=%d, status_nz=%d, tail_ok=%d\n",
+                    i, (size_t)amount.len, sh, status, status_nz, tail_ok);
+            print_bn("Got", &num); print_bn("Got_nz", &num_nz); print_bn("Exp", &exp);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("shift_by fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
+/**
+ * @internal
+ * @brief Заполняет слова num за len мусором (режим «грязного хвоста»).
+ */
+static void poison_tail(bignum_t *num, gmp_randstate_t st) {
+    mpz_t g;
+    mpz_init(g);
+    mpz_urandomb(g, st, 64);
+    uint64_t junk = mpz_get_ui(g) | 1;
+    for (size_t j = num->len; j < BIGNUM_CAPACITY; j++) num->words[j] = junk * (j + 1);
+    mpz_clear(g);
+}
+
+/**
+ * @brief      Фаззинг-тест режима «грязного хвоста» против GMP.
+ * @details    Слова за len у входов и dst заполняются мусором. Эталон —
+ *             mpz_tdiv_q_2exp; сверяются только words[0 .. len) (compare_bn)
+ *             у bignum_shift_right_nz, _to_nz и _by_nz. Результат _nz затем
+ *             сдвигается функциями без _nz (bignum_shift_right,
+ *             bignum_shift_right_ct), которые должны принимать грязный хвост,
+ *             а после bignum_shift_right_clear_tail хвост должен быть нулевым.
+ * @return     1 в случае успеха, 0 в случае провала.
+ */
+static int test_nz_fuzzing_vs_gmp(void) {
+    const int N = 2000;
+    gmp_randstate_t st;
+    gmp_randinit_default(st);
+    gmp_randseed_ui(st, (unsigned)time(NULL));
+
+    mpz_t gv, gr, g2, maxs, s;
+    mpz_inits(gv, gr, g2, maxs, s, NULL);
+    mpz_set_ui(maxs, BIGNUM_CAPACITY*64 + 128);
+    int ok = 1;
+
+    for (int i = 0; i < N && ok; i++) {
+        bignum_t src, num, dst, by, exp, exp2, amount;
+        mpz_urandomm(s, st, maxs);
+        mpz_urandomb(gv, st, 1 + mpz_get_ui(s) % (BIGNUM_CAPACITY*64));
+        bignum_from_gmp(&src, gv);
+        poison_tail(&src, st);
+        bignum_t src_copy = src;
+        num = src;
+        by = src;
+        memset(&dst, 0xA5, sizeof(dst));
+
+        mpz_urandomm(s, st, maxs);
+        size_t sh = mpz_get_ui(s);
+        mpz_urandomm(s, st, maxs);
+        size_t sh2 = mpz_get_ui(s) % 130;
+        mpz_tdiv_q_2exp(gr, gv, sh);
+        mpz_tdiv_q_2exp(g2, gr, sh2);
+        bignum_from_gmp(&exp, gr);
+        bignum_from_gmp(&exp2, g2);
+        make_bn(&amount, (uint64_t[]){sh}, sh != 0);
+        bignum_shift_right_status_t exp_status =
+            (exp.len == 0 && src.len != 0 && sh != 0) ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS;
+
+        int st_ok = bignum_shift_right_nz(&num, sh) == exp_status &&
+                    bignum_shift_right_to_nz(&dst, &src, sh) == exp_status &&
+                    bignum_shift_right_by_nz(&by, &amount) == exp_status;
+        int val_ok = compare_bn(&num, &exp) && compare_bn(&dst, &exp) && compare_bn(&by, &exp) &&
+                     memcmp(&src, &src_copy, sizeof(src)) == 0;
+
+        // Функции без _nz принимают грязный хвост
+        bignum_shift_right(&num, sh2);
+        bignum_shift_right_ct(&dst, sh2);
+        int interop_ok = compare_bn(&num, &exp2) && compare_bn(&dst, &exp2);
+
+        bignum_shift_right_clear_tail(&by);
+        int tail_ok = 1;
+        for (size_t j = exp.len; j < BIGNUM_CAPACITY; j++) tail_ok &= by.words[j] == 0;
+        if (!st_ok || !val_ok || !interop_ok || !tail_ok) {
+            fprintf(stderr, "nz fuzz fail: iter %d, shift=%zu, shift2=%zu, st_ok=%d, val_ok=%d, interop_ok=%d, tail_ok=%d\n",
+                    i, sh, sh2, st_ok, val_ok, interop_ok, tail_ok);
+            print_bn("Got", &num); print_bn("Exp", &exp2);
+            ok = 0;
+        }
+    }
+    mpz_clears(gv, gr, g2, maxs, s, NULL);
+    gmp_randclear(st);
+    if (ok) printf("nz fuzzing passed %d iterations\n", N);
+    return ok;
+}
+
 /**
  * @brief      Тест на потокобезопасность.
  * @details    Запускает несколько потоков, каждый из которых выполняет
@@ -351,6 +1186,20 @@ int main(void) {
     RUN_TEST(sum, test_combined);
     RUN_TEST(sum, test_overflow);
     RUN_TEST(sum, test_fuzzing_for_correctness_vs_gmp);
+    RUN_TEST(sum, test_fuzzing_all_kernels_vs_gmp);
+    RUN_TEST(sum, test_shift_to_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_rem_sticky_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_arith_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_round_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_extract_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_signed_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_view_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_ct_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_ctz_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_batch_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_export_be_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_shift_by_fuzzing_vs_gmp);
+    RUN_TEST(sum, test_nz_fuzzing_vs_gmp);
     RUN_TEST(sum, test_threads);
 
     printf("========================================\n");
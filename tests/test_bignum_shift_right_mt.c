@@ -22,6 +22,16 @@
  *   5. Главный поток ожидает завершения всех дочерних потоков и
  *      агрегирует их результаты.
  *
+ *   Вторая часть проверяет bignum_shift_right_view_parallel на числах
+ *   в сотни тысяч слов: сдвиги с копированием границ (word_shift мал),
+ *   раундами (word_shift велик) и без перекрытия, разное число потоков,
+ *   а также одновременные вызовы из нескольких потоков (пул занят —
+ *   однопоточный путь). Эталон — GMP, слова за пределами len не меняются.
+ *
+ *   Третья часть отправляет пакеты bignum_shift_right_submit из нескольких
+ *   потоков (малые — в вызывающем потоке, большие — отрезками в пуле) и
+ *   сверяет числа, статусы, однократность обратных вызовов и счетчики.
+ *
  * @note
  *   Для сборки этого теста требуется флаг `-pthread` и библиотека GMP (`-lgmp`).
  *
@@ -30,6 +40,9 @@
  *   - rev. 2 (10.08.2025): Тест усилен. Добавлена верификация через GMP,
  *                         но допущена ошибка - пропущен #include <stdlib.h>.
  *   - rev. 3 (10.08.2025): Исправлена ошибка компиляции. Добавлен #include <stdlib.h>.
+ *   - rev. 4 (14.10.2026): Проверка bignum_shift_right_view_parallel.
+ *   - rev. 5 (14.10.2026): view_parallel с потоковыми записями в каждом отрезке.
+ *   - rev. 6 (14.10.2026): Асинхронные пакеты bignum_shift_right_submit.
  */
 
 #include "bignum_shift_right.h"
@@ -45,6 +58,13 @@
 #define TEST_PASSED ((void*)1)
 #define TEST_FAILED ((void*)0)
 
+#define PAR_LEN 200003            /**< Слов в числе для параллельного сдвига. */
+#define PAR_GUARD 8               /**< Контрольных слов за len. */
+#define PAR_GUARD_WORD 0xA5A5A5A5A5A5A5A5ULL
+#define PAR_CALLERS 4             /**< Одновременных вызовов view_parallel. */
+#define ASYNC_SUBMITTERS 4        /**< Потоков, отправляющих асинхронные пакеты. */
+#define ASYNC_JOBS 6              /**< Пакетов на поток. */
+
 /**
  * @brief Структура для передачи данных в поток.
  */
@@ -102,6 +122,263 @@ void* shift_worker(void* arg) {
     return TEST_PASSED;
 }
 
+/** Заполняет len слов псевдослучайными значениями, за ними — PAR_GUARD контрольных. */
+static void fill_words(uint64_t* words, size_t len, uint64_t seed) {
+    for (size_t i = 0; i < len; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        words[i] = seed ^ (seed >> 29);
+    }
+    words[len - 1] |= 1ULL << 63;
+    for (size_t i = len; i < len + PAR_GUARD; ++i) words[i] = PAR_GUARD_WORD;
+}
+
+/**
+ * @brief   Сдвигает число из len слов через view_parallel и сверяет с GMP.
+ * @return  1 при совпадении длины, слов, кода возврата и контрольных слов.
+ */
+static int check_view_parallel(size_t len, size_t shift, unsigned nthreads, uint64_t seed) {
+    uint64_t* words = malloc((len + PAR_GUARD) * sizeof(uint64_t));
+    if (!words) return 0;
+    fill_words(words, len, seed);
+
+    mpz_t gmp_num;
+    mpz_init(gmp_num);
+    mpz_import(gmp_num, len, -1, sizeof(uint64_t), 0, 0, words);
+    mpz_tdiv_q_2exp(gmp_num, gmp_num, shift);
+    size_t expected_len = 0;
+    uint64_t* expected = mpz_export(NULL, &expected_len, -1, sizeof(uint64_t), 0, 0, gmp_num);
+    mpz_clear(gmp_num);
+
+    bignum_view_t view = {words, len, len + PAR_GUARD};
+    bignum_shift_right_status_t status = bignum_shift_right_view_parallel(&view, shift, nthreads);
+
+    int ok = status == (expected_len == 0 ? BIGNUM_SHIFT_RIGHT_ZEROED : BIGNUM_SHIFT_RIGHT_SUCCESS)
+          && view.len == expected_len
+          && (expected_len == 0 || memcmp(words, expected, expected_len * sizeof(uint64_t)) == 0);
+    for (size_t i = expected_len; ok && i < len; ++i) ok = words[i] == 0;
+    for (size_t i = len; ok && i < len + PAR_GUARD; ++i) ok = words[i] == PAR_GUARD_WORD;
+
+    free(expected);
+    free(words);
+    return ok;
+}
+
+/** Параметры одного вызова view_parallel из отдельного потока. */
+typedef struct {
+    size_t shift;
+    unsigned nthreads;
+    uint64_t seed;
+} parallel_data_t;
+
+/** Вызывает view_parallel одновременно с другими потоками. */
+void* parallel_caller(void* arg) {
+    const parallel_data_t* data = (const parallel_data_t*)arg;
+    return check_view_parallel(PAR_LEN, data->shift, data->nthreads, data->seed) ? TEST_PASSED : TEST_FAILED;
+}
+
+/** @return Количество провалившихся проверок bignum_shift_right_view_parallel. */
+static int test_view_parallel(void) {
+    static const struct { size_t shift; unsigned nthreads; const char* name; } cases[] = {
+        {1, 2, "bit shift, 2 threads"},
+        {1, 8, "bit shift, 8 threads"},
+        {64 + 7, 3, "1 word + 7 bits, 3 threads"},
+        {64 * 100 + 63, 8, "100 words + 63 bits, 8 threads"},
+        {64 * 5000, 4, "5000 words, word move only"},
+        {64 * 32768 + 9, 8, "largest staged word_shift"},
+        {64 * 40000 + 13, 8, "rounds of 40000 words"},
+        {64 * 40000, 5, "rounds, word move only"},
+        {64 * 150000 + 5, 8, "word_shift >= new_len"},
+        {64 * (PAR_LEN - 1) + 3, 8, "single word left"},
+        {64 * PAR_LEN, 8, "all words shifted out"},
+        {12345, 0, "nthreads = 0 (all CPUs)"},
+        {12345, 1, "nthreads = 1 (serial)"},
+        {12345, 1000, "nthreads above the maximum"},
+    };
+    int failed = 0, ok;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        ok = check_view_parallel(PAR_LEN, cases[i].shift, cases[i].nthreads, i + 1);
+        printf("view_parallel %-32s: %s\n", cases[i].name, ok ? "PASSED" : "FAILED");
+        failed += !ok;
+    }
+    /* Потоковое ядро в каждом отрезке (порог ниже длины отрезка). */
+    bignum_shift_right_set_stream_threshold(1);
+    ok = check_view_parallel(PAR_LEN, 64 + 7, 8, 77) && check_view_parallel(PAR_LEN, 64 * 40000 + 13, 8, 78);
+    bignum_shift_right_set_stream_threshold(BIGNUM_SHIFT_RIGHT_STREAM_OFF);
+    printf("view_parallel %-32s: %s\n", "streaming stores", ok ? "PASSED" : "FAILED");
+    failed += !ok;
+
+    /* Короче порога: однопоточный путь. */
+    ok = check_view_parallel(BIGNUM_SHIFT_RIGHT_PARALLEL_MIN_WORDS - 1, 77, 8, 99);
+    printf("view_parallel %-32s: %s\n", "below the parallel threshold", ok ? "PASSED" : "FAILED");
+    failed += !ok;
+
+    pthread_t threads[PAR_CALLERS];
+    parallel_data_t data[PAR_CALLERS];
+    for (int i = 0; i < PAR_CALLERS; ++i) {
+        data[i].shift = 64 * (size_t)i + 5 * (size_t)i + 1;
+        data[i].nthreads = 4;
+        data[i].seed = 1000 + (uint64_t)i;
+        if (pthread_create(&threads[i], NULL, parallel_caller, &data[i]) != 0) {
+            perror("pthread_create");
+            return failed + 1;
+        }
+    }
+    for (int i = 0; i < PAR_CALLERS; ++i) {
+        void* result;
+        if (pthread_join(threads[i], &result) != 0 || result != TEST_PASSED) {
+            printf("view_parallel concurrent caller %d: FAILED\n", i);
+            failed++;
+        }
+    }
+    printf("view_parallel %-32s: %s\n", "concurrent callers", failed ? "-" : "PASSED");
+    return failed;
+}
+
+/** Пакет одного потока-отправителя и результат его проверки. */
+typedef struct {
+    unsigned                    id;
+    bignum_t*                   nums[ASYNC_JOBS];
+    bignum_t*                   expected[ASYNC_JOBS];
+    size_t*                     shifts[ASYNC_JOBS];
+    bignum_shift_right_status_t* statuses[ASYNC_JOBS];
+    bignum_shift_right_status_t* expected_statuses[ASYNC_JOBS];
+    size_t                      counts[ASYNC_JOBS];
+    int                         completions[ASYNC_JOBS];  /**< Обратных вызовов пакета. */
+} async_data_t;
+
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Пакет j потока: малый, ровно на пороге, несколько отрезков; сдвиги — общий и свои. */
+static size_t async_job_count(unsigned j) {
+    static const size_t counts[ASYNC_JOBS] = {
+        1, BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX, BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX + 1,
+        BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK * 5 + 17, BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK * 3, 100
+    };
+    return counts[j];
+}
+
+static void async_complete(const bignum_shift_right_batch_t* batch, void* user) {
+    int* completions = user;
+    (void)batch;
+    pthread_mutex_lock(&async_lock);
+    ++*completions;
+    pthread_mutex_unlock(&async_lock);
+}
+
+static void* async_submitter(void* arg) {
+    async_data_t* d = arg;
+    for (unsigned j = 0; j < ASYNC_JOBS; ++j) {
+        bignum_shift_right_batch_t batch = {d->nums[j], (j & 1) ? d->shifts[j] : NULL, 64 * 2 + 11,
+                                            d->counts[j], d->statuses[j]};
+        if (bignum_shift_right_submit(&batch, async_complete, &d->completions[j]) != BIGNUM_SHIFT_RIGHT_SUCCESS) {
+            return TEST_FAILED;
+        }
+    }
+    return TEST_PASSED;
+}
+
+/** @return Количество провалившихся проверок bignum_shift_right_submit. */
+static int test_async_submit(void) {
+    async_data_t data[ASYNC_SUBMITTERS];
+    pthread_t threads[ASYNC_SUBMITTERS];
+    uint64_t chunks = 0, async_jobs = 0;
+    int failed = 0;
+
+    bignum_shift_right_async_stats_reset();
+    for (unsigned t = 0; t < ASYNC_SUBMITTERS; ++t) {
+        data[t].id = t;
+        for (unsigned j = 0; j < ASYNC_JOBS; ++j) {
+            const size_t n = async_job_count(j);
+            data[t].counts[j] = n;
+            data[t].completions[j] = 0;
+            data[t].nums[j] = malloc(n * sizeof(bignum_t));
+            data[t].expected[j] = malloc(n * sizeof(bignum_t));
+            data[t].shifts[j] = malloc(n * sizeof(size_t));
+            data[t].statuses[j] = malloc(n * sizeof(bignum_shift_right_status_t));
+            data[t].expected_statuses[j] = malloc(n * sizeof(bignum_shift_right_status_t));
+            if (!data[t].nums[j] || !data[t].expected[j] || !data[t].shifts[j] ||
+                !data[t].statuses[j] || !data[t].expected_statuses[j]) {
+                perror("malloc");
+                return 1;
+            }
+            for (size_t e = 0; e < n; ++e) {
+                bignum_t* num = &data[t].nums[j][e];
+                memset(num, 0, sizeof(*num));
+                num->len = 1 + (e * 7 + t) % BIGNUM_CAPACITY;
+                for (size_t i = 0; i < num->len; ++i) num->words[i] = 0x9E3779B97F4A7C15ULL * (e + i + t + 1) | 1;
+                data[t].shifts[j][e] = (e * 37 + j) % (BIGNUM_CAPACITY * 64 + 64);
+                data[t].expected[j][e] = *num;
+                data[t].expected_statuses[j][e] = bignum_shift_right(&data[t].expected[j][e],
+                                                                     (j & 1) ? data[t].shifts[j][e] : 64 * 2 + 11);
+            }
+            if (n > BIGNUM_SHIFT_RIGHT_ASYNC_INLINE_MAX) {
+                async_jobs++;
+                chunks += (n + BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK - 1) / BIGNUM_SHIFT_RIGHT_ASYNC_CHUNK;
+            }
+        }
+    }
+    for (unsigned t = 0; t < ASYNC_SUBMITTERS; ++t) {
+        if (pthread_create(&threads[t], NULL, async_submitter, &data[t]) != 0) {
+            perror("pthread_create");
+            return failed + 1;
+        }
+    }
+    for (unsigned t = 0; t < ASYNC_SUBMITTERS; ++t) {
+        void* result;
+        if (pthread_join(threads[t], &result) != 0 || result != TEST_PASSED) failed++;
+    }
+    bignum_shift_right_async_wait();
+
+    for (unsigned t = 0; t < ASYNC_SUBMITTERS; ++t) {
+        for (unsigned j = 0; j < ASYNC_JOBS; ++j) {
+            const size_t n = data[t].counts[j];
+            int ok = data[t].completions[j] == 1;
+            for (size_t e = 0; e < n && ok; ++e) {
+                const bignum_t* got = &data[t].nums[j][e];
+                const bignum_t* exp = &data[t].expected[j][e];
+                ok = got->len == exp->len && memcmp(got->words, exp->words, sizeof(got->words)) == 0 &&
+                     data[t].statuses[j][e] == data[t].expected_statuses[j][e];
+            }
+            if (!ok) {
+                printf("async submitter %u, job %u (%zu numbers): FAILED (%d callbacks)\n",
+                       t, j, n, data[t].completions[j]);
+                failed++;
+            }
+            free(data[t].nums[j]);
+            free(data[t].expected[j]);
+            free(data[t].shifts[j]);
+            free(data[t].statuses[j]);
+            free(data[t].expected_statuses[j]);
+        }
+    }
+
+    bignum_shift_right_async_stats_t st;
+    if (bignum_shift_right_async_stats_get(&st) != BIGNUM_SHIFT_RIGHT_SUCCESS ||
+        st.submitted != ASYNC_SUBMITTERS * ASYNC_JOBS || st.completed_async != async_jobs ||
+        st.completed_inline != st.submitted - async_jobs || st.chunks + st.chunks_caller != chunks ||
+        st.chunks_stolen > st.chunks || st.workers == 0 || st.latency_ns_max > st.latency_ns_total) {
+        printf("async stats: FAILED (submitted %llu, inline %llu, async %llu, chunks %llu + %llu of %llu)\n",
+               (unsigned long long)st.submitted, (unsigned long long)st.completed_inline,
+               (unsigned long long)st.completed_async, (unsigned long long)st.chunks,
+               (unsigned long long)st.chunks_caller, (unsigned long long)chunks);
+        failed++;
+    } else {
+        printf("async: %u workers, %llu chunks (%llu stolen), max latency %.3f ms\n", st.workers,
+               (unsigned long long)st.chunks, (unsigned long long)st.chunks_stolen, st.latency_ns_max * 1e-6);
+    }
+
+    bignum_shift_right_batch_t null_nums = {NULL, NULL, 1, 5, NULL};
+    if (bignum_shift_right_submit(NULL, NULL, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG ||
+        bignum_shift_right_submit(&null_nums, NULL, NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG ||
+        bignum_shift_right_async_stats_get(NULL) != BIGNUM_SHIFT_RIGHT_ERROR_NULL_ARG) {
+        printf("async NULL arguments: FAILED\n");
+        failed++;
+    }
+    printf("async %-40s: %s\n", "submit from concurrent threads", failed ? "FAILED" : "PASSED");
+    return failed;
+}
+
 int main() {
     pthread_t threads[NUM_THREADS];
     thread_data_t data[NUM_THREADS] = {0};
@@ -153,7 +430,17 @@ int main() {
 
     printf("\n----------------------------------------\n");
     printf("Multithreading test summary: %d/%d threads passed.\n", tests_passed, NUM_THREADS);
+    printf("----------------------------------------\n\n");
+
+    int parallel_failed = test_view_parallel();
+    printf("\n----------------------------------------\n");
+    printf("view_parallel summary: %d failed.\n", parallel_failed);
+    printf("----------------------------------------\n");
+
+    int async_failed = test_async_submit();
+    printf("\n----------------------------------------\n");
+    printf("async summary: %d failed.\n", async_failed);
     printf("----------------------------------------\n");
 
-    return (tests_passed == NUM_THREADS) ? 0 : 1;
+    return (tests_passed == NUM_THREADS && parallel_failed == 0 && async_failed == 0) ? 0 : 1;
 }
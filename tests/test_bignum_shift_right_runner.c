@@ -11,6 +11,30 @@
  *
  * @history
  *   - rev. 1 (03.12.2025): Создание теста
+ *   - rev. 2 (14.10.2026): Добавлены вызовы пакетного API
+ *   - rev. 3 (14.10.2026): Добавлены вызовы выбора ядра
+ *   - rev. 4 (14.10.2026): Добавлен вызов bignum_shift_right_to
+ *   - rev. 5 (14.10.2026): Проверка емкости, с которой собрана библиотека
+ *   - rev. 6 (14.10.2026): Добавлены вызовы bignum_shift_right_rem и bignum_shift_right_sticky
+ *   - rev. 7 (14.10.2026): Добавлен вызов bignum_shift_right_arith
+ *   - rev. 8 (14.10.2026): Добавлен вызов bignum_shift_right_round
+ *   - rev. 9 (14.10.2026): Добавлены вызовы bignum_shift_right_extract_bits и _extract_u64
+ *   - rev. 10 (14.10.2026): Добавлен вызов bignum_shift_right_signed
+ *   - rev. 11 (14.10.2026): Добавлен вызов bignum_shift_right_view
+ *   - rev. 12 (14.10.2026): Добавлен вызов bignum_shift_right_view_parallel
+ *   - rev. 13 (14.10.2026): Добавлен вызов bignum_shift_right_set_stream_threshold
+ *   - rev. 14 (14.10.2026): Добавлен вызов bignum_shift_right_ct
+ *   - rev. 15 (14.10.2026): Добавлены вызовы bignum_lazy_*
+ *   - rev. 16 (14.10.2026): Добавлен вызов bignum_shift_right_ctz
+ *   - rev. 17 (14.10.2026): Добавлены вызовы bignum_shift_right_soa*
+ *   - rev. 18 (14.10.2026): Добавлен вызов bignum_shift_right_unchecked
+ *   - rev. 19 (14.10.2026): Добавлены вызовы bignum_shift_right_stats_get/reset
+ *   - rev. 20 (14.10.2026): Добавлены вызовы входов по классу сдвига и диспетчера
+ *   - rev. 21 (14.10.2026): Добавлены вызовы bignum_pool_* и bignum_shift_right_batch_ptr
+ *   - rev. 22 (14.10.2026): Добавлены вызовы асинхронных пакетов
+ *   - rev. 23 (14.10.2026): Добавлен вызов bignum_shift_right_export_be
+ *   - rev. 24 (14.10.2026): Добавлены вызовы bignum_shift_right_by и _by_nz
+ *   - rev. 25 (14.10.2026): Добавлены вызовы входов _nz и bignum_shift_right_clear_tail
  */  
 #include "bignum_shift_right.h"
 #include <assert.h>
@@ -19,7 +43,65 @@ int main() {
  printf("Running test: test_bignum_shift_right_runner... "); 
  bignum_t num = {0}; 	
  bignum_shift_right(&num, 5);  
- assert(1);
+ bignum_shift_right_unchecked(&num, 5);
+ bignum_shift_right_bits_only(&num, 5);
+ bignum_shift_right_words_only(&num, 64);
+ bignum_shift_right_dispatch(&num, 5);
+ bignum_shift_right_arith(&num, 5);
+ bignum_shift_right_signed(&num, -5);
+ bignum_shift_right_ct(&num, 5);
+ bignum_view_t view = {num.words, num.len, BIGNUM_CAPACITY};
+ bignum_shift_right_view(&view, 5);
+ bignum_shift_right_view_parallel(&view, 5, 2);
+ bignum_shift_right_set_stream_threshold(BIGNUM_SHIFT_RIGHT_STREAM_OFF);
+ size_t shift = 5;
+ bignum_shift_right_batch(&num, &shift, 1, NULL);
+ bignum_shift_right_batch_uniform(&num, 5, 1, NULL);
+ bignum_pool_t* pool = bignum_pool_create(1);
+ bignum_t* pooled = bignum_pool_alloc(pool);
+ bignum_shift_right_batch_ptr(&pooled, 5, 1, NULL);
+ bignum_pool_free(pool, pooled);
+ bignum_pool_destroy(pool);
+ bignum_shift_right_batch_t batch = {&num, NULL, 5, 1, NULL};
+ bignum_shift_right_submit(&batch, NULL, NULL);
+ bignum_shift_right_async_wait();
+ bignum_shift_right_async_stats_t async_stats;
+ bignum_shift_right_async_stats_get(&async_stats);
+ bignum_shift_right_async_stats_reset();
+ uint64_t soa_words[BIGNUM_CAPACITY];
+ bignum_soa_t soa = {soa_words, 0, 0};
+ bignum_shift_right_soa_pack(&soa, &num, 1);
+ bignum_shift_right_soa(&soa, 5);
+ bignum_shift_right_soa_unpack(&num, &soa);
+ bignum_shift_right_set_kernel(bignum_shift_right_get_kernel());
+ bignum_t dst;
+ bignum_shift_right_to(&dst, &num, 5);
+ bignum_shift_right_extract_bits(&dst, &num, 3, 70);
+ (void)bignum_shift_right_extract_u64(&num, 3, 7);
+ uint8_t bytes[16];
+ bignum_shift_right_export_be(&num, 3, bytes, sizeof(bytes));
+ bignum_t amount = {{5}, 1};
+ bignum_shift_right_by(&num, &amount);
+ bignum_shift_right_by_nz(&num, &amount);
+ bignum_shift_right_nz(&num, 5);
+ bignum_shift_right_to_nz(&dst, &num, 5);
+ bignum_shift_right_clear_tail(&num);
+ bignum_lazy_t lazy = {num, 0};
+ bignum_lazy_shift_right(&lazy, 5);
+ (void)bignum_lazy_get_word(&lazy, 0);
+ bignum_lazy_materialize(&lazy);
+ uint64_t dropped;
+ bignum_shift_right_rem(&num, 5, &dst);
+ bignum_shift_right_sticky(&num, 5, &dropped);
+ size_t ctz;
+ bignum_shift_right_ctz(&num, &ctz);
+ bignum_shift_right_round(&num, 5, BIGNUM_SHIFT_RIGHT_ROUND_HALF_EVEN);
+ bignum_shift_right_stats_t stats;
+ bignum_shift_right_stats_get(&stats);
+ bignum_shift_right_stats_reset();
+ char profile[128];
+ bignum_shift_right_stats_profile(&stats, profile, sizeof(profile));
+ assert(bignum_shift_right_capacity_matches());
  printf("PASSED\n");   
  return 0;  
 }
\ No newline at end of file